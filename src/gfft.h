@@ -32,6 +32,7 @@
 #include "gfftpolicy.h"
 #include "gfftcaller.h"
 #include "gfftgen.h"
+#include "gfftmdct.h"
 
 #if FULLOUTPUT == 1 
 #define FOUT
@@ -23,10 +23,13 @@
 #include "gfftspec_inp.h"
 #include "gfftfactor.h"
 #include "gfftswap.h"
+#include "gfftsimd.h"
 
 #include "metacomplex.h"
 #include "metaroot.h"
 
+#include <algorithm>
+
 namespace GFFT {
 
 using namespace MF;
@@ -35,124 +38,23 @@ static const long_t StaticLoopLimit = (1<<10);
 static const long_t PrecomputeRoots = StaticLoopLimit;
 
 
-///////////////////////////////////////////////////
-// This class works, but takes too much compile-time
-template<class DFTk, long_t M, long_t N, typename VType, int S, class W1, class WK = W1,
-int NIter = M-2, int C = N/M>
-struct SmartIterate
-{
-   typedef typename VType::ValueType T;
-   typedef typename VType::TempType LocalVType;
-   static const long_t M2 = 2*M;
-   static const long_t Step = PrecomputeRoots/M2;
-   static const long_t I = Step*(M-NIter) - 2;
-   
-   //static const long_t N = M2;
-//    typedef typename Simplify<SRational<long_<I>,long_<N> > >::Result R;
-//    static const long_t I1 = R::Numer::value;
-//    static const long_t N1 = R::Denom::value;
-
-//    typedef typename CosPiDecimal<I,N,VType::Accuracy>::Result Re;
-//    typedef typename SinPiDecimal<I,N,VType::Accuracy>::Result Sin2;
-//    typedef typename Loki::Select<(S<0),Sin2,
-//           typename Negate<Sin2>::Result>::Result Im;
-
-//   typedef typename GetFirstRoot<M2,S,VType::Accuracy>::Result W;
-//    typedef Compute<Re,VType::Accuracy> WR;
-//    typedef Compute<Im,VType::Accuracy> WI;
-   typedef Compute<typename WK::Re,VType::Accuracy> WR;
-   typedef Compute<typename WK::Im,VType::Accuracy> WI;
-
-   typedef typename DFTk::RootsHolder SW;
-   
-   //typedef typename IPowBig<W1,2>::Result WK;
-   typedef typename Mult<W1,WK>::Result WKnext;
-   SmartIterate<DFTk,M,N,VType,S,W1,WKnext,NIter-2> next;
-   DFTk spec_inp;
-
-   void apply(T* data) 
-   {
-     T* roots = SW::Instance().getData(); 
-     if (roots[I] == uninitialized_flag) {
-       roots[I]   = WR::value();
-       roots[I+1] = WI::value();
-     }
-//      LocalVType wr = WR::value();
-//      LocalVType wi = WI::value();
-//      spec_inp.apply(data+(M-NIter),&wr,&wi);
-     spec_inp.apply(data+(M-NIter),roots+I,roots+I+1);
-
-     T wr = -roots[I];
-//      wr = -wr;
-//      spec_inp.apply(data+M2-(M-NIter),&wr,&wi);
-     spec_inp.apply(data+M2-(M-NIter),&wr,roots+I+1);
-     
-     next.apply(data);
-   }
-};
-/*
-template<class DFTk, long_t M, long_t N, typename VType, int S, class W1, class WK, int NIter>
-struct SmartIterate<DFTk, M, N, VType, S, W1, WK, NIter, 2>
-{
-   typedef typename VType::ValueType T;
-   typedef typename VType::TempType LocalVType;
-   static const long_t M2 = 2*M;
-   //static const long_t Step = N/M2/2;
-   //static const long_t I = Step*(M-NIter) - 2;
-   
-   typedef Compute<typename WK::Re,VType::Accuracy> WR;
-   typedef Compute<typename WK::Im,VType::Accuracy> WI;
-    
-   typedef typename DFTk::RootsHolder SW;
-   
-   //typedef typename IPowBig<W1,2>::Result WK;
-   typedef typename Mult<W1,WK>::Result WKnext;
-   SmartIterate<DFTk,M,2*M,VType,S,W1,WKnext,NIter-2> next;
-   DFTk spec_inp;
-
-   void apply(T* data) 
-   {
-     T wr = WR::value();
-     T wi = WI::value();
-     spec_inp.apply(data+(M-NIter),&wr,&wi);
-
-     wr = -wr;
-     spec_inp.apply(data+M2-(M-NIter),&wr,&wi);
-     
-     next.apply(data);
-   }
-};
-*/
-template<class DFTk, long_t M, long_t N, typename VType, int S, class W1, class WK, int C>
-struct SmartIterate<DFTk,M,N,VType,S,W1,WK,0,C>
-: public SmartIterate<DFTk,M,N,VType,S,W1,WK,0,2> {};
-
-template<class DFTk, long_t M, long_t N, typename VType, int S, class W1, class WK>
-struct SmartIterate<DFTk,M,N,VType,S,W1,WK,0,2>
-{
-   typedef typename VType::ValueType T;
-   DFTk spec_inp;
-
-   void apply(T* data) 
-   {
-     spec_inp.apply(data);
-     spec_inp.apply_1(data+M);
-   }
-};
-
 /// In-place scaled FFT algorithm
 /**
 \tparam K first factor
+\tparam LastK product of K and the factors of the enclosing steps
 \tparam M second factor (N=K*M) 
+\tparam Step step between the butterflies
 \tparam T value type of the data array
 \tparam S sign of the transform: 1 - forward, -1 - backward
 \tparam W compile-time root of unity
-\tparam doStaticLoop rely on template instantiation loop IterateInTime (only for short loops)
 
 The notation for this template class follows SPIRAL. 
 The class performs DFT(k) with the Kronecker product by the mxm identity matrix Im
 and twiddle factors (T).
-\sa InTime, IterateInTime
+The twiddle factors are loaded from the table RootsTable of the length LastK*M/Step,
+which is shared by all the steps of the transform. The root \f$ w^{kb} \f$
+of the butterfly b is the entry k*b*LastK/K, so the loads do not depend on each other.
+\sa InTime, RootsTable
 */
 template<long_t K, long_t LastK, long_t M, long_t Step, typename VType, int S, class W1,
 long_t SimpleSpec = (M / Step),
@@ -173,95 +75,72 @@ class DFTk_x_Im_T<K,LastK,M,Step,VType,S,W1,SimpleSpec,true>
    static const long_t N = K*M;
    static const long_t M2 = M*2;
    static const long_t S2 = 2*Step;
-   DFTk_inp<K,M2,VType,S> spec_inp;
+   static const long_t NR = LastK*M/Step;
+   static const long_t RStep = 2*(LastK/K);
+   typename PrimeDFTk_inp<K,M2,VType,S>::Result spec_inp;
+   SIMDDFTk_x_Im_T<K,M,Step,VType,S> spec_simd;
+   const T* m_roots;
    
 public:
+   DFTk_x_Im_T() 
+   : m_roots(spec_simd.isAvailable ? 0 : RootsTable<NR,T,S>::Instance().getData()) { }
+
    void apply(T* data) 
    {
-      spec_inp.apply(data);
+      if (spec_simd.isAvailable) {
+        spec_simd.apply(data);
+        return;
+      }
 
-      ComputeRoots<K,VType,W1> roots;
+      spec_inp.apply(data);
 
-      spec_inp.apply(data+S2, roots.get_real(), roots.get_imag());
-      for (long_t j=S2+S2; j<M2; j+=S2) {
-        roots.step();
-        spec_inp.apply(data+j, roots.get_real(), roots.get_imag());
+      T wr[K-1], wi[K-1];
+      long_t r = RStep;
+      for (long_t j=S2; j<M2; j+=S2, r+=RStep) {
+        for (long_t k=0; k<K-1; ++k) {
+          wr[k] = m_roots[(k+1)*r];
+          wi[k] = m_roots[(k+1)*r + 1];
+        }
+        spec_inp.apply(data+j, wr, wi);
       }
    }
   
 };
-/*
+
 // Specialization for radix 2
 template<long_t M, long_t LastK, long_t Step, typename VType, int S, class W1, long_t SimpleSpec>
 class DFTk_x_Im_T<2,LastK,M,Step,VType,S,W1,SimpleSpec,true> 
 {
    typedef typename VType::ValueType T;
-   typedef typename VType::TempType LocalVType;
-   typedef Compute<typename W1::Re,VType::Accuracy> WR;
-   typedef Compute<typename W1::Im,VType::Accuracy> WI;
    static const long_t N = 2*M;
    static const long_t S2 = 2*Step;
+   static const long_t NR = LastK*M/Step;
+   static const long_t RStep = LastK;
    DFTk_inp<2,N,VType,S> spec_inp;
+   SIMDDFTk_x_Im_T<2,M,Step,VType,S> spec_simd;
+   const T* m_roots;
 public:
+   DFTk_x_Im_T() 
+   : m_roots(spec_simd.isAvailable ? 0 : RootsTable<NR,T,S>::Instance().getData()) { }
+
    void apply(T* data) 
    {
-      spec_inp.apply(data);
-
-      LocalVType wr,wi,t;
-      const LocalVType wpr = WR::value();
-      const LocalVType wpi = WI::value();
-      wr = wpr;
-      wi = wpi;
-
-      spec_inp.apply(data+S2, &wr, &wi);
-      for (long_t i=S2+S2; i<N; i+=S2) {
-        t = wr;
-        wr = wr*wpr - wi*wpi;
-        wi = wi*wpr + t*wpi;
-        spec_inp.apply(data+i, &wr, &wi);
+      if (spec_simd.isAvailable) {
+        spec_simd.apply(data);
+        return;
       }
-   }
-};
-*/
 
-// Specialization for radix 2
-template<long_t M, long_t LastK, long_t Step, typename VType, int S, class W1, long_t SimpleSpec>
-class DFTk_x_Im_T<2,LastK,M,Step,VType,S,W1,SimpleSpec,true> 
-{
-   typedef typename VType::ValueType T;
-   static const long_t N = 2*M;
-   static const long_t S2 = 2*Step;
-   //static const long_t NR = (4*PrecomputeRoots > LastK*M) ? LastK*M/4 : PrecomputeRoots;
-   static const long_t NR = (PrecomputeRoots>=N) ? 2 : PrecomputeRoots/2;
-   static const long_t K = N/PrecomputeRoots;
-   static const long_t K2 = 2*K;
-   //typedef typename GetFirstRoot<N,S,VType::Accuracy>::Result W1;
-   typedef Compute<typename W1::Re,VType::Accuracy> WR;
-   typedef Compute<typename W1::Im,VType::Accuracy> WI;
-   DFTk_inp<2,N,VType,S> spec_inp;
-public:
-   void apply(T* data) 
-   {
       spec_inp.apply(data);
       if (M%2 == 0) 
         spec_inp.apply_1(data+M);
       
-      T wr,wi,t;
-      const T wpr = WR::value();
-      const T wpi = WI::value();
-      wr = wpr;
-      wi = wpi;
-
-      spec_inp.apply(data+S2, &wr, &wi);
-      t = -wr;
-      spec_inp.apply(data+N-S2, &t, &wi);
-      for (long_t i=S2+S2; i<M; i+=S2) {
-          t = wr;
-          wr = wr*wpr - wi*wpi;
-          wi = wi*wpr + t*wpi;
-          spec_inp.apply(data+i, &wr, &wi);
-          t = -wr;
-          spec_inp.apply(data+N-i, &t, &wi);
+      // w^(M-b) = -conj(w^b)
+      T t;
+      long_t r = RStep;
+      for (long_t i=S2; i<M; i+=S2, r+=RStep) {
+          spec_inp.apply(data+i, m_roots+r, m_roots+r+1);
+          t = -m_roots[r];
+          spec_inp.apply(data+N-i, &t, m_roots+r+1);
       }
    }  
 };
@@ -366,6 +245,85 @@ public:
    }
 };
 
+/// DFTk_x_Im_T for the codelets of the length K = 4, 8, 16
+/*!
+\tparam K radix
+\tparam M second factor (N=K*M)
+\tparam Step step between the butterflies
+\tparam VType type of data element
+\tparam S sign of the transform: 1 - forward, -1 - backward
+
+The K-1 twiddle factors of every butterfly are taken from the shared StepRootsTable,
+since the recurrence over many roots would be slow and inaccurate.
+The butterflies are computed by SIMDComplexOps<T>::Width at once, if Step is one
+and the vector instructions are available (see SIMDTraits).
+\sa ShortDFTPow2, GroupRadix
+*/
+template<long_t K, long_t M, long_t Step, typename VType, int S,
+bool isStd = Loki::TypeTraits<typename VType::ValueType>::isStdFundamental>
+class DFTkPow2_x_Im_T;
+
+template<long_t K, long_t M, long_t Step, typename VType, int S>
+class DFTkPow2_x_Im_T<K,M,Step,VType,S,true>
+{
+   typedef typename VType::base_type T;
+   typedef ScalarComplexOps<T> Ops;
+   typedef typename Loki::Select<(SIMDTraits<T>::Width > 1 && Step == 1),
+                                 SIMDComplexOps<T>, Ops>::Result VOps;
+   static const long_t NB = M/Step;
+   static const long_t NV = (VOps::Width > 1) ? NB - NB%VOps::Width : 0;
+
+   ShortDFTPow2<S,Ops> m_dft;
+   ShortDFTPow2<S,VOps> m_vdft;
+   const T* m_w;
+
+   // butterflies from b0 to b1 by Ops::Width at once
+   template<class COps>
+   void apply(T* data, const ShortDFTPow2<S,COps>& dft, const long_t b0, const long_t b1)
+   {
+      typedef typename COps::V V;
+      for (long_t b = b0; b < b1; b += COps::Width) {
+        T* p = data + 2*b*Step;
+        V x[K], y[K];
+        x[0] = COps::load(p);
+        for (long_t k = 1; k < K; ++k)
+          x[k] = COps::cmul(COps::load(p + 2*k*M), COps::load(&m_w[2*((k-1)*NB + b)]));
+        dft.template apply<K,1,1>(x, y);
+        for (long_t k = 0; k < K; ++k)
+          COps::store(p + 2*k*M, y[k]);
+      }
+   }
+
+public:
+   DFTkPow2_x_Im_T() : m_w(StepRootsTable<K,NB,T,S>::Instance().getData()) { }
+
+   void apply(T* data)
+   {
+      apply(data, m_vdft, 0, NV);
+      apply(data, m_dft, NV, NB);
+   }
+
+   /// Butterflies from b0 to b1 only, so that a step may be split into chunks
+   void apply(T* data, const long_t b0, const long_t b1)
+   {
+      const long_t bv = (b0 < NV) ? b0 + (std::min(b1, NV) - b0)/VOps::Width*VOps::Width : b0;
+      apply(data, m_vdft, b0, bv);
+      apply(data, m_dft, bv, b1);
+   }
+};
+
+template<long_t LastK, long_t M, long_t Step, typename VType, int S, class W1, long_t SimpleSpec>
+class DFTk_x_Im_T<4,LastK,M,Step,VType,S,W1,SimpleSpec,true>
+: public DFTkPow2_x_Im_T<4,M,Step,VType,S> {};
+
+template<long_t LastK, long_t M, long_t Step, typename VType, int S, class W1, long_t SimpleSpec>
+class DFTk_x_Im_T<8,LastK,M,Step,VType,S,W1,SimpleSpec,true>
+: public DFTkPow2_x_Im_T<8,M,Step,VType,S> {};
+
+template<long_t LastK, long_t M, long_t Step, typename VType, int S, class W1, long_t SimpleSpec>
+class DFTk_x_Im_T<16,LastK,M,Step,VType,S,W1,SimpleSpec,true>
+: public DFTkPow2_x_Im_T<16,M,Step,VType,S> {};
+
 /// In-place decimation-in-time FFT version
 /**
 \tparam N current transform length
@@ -433,7 +391,7 @@ class InTime<N,Loki::Typelist<pair_<ulong_<N>, ulong_<1> >, Loki::NullType>,VTyp
 {
   typedef typename VType::ValueType T;
   static const int C = Loki::TypeTraits<T>::isStdFundamental ? 2 : 1;
-  DFTk_inp<N, C, VType, S> spec_inp;
+  typename PrimeDFTk_inp<N, C, VType, S>::Result spec_inp;
 public:
   void apply(T* data) 
   { 
@@ -501,73 +459,7 @@ class InTimeOOP<N,Loki::Typelist<pair_<ulong_<N>, ulong_<1> >, Loki::NullType>,V
 {
    typedef typename VType::ValueType T;
    static const int C = Loki::TypeTraits<T>::isStdFundamental ? 2 : 1;
-   DFTk<N, LastK*C, C, VType, S> spec;
-public:
-   void apply(const T* src, T* dst) { spec.apply(src, dst); }
-};
-
-
-/// Out-of-place DCT-2
-/**
-\tparam N current transform length
-\tparam NFact factorization list
-\tparam T value type of the data array
-\tparam S sign of the transform: 1 - forward, -1 - backward
-\tparam W1 compile-time root of unity
-
-This is the core of decimation in-time FFT algorithm:
-Strided DFT runs K times recursively, where the next 
-factor K is taken from the compile-time list.
-The scaled DFT is performed afterwards.
-\sa DFTk_x_Im_T
-*/
-template<long_t N, typename NFact, typename VType, int S, long_t LastK = 1>
-class DCT2_impl;
-
-template<long_t N, typename Head, typename Tail, typename VType, int S, long_t LastK>
-class DCT2_impl<N, Loki::Typelist<Head,Tail>, VType, S, LastK>
-{
-   typedef typename VType::ValueType T;
-   typedef typename VType::TempType LocalVType;
-   static const long_t K = Head::first::value;
-   static const long_t M = N/K;
-   
-   static const int C = Loki::TypeTraits<T>::isStdFundamental ? 2 : 1;
-   static const long_t M2 = M*C;
-   static const long_t N2 = N*C;
-   static const long_t LastK2 = LastK*C;
-   
-   //typedef typename IPowBig<W1,K>::Result WK;
-   typedef Loki::Typelist<pair_<typename Head::first, long_<Head::second::value-1> >, Tail> NFactNext;
-   DCT2_impl<M,NFactNext,VType,S,K*LastK> dft_str;
-//   DFTk_x_Im_T<K,M,1,VType,S,W1> dft_scaled;
-//   DCTk_x_Im_T<K,M,1,VType,S,W1> dft_scaled;
-public:
-
-   void apply(const T* src, T* dst) 
-   {
-     // run strided DCT recursively K times
-      long_t lk = 0;
-      for (long_t m = 0; m < N2; m+=M2, lk+=LastK2)
-        dft_str.apply(src + lk, dst + m);
-
-      //dft_scaled.apply(dst);
-   }
-};
-
-// Take the next factor from the list
-template<long_t N, long_t K, typename Tail, typename VType, int S, long_t LastK>
-class DCT2_impl<N, Loki::Typelist<pair_<long_<K>, long_<0> >,Tail>, VType, S, LastK>
-: public DCT2_impl<N, Tail, VType, S, LastK> {};
-
-
-// Specialization for a prime N
-template<long_t N, typename VType, int S, long_t LastK>
-class DCT2_impl<N,Loki::Typelist<pair_<long_<N>, long_<1> >, Loki::NullType>,VType,S,LastK>
-{
-   typedef typename VType::ValueType T;
-   static const int C = Loki::TypeTraits<T>::isStdFundamental ? 2 : 1;
-   DCT2k<N, LastK*C, C, VType, S> spec;
+   typename PrimeDFTk<N, LastK*C, C, VType, S>::Result spec;
 public:
    void apply(const T* src, T* dst) { spec.apply(src, dst); }
 };
@@ -16,391 +16,162 @@
 #define __gfftalgfreq_h
 
 /** \file
-    \brief Recursive decimation in-frequency FFT algorithms (obsolete)
+    \brief Recursive decimation in-frequency FFT algorithms
 */
 
-#include "gfftspec.h"
-#include "gfftfactor.h"
-#include "gfftswap.h"
+#include <vector>
+#include <algorithm>
+#include <complex>
+#include <cmath>
 
-#include "metacomplex.h"
-#include "metaroot.h"
+#include "gfftalg.h"
 
 namespace GFFT {
 
-using namespace MF;
+/// Butterflies of the decimation-in-frequency step followed by the twiddle factors
+/*!
+\tparam K radix
+\tparam M second factor (N=K*M)
+\tparam VType type of data element
+\tparam S sign of the transform: 1 - forward, -1 - backward
 
-/*
-template<long_t K, long_t M, typename VType, int S, class W1, int NIter = 1, class W = W1>
-class IterateInFreq
+M in-place DFTs of the length K with the step M are computed first,
+then the output k of the butterfly m is multiplied by \f$ w^{km} \f$, \f$ w = e^{-2\pi iS/N} \f$.
+The K-1 twiddle factors of every butterfly are taken from the shared StepRootsTable.
+The member apply() can be restricted to the butterflies from m0 to m1,
+so that the threads share the step (see InFreq_omp).
+\sa InFreq, DFTk_x_Im_T
+*/
+template<long_t K, long_t M, typename VType, int S>
+class T_DFTk_x_Im
 {
    typedef typename VType::ValueType T;
-   typedef typename VType::TempType LocalVType;
-   typedef Compute<typename W::Re,VType::Accuracy> WR;
-   typedef Compute<typename W::Im,VType::Accuracy> WI;
-
+   typedef typename VType::base_type BT;
+   typedef ScalarComplexOps<BT> Ops;
    static const int C = Loki::TypeTraits<T>::isStdFundamental ? 2 : 1;
-   static const long_t M2 = M*C;
-   static const long_t N = K*M;
-
-   typedef typename GetNextRoot<NIter+1,N,W1,W,VType::Accuracy>::Result Wnext;
-   IterateInFreq<K,M,VType,S,W1,NIter+1,Wnext> next;
-   DFTk_inp<K,M2,VType,S,W> spec_inp;
-   
-public:
-   void apply(T* data) 
-   {
-      const LocalVType wr = WR::value();
-      const LocalVType wi = WI::value();
-
-      spec_inp.apply(&wr, &wi, data + (NIter-1)*2);
 
-      next.apply(data);
-   }
-};
-
-// Last step of the loop
-template<long_t K, long_t M, typename VType, int S, class W1, class W>
-class IterateInFreq<K,M,VType,S,W1,M,W> 
-{
-   typedef typename VType::ValueType T;
-   typedef typename VType::TempType LocalVType;
-   typedef Compute<typename W::Re,VType::Accuracy> WR;
-   typedef Compute<typename W::Im,VType::Accuracy> WI;
+   typename PrimeDFTk_inp<K,M*C,VType,S>::Result spec_inp;
+   const BT* m_w;
 
-   static const int C = Loki::TypeTraits<T>::isStdFundamental ? 2 : 1;
-   static const long_t M2 = M*C;
-   static const long_t N = K*M;
-   DFTk_inp<K,M2,VType,S,W> spec_inp;
 public:
-   void apply(T* data) 
-   {
-//       const LocalVType t = Sin<N,M-1,LocalVType>::value();
-//       const LocalVType wr = 1 - 2.0*t*t;
-//       const LocalVType wi = -S*Sin<N,2*(M-1),LocalVType>::value();
-      const LocalVType wr = WR::value();
-      const LocalVType wi = WI::value();
+   T_DFTk_x_Im() : m_w(StepRootsTable<K,M,BT,S>::Instance().getData()) { }
 
-      spec_inp.apply(&wr, &wi, data + (M-1)*2);
-   }
-};
-
-// First step in the loop
-template<long_t K, long_t M, typename VType, int S, class W1, class W>
-class IterateInFreq<K,M,VType,S,W1,1,W> 
-{
-   typedef typename VType::ValueType T;
-   static const int C = Loki::TypeTraits<T>::isStdFundamental ? 2 : 1;
-   static const long_t M2 = M*C;
-   DFTk_inp<K,M2,VType,S,W> spec_inp;
-   IterateInFreq<K,M,VType,S,W1,2,W> next;
-public:
-   void apply(T* data) 
+   void apply(T* data, const long_t m0 = 0, const long_t m1 = M)
    {
-      spec_inp.apply(data);
-      next.apply(data);
+      BT* p = reinterpret_cast<BT*>(data);
+      for (long_t m = m0; m < m1; ++m) {
+        spec_inp.apply(data + m*C);
+        for (long_t k = 1; k < K; ++k) {
+          BT* q = p + 2*(k*M + m);
+          Ops::store(q, Ops::cmul(Ops::load(q), Ops::load(&m_w[2*((k-1)*M + m)])));
+        }
+      }
    }
 };
-*/
 
-template<long_t K, long_t M, typename VType, int S, class W, bool doStaticLoop>
-class T_DFTk_x_Im;
-/*
-template<long_t K, long_t M, typename VType, int S, class W>
-class T_DFTk_x_Im<K,M,VType,S,W,true>
-{
-   typedef typename VType::ValueType T;
-   IterateInFreq<K,M,VType,S,W> iterate;
-public:
-   void apply(T* data) 
-   {
-      iterate.apply(data);
-   }
-};
+/// T_DFTk_x_Im for the codelets of the length K = 2, 4, 8, 16
+/*!
+\tparam K radix
+\tparam M second factor (N=K*M)
+\tparam VType type of data element
+\tparam S sign of the transform: 1 - forward, -1 - backward
+
+The butterflies are computed by SIMDComplexOps<T>::Width at once,
+if the vector instructions are available (see SIMDTraits).
+\sa ShortDFTPow2, DFTkPow2_x_Im_T
 */
-template<long_t K, long_t M, typename VType, int S, class W>
-class T_DFTk_x_Im<K,M,VType,S,W,false>
+template<long_t K, long_t M, typename VType, int S>
+class T_DFTkPow2_x_Im
 {
-   typedef typename VType::ValueType T;
-   typedef typename VType::TempType LocalVType;
-   static const long_t N = K*M;
-   static const long_t M2 = M*2;
-   DFTk_inp<K,M2,VType,S> spec_inp;
-public:
-   void apply(T* data) 
+   typedef typename VType::base_type T;
+   typedef ScalarComplexOps<T> Ops;
+   typedef typename Loki::Select<(SIMDTraits<T>::Width > 1),
+                                 SIMDComplexOps<T>, Ops>::Result VOps;
+
+   ShortDFTPow2<S,Ops> m_dft;
+   ShortDFTPow2<S,VOps> m_vdft;
+   const T* m_w;
+
+   // butterflies from m0 to m1 by Ops::Width at once
+   template<class COps>
+   void apply(T* data, const ShortDFTPow2<S,COps>& dft, const long_t m0, const long_t m1)
    {
-      spec_inp.apply(data);
-
-      LocalVType wr[K-1], wi[K-1], wpr[K-1], wpi[K-1], t;
-      t = Sin<N,1,LocalVType>::value();
-
-      // W = (wpr[0], wpi[0])
-      wpr[0] = 1 - 2.0*t*t;
-      wpi[0] = -S*Sin<N,2,LocalVType>::value();
-      
-      // W^i = (wpr2, wpi2)
-      for (long_t i=0; i<K-2; ++i) {
-	wpr[i+1] = wpr[i]*wpr[0] - wpi[i]*wpi[0];
-	wpi[i+1] = wpr[i]*wpi[0] + wpr[0]*wpi[i];
-      }
-      
-      for (long_t i=0; i<K-1; ++i) {
-	wr[i] = wpr[i];
-	wi[i] = wpi[i];
-      }
-
-      for (long_t i=2; i<M2; i+=2) {
-	spec_inp.apply(wr, wi, data+i);
-
-    for (long_t i=0; i<K-1; ++i) {
-	  t = wr[i];
-	  wr[i] = t*wpr[i] - wi[i]*wpi[i];
-	  wi[i] = wi[i]*wpr[i] + t*wpi[i];
-	}
+      typedef typename COps::V V;
+      for (long_t m = m0; m < m1; m += COps::Width) {
+        T* p = data + 2*m;
+        V x[K], y[K];
+        for (long_t k = 0; k < K; ++k)
+          x[k] = COps::load(p + 2*k*M);
+        dft.template apply<K,1,1>(x, y);
+        COps::store(p, y[0]);
+        for (long_t k = 1; k < K; ++k)
+          COps::store(p + 2*k*M, COps::cmul(y[k], COps::load(&m_w[2*((k-1)*M + m)])));
       }
    }
-};
 
-template<long_t M, typename VType, int S, class W>
-class T_DFTk_x_Im<3,M,VType,S,W,false> 
-{
-   typedef typename VType::ValueType T;
-   typedef typename VType::TempType LocalVType;
-   static const long_t N = 3*M;
-   static const long_t M2 = M*2;
-   DFTk_inp<3,M2,VType,S> spec_inp;
 public:
-   void apply(T* data) 
-   {
-      spec_inp.apply(data);
+   T_DFTkPow2_x_Im() : m_w(StepRootsTable<K,M,T,S>::Instance().getData()) { }
 
-      LocalVType wr[2],wi[2],t;
-      t = Sin<N,1,LocalVType>::value();
-
-      // W = (wpr1, wpi1)
-      const LocalVType wpr1 = 1 - 2.0*t*t;
-      const LocalVType wpi1 = -S*Sin<N,2,LocalVType>::value();
-      
-      // W^2 = (wpr2, wpi2)
-      const LocalVType wpr2 = wpr1*wpr1 - wpi1*wpi1;
-      const LocalVType wpi2 = 2*wpr1*wpi1;
-      
-      wr[0] = wpr1;
-      wi[0] = wpi1;
-      wr[1] = wpr2;
-      wi[1] = wpi2;
-      for (long_t i=2; i<M2; i+=2) {
-	spec_inp.apply(wr, wi, data+i);
-
-        t = wr[0];
-        wr[0] = t*wpr1 - wi[0]*wpi1;
-        wi[0] = wi[0]*wpr1 + t*wpi1;
-        t = wr[1];
-        wr[1] = t*wpr2 - wi[1]*wpi2;
-        wi[1] = wi[1]*wpr2 + t*wpi2;
-      }
+   void apply(T* data, const long_t m0 = 0, const long_t m1 = M)
+   {
+      const long_t mv = m0 + ((VOps::Width > 1) ? (m1-m0) - (m1-m0)%VOps::Width : 0);
+      apply(data, m_vdft, m0, mv);
+      apply(data, m_dft, mv, m1);
    }
-};
 
-template<long_t M, typename VType, int S, class W>
-class T_DFTk_x_Im<2,M,VType,S,W,false>
-{
-   typedef typename VType::ValueType T;
-   typedef typename VType::TempType LocalVType;
-   static const long_t N = 2*M;
-   DFTk_inp<2,N,VType,S> spec_inp;
-
-//    IterateInFreq<2,M,VType,S,W> iterate;
-public:
-   void apply(T* data) 
+   void apply(std::complex<T>* data, const long_t m0 = 0, const long_t m1 = M)
    {
-//       iterate.apply(data);
-      spec_inp.apply(data);
-
-      LocalVType t,wr,wi;
-      t = Sin<N,1,LocalVType>::value();
-      const LocalVType wpr = -2.0*t*t;
-      const LocalVType wpi = -S*Sin<N,2,LocalVType>::value();
-      wr = 1+wpr;
-      wi = wpi;
-      for (long_t i=2; i<N; i+=2) {
-	spec_inp.apply(&wr, &wi, data+i);
-
-        t = wr;
-        wr += t*wpr - wi*wpi;
-        wi += wi*wpr + t*wpi;
-      }
+      apply(reinterpret_cast<T*>(data), m0, m1);
    }
 };
 
+template<long_t M, typename VType, int S>
+class T_DFTk_x_Im<2,M,VType,S> : public T_DFTkPow2_x_Im<2,M,VType,S> {};
 
-/*
-template<long_t K, long_t M, typename T, int S, class W, bool doStaticLoop>
-class T_DFTk_x_Im_OOP;
+template<long_t M, typename VType, int S>
+class T_DFTk_x_Im<4,M,VType,S> : public T_DFTkPow2_x_Im<4,M,VType,S> {};
 
-template<long_t K, long_t M, typename T, int S, class W>
-class T_DFTk_x_Im_OOP<K,M,T,S,W,true>
-{
-   IterateInFreqOOP<K,M,T,S,W> iterate;
-public:
-   void apply(const T* src, T* dst) 
-   {
-      iterate.apply(src,dst);
-   }
-};
-
-template<long_t K, long_t M, typename T, int S, class W>
-class T_DFTk_x_Im_OOP<K,M,T,S,W,false>
-{
-   typedef typename TempTypeTrait<T>::Result LocalVType;
-   static const long_t N = K*M;
-   static const long_t M2 = M*2;
-   DFTk<K,M2,M2,T,S> spec;
-public:
-   void apply(const T* src, T* dst) 
-   {
-      spec.apply(src, dst);
-
-      LocalVType wr[K-1], wi[K-1], wpr[K-1], wpi[K-1], t;
-      t = Sin<N,1,LocalVType>::value();
-
-      // W = (wpr[0], wpi[0])
-      wpr[0] = 1 - 2.0*t*t;
-      wpi[0] = -S*Sin<N,2,LocalVType>::value();
-      
-      // W^i = (wpr2, wpi2)
-      for (long_t i=0; i<K-2; ++i) {
-	wpr[i+1] = wpr[i]*wpr[0] - wpi[i]*wpi[0];
-	wpi[i+1] = wpr[i]*wpi[0] + wpr[0]*wpi[i];
-      }
-      
-      for (long_t i=0; i<K-1; ++i) {
-	wr[i] = wpr[i];
-	wi[i] = wpi[i];
-      }
-      for (long_t i=2; i<M2; i+=2) {
-	spec.apply(wr, wi, src+i, dst+i);
-
-    for (long_t i=0; i<K-1; ++i) {
-	  t = wr[i];
-	  wr[i] = t*wpr[i] - wi[i]*wpi[i];
-	  wi[i] = wi[i]*wpr[i] + t*wpi[i];
-	}
-      }
-   }
-};
+template<long_t M, typename VType, int S>
+class T_DFTk_x_Im<8,M,VType,S> : public T_DFTkPow2_x_Im<8,M,VType,S> {};
 
-template<long_t M, typename T, int S, class W>
-class T_DFTk_x_Im_OOP<3,M,T,S,W,false> {
-   typedef typename TempTypeTrait<T>::Result LocalVType;
-   static const long_t N = 3*M;
-   static const long_t M2 = M*2;
-   DFTk<3,M2,M2,T,S> spec;
-public:
-   void apply(const T* src, T* dst) 
-   {
-      spec.apply(src, dst);
-
-      LocalVType wr[2],wi[2],t;
-      t = Sin<N,1,LocalVType>::value();
-
-      // W = (wpr1, wpi1)
-      const LocalVType wpr1 = 1 - 2.0*t*t;
-      const LocalVType wpi1 = -S*Sin<N,2,LocalVType>::value();
-      
-      // W^2 = (wpr2, wpi2)
-      const LocalVType wpr2 = wpr1*wpr1 - wpi1*wpi1;
-      const LocalVType wpi2 = 2*wpr1*wpi1;
-      
-      wr[0] = wpr1;
-      wi[0] = wpi1;
-      wr[1] = wpr2;
-      wi[1] = wpi2;
-      for (long_t i=2; i<M2; i+=2) {
-	spec.apply(wr, wi, src+i, dst+i);
-
-        t = wr[0];
-        wr[0] = t*wpr1 - wi[0]*wpi1;
-        wi[0] = wi[0]*wpr1 + t*wpi1;
-        t = wr[1];
-        wr[1] = t*wpr2 - wi[1]*wpi2;
-        wi[1] = wi[1]*wpr2 + t*wpi2;
-      }
-   }
-};
+template<long_t M, typename VType, int S>
+class T_DFTk_x_Im<16,M,VType,S> : public T_DFTkPow2_x_Im<16,M,VType,S> {};
 
-template<long_t M, typename T, int S, class W>
-class T_DFTk_x_Im_OOP<2,M,T,S,W,false>
-{
-   typedef typename TempTypeTrait<T>::Result LocalVType;
-   static const long_t N = 2*M;
-   DFTk<2,N,N,T,S> spec;
 
-//    IterateInFreq<2,M,T,S,W> iterate;
-public:
-   void apply(const T* src, T* dst) 
-   { 
-      spec.apply(src, dst);
-     
-      LocalVType t,wr,wi;
-      t = Sin<N,1,LocalVType>::value();
-      const LocalVType wpr = -2.0*t*t;
-      const LocalVType wpi = -S*Sin<N,2,LocalVType>::value();
-      wr = 1+wpr;
-      wi = wpi;
-      for (long_t i=2; i<N; i+=2) {
-	spec.apply(&wr, &wi, src+i, dst+i);
-
-        t = wr;
-        wr += t*wpr - wi*wpi;
-        wi += wi*wpr + t*wpi;
-      }
-   }
-};
-*/
-/// Danielson-Lanczos section of the decimation-in-frequency FFT version
+/// In-place decimation-in-frequency FFT version
 /**
 \tparam N current transform length
-\tparam T value type of the data array
+\tparam NFact factorization list
+\tparam VType type of data element
 \tparam S sign of the transform: 1 - forward, -1 - backward
 
-This template class implements resursive metaprogram, which
-runs funciton apply() twice recursively at the end of the function apply()
-with the half of the transform length N
-until the simplest case N=2 has been reached. Then function \a _spec2 is called.
-Therefore, it has two specializations for N=2 and N=1 (the trivial and empty case).
-\sa InTime
+The scaled DFT runs first, then the K contiguous blocks of the length M=N/K
+are transformed recursively, where the next factor K is taken from the compile-time list.
+The result is in digit-reversed order with respect to the factors of NFact:
+for a single prime power it is put in natural order by GFFTswap2 afterwards,
+for the mixed radix by DigitReversal (see InFreqOOP).
+\sa InTime, T_DFTk_x_Im
 */
-template<long_t N, typename NFact, typename VType, int S, class W, long_t LastK = 1>
+template<long_t N, typename NFact, typename VType, int S>
 class InFreq;
 
-// template<long_t N, typename Head, typename Tail, typename T, int S, class W1, long_t LastK>
-// class InFreq<N, Loki::Typelist<Head,Tail>, T, S, W1, LastK>
-// {
-//   // Not implemented, because not allowed
-//   // Transforms in-place are allowed for powers of primes only!!!
-// };
-  
-template<long_t N, typename Head, typename VType, int S, class W, long_t LastK>
-class InFreq<N, Loki::Typelist<Head,Loki::NullType>, VType, S, W, LastK>
+template<long_t N, typename Head, typename Tail, typename VType, int S>
+class InFreq<N, Loki::Typelist<Head,Tail>, VType, S>
 {
    typedef typename VType::ValueType T;
-   typedef typename VType::TempType LocalVType;
    static const long_t K = Head::first::value;
    static const long_t M = N/K;
 
    static const int C = Loki::TypeTraits<T>::isStdFundamental ? 2 : 1;
    static const long_t M2 = M*C;
    static const long_t N2 = N*C;
-   
-//   typedef typename IPowBig<W1,K>::Result WK;
-   typedef Loki::Typelist<pair_<typename Head::first, long_<Head::second::value-1> >, Loki::NullType> NFactNext;
-   InFreq<M,NFactNext,VType,S,W,K*LastK> dft_str;
-//    T_DFTk_x_Im<K,M,VType,S,W,(N<=StaticLoopLimit)> dft_scaled;
-   T_DFTk_x_Im<K,M,VType,S,W,false> dft_scaled;
+
+   typedef Loki::Typelist<pair_<typename Head::first, ulong_<Head::second::value-1> >, Tail> NFactNext;
+   InFreq<M,NFactNext,VType,S> dft_str;
+   T_DFTk_x_Im<K,M,VType,S> dft_scaled;
 
 public:
-   void apply(T* data) 
+   void apply(T* data)
    {
       dft_scaled.apply(data);
 
@@ -410,78 +181,154 @@ public:
    }
 };
 
-
 // Take the next factor from the list
-template<long_t N, long_t K, typename Tail, typename VType, int S, class W, long_t LastK>
-class InFreq<N, Loki::Typelist<pair_<long_<K>, long_<0> >,Tail>, VType, S, W, LastK>
-: public InFreq<N, Tail, VType, S, W, LastK> {};
-
+template<long_t N, ulong_t K, typename Tail, typename VType, int S>
+class InFreq<N, Loki::Typelist<pair_<ulong_<K>, ulong_<0> >,Tail>, VType, S>
+: public InFreq<N, Tail, VType, S> {};
 
 // Specialization for prime N
-template<long_t N, typename VType, int S, class W, long_t LastK>
-class InFreq<N, Loki::Typelist<pair_<long_<N>, long_<1> >, Loki::NullType>,VType,S,W,LastK>
+template<long_t N, typename VType, int S>
+class InFreq<N, Loki::Typelist<pair_<ulong_<N>, ulong_<1> >, Loki::NullType>, VType, S>
 {
-  typedef typename VType::ValueType T;
-  static const int C = Loki::TypeTraits<T>::isStdFundamental ? 2 : 1;
-  DFTk_inp<N, C, VType, S> spec_inp;
+   typedef typename VType::ValueType T;
+   static const int C = Loki::TypeTraits<T>::isStdFundamental ? 2 : 1;
+   typename PrimeDFTk_inp<N,C,VType,S>::Result spec_inp;
 public:
-  void apply(T* data) 
-  { 
-    spec_inp.apply(data);
-  }
+   void apply(T* data)
+   {
+      spec_inp.apply(data);
+   }
 };
 
 
-/*
-template<long_t N, typename NFact, typename T, int S, class W1, long_t LastK = 1>
-class InFreqOOP;
+/// Expands the factorization list into the sequence of the factors
+template<typename NFact>
+struct FactorSequence;
 
-template<long_t N, typename Head, typename Tail, typename T, int S, class W1, long_t LastK>
-class InFreqOOP<N, Loki::Typelist<Head,Tail>, T, S, W1, LastK>
+template<ulong_t K, ulong_t P, typename Tail>
+struct FactorSequence<Loki::Typelist<pair_<ulong_<K>, ulong_<P> >, Tail> >
 {
-   typedef typename TempTypeTrait<T>::Result LocalVType;
-   static const long_t K = Head::first::value;
-   static const long_t M = N/K;
-   static const long_t M2 = M*2;
-   static const long_t N2 = N*2;
-   static const long_t LastK2 = LastK*2;
-   
-//    typedef typename Loki::TL::Next<RList,K-1>::Result RListK;
-   typedef typename IPowBig<W1,K>::Result WK;
-   typedef Loki::Typelist<pair_<typename Head::first, long_<Head::second::value-1> >, Tail> NFactNext;
-   InFreqOOP<M,NFactNext,T,S,WK,K*LastK> dft_str;
-   T_DFTk_x_Im_OOP<K,M,T,S,W1,(N<=StaticLoopLimit)> dft_scaled;
+   static void apply(std::vector<long_t>& f)
+   {
+      for (ulong_t i = 0; i < P; ++i)
+        f.push_back(K);
+      FactorSequence<Tail>::apply(f);
+   }
+};
+
+template<>
+struct FactorSequence<Loki::NullType>
+{
+   static void apply(std::vector<long_t>&) { }
+};
+
+
+/// Digit reversal after the decimation-in-frequency FFT
+/*!
+\tparam N transform length
+\tparam NFact factorization list \f$ N = f_0 f_1 \ldots f_{L-1} \f$
+\tparam VType type of data element
+
+The sample at the position \f$ i = r_0 M_0 + r_1 M_1 + \ldots + r_{L-1} \f$,
+\f$ M_j = f_{j+1} \cdots f_{L-1} \f$, of the InFreq output is moved to
+\f$ r_0 + r_1 f_0 + \ldots + r_{L-1} f_0 \cdots f_{L-2} \f$.
+Unlike GFFTswap2, the factors may differ.
+The permutation is decomposed into cycles once for all the instances and applied in place.
+*/
+template<long_t N, typename NFact, typename VType>
+class DigitReversal
+{
+   typedef typename VType::ValueType T;
+   static const int C = Loki::TypeTraits<T>::isStdFundamental ? 2 : 1;
+
+   struct Cycles {
+      std::vector<long_t> idx;     // indices of the cycles of the length > 1
+      std::vector<long_t> start;   // beginning of every cycle in idx and the end
+
+      Cycles()
+      {
+         std::vector<long_t> f;
+         FactorSequence<NFact>::apply(f);
+
+         std::vector<long_t> perm(N);
+         for (long_t i = 0; i < N; ++i) {
+           long_t rest = i, dst = 0;
+           for (long_t j = f.size()-1; j >= 0; --j) {
+             dst = dst*f[j] + rest%f[j];
+             rest /= f[j];
+           }
+           perm[i] = dst;
+         }
+
+         std::vector<bool> visited(N, false);
+         for (long_t i = 0; i < N; ++i) {
+           if (visited[i] || perm[i] == i) continue;
+           start.push_back(idx.size());
+           for (long_t j = i; !visited[j]; j = perm[j]) {
+             visited[j] = true;
+             idx.push_back(j);
+           }
+         }
+         start.push_back(idx.size());
+      }
+   };
+
+   const std::vector<long_t>& m_cycles;
+   const std::vector<long_t>& m_start;
 
 public:
-   void apply(const T* src, T* dst, T* buf) 
-   { 
-      dft_scaled.apply(src, buf);
+   DigitReversal()
+   : m_cycles(SharedTable<Cycles>::Instance().idx),
+     m_start(SharedTable<Cycles>::Instance().start) { }
 
-      long_t lk = 0;
-      for (long_t m = 0; m < N2; m+=M2, lk+=LastK2)
-	dft_str.apply(buf + m, dst + lk, buf + m);
+   void apply(T* data)
+   {
+      T t[C];
+      for (size_t c = 0; c+1 < m_start.size(); ++c) {
+        const long_t* idx = &m_cycles[m_start[c]];
+        const long_t len = m_start[c+1] - m_start[c];
+        // the sample idx[j] moves to idx[j+1] and the last one to idx[0]
+        for (int i = 0; i < C; ++i)
+          t[i] = data[idx[len-1]*C + i];
+        for (long_t j = len-1; j > 0; --j)
+          for (int i = 0; i < C; ++i)
+            data[idx[j]*C + i] = data[idx[j-1]*C + i];
+        for (int i = 0; i < C; ++i)
+          data[idx[0]*C + i] = t[i];
+      }
    }
 };
 
 
-// Take the next factor from the list
-template<long_t N, long_t K, typename Tail, typename T, int S, class W1, long_t LastK>
-class InFreqOOP<N, Loki::Typelist<pair_<long_<K>, long_<0> >,Tail>, T, S, W1, LastK>
-: public InFreqOOP<N, Tail, T, S, W1, LastK> {};
+/// Out-of-place decimation-in-frequency FFT version
+/**
+\tparam N transform length
+\tparam NFact factorization list
+\tparam VType type of data element
+\tparam S sign of the transform: 1 - forward, -1 - backward
 
+The input is copied into the output array, transformed there by InFreq
+and put in natural order by DigitReversal, so any factorization is allowed.
+\sa InFreq, InTimeOOP
+*/
+template<long_t N, typename NFact, typename VType, int S>
+class InFreqOOP
+{
+   typedef typename VType::ValueType T;
+   static const int C = Loki::TypeTraits<T>::isStdFundamental ? 2 : 1;
+
+   InFreq<N,NFact,VType,S> dft;
+   DigitReversal<N,NFact,VType> perm;
 
-// Specialization for prime N
-template<long_t N, typename T, int S, class W1, long_t LastK>
-class InFreqOOP<N, Loki::Typelist<pair_<long_<N>, long_<1> >, Loki::NullType>,T,S,W1,LastK> {
-  DFTk<N, 2, LastK*2, T, S> spec;
 public:
-  void apply(const T* src, T* dst, T*) 
-  { 
-    spec.apply(src, dst);
-  }
+   void apply(const T* src, T* dst)
+   {
+      std::copy(src, src + N*C, dst);
+      dft.apply(dst);
+      perm.apply(dst);
+   }
 };
-*/
 
-}  //namespace DFT
+}  //namespace GFFT
 
 #endif /*__gfftalgfreq_h*/
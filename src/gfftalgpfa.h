@@ -0,0 +1,408 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Vladimir Mirnyy                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ ***************************************************************************/
+
+#ifndef __gfftalgpfa_h
+#define __gfftalgpfa_h
+
+/** \file
+    \brief Prime-factor (Good-Thomas) FFT for the lengths with coprime factors
+*/
+
+#include <vector>
+#include <complex>
+
+#include "gfftalg.h"
+#include "gfftalgstockham.h"
+
+namespace GFFT {
+
+/// Modular inverse of A mod M by the extended Euclidean algorithm
+template<long_t A, long_t M>
+struct ModInverse {
+   template<long_t R0, long_t R1, long_t S0, long_t S1>
+   struct Step {
+      static const long_t value = Step<R1, R0%R1, S1, S0 - (R0/R1)*S1>::value;
+   };
+   template<long_t R0, long_t S0, long_t S1>
+   struct Step<R0,0,S0,S1> {
+      static const long_t value = S0;
+   };
+   static const long_t S = Step<M, A%M, 0, 1>::value;
+   static const long_t value = (S < 0) ? S + M : S;
+};
+
+
+/// Factor p^e of the factorization with the largest value
+template<typename NFact>
+struct MaxPrimePower;
+
+template<ulong_t P, ulong_t E, typename Tail>
+struct MaxPrimePower<Loki::Typelist<pair_<ulong_<P>, ulong_<E> >, Tail> > {
+   typedef MaxPrimePower<Tail> Next;
+   static const ulong_t G = IPow<P,E>::value;
+   static const bool isMax = (G > Next::value);
+   static const ulong_t value = isMax ? G : Next::value;
+   typedef typename Loki::Select<isMax, pair_<ulong_<P>, ulong_<E> >, typename Next::Result>::Result Result;
+};
+
+template<>
+struct MaxPrimePower<Loki::NullType> {
+   static const ulong_t value = 0;
+   typedef Loki::NullType Result;
+};
+
+
+/// Coprime factors of the prime-factor algorithm
+/*!
+\tparam NFact factorization list of N into primes
+
+Every prime power \f$ p^e \f$ of the factorization becomes one dimension.
+The largest one is moved to the end, where it is transformed contiguously
+(see PrimeFactor).
+*/
+template<typename NFact>
+struct CoprimeFactors {
+   typedef typename MaxPrimePower<NFact>::Result Last;
+   typedef typename Loki::TL::Erase<NFact,Last>::Result Front;
+   typedef typename Loki::TL::Append<Front,Last>::Result Result;
+};
+
+
+/// True, if N has at least two coprime factors
+template<typename NFact>
+struct IsCoprimeFactorization {
+   static const bool value = (Loki::TL::Length<NFact>::value > 1);
+};
+
+
+/// Algorithm of the DFT of the length p^e in the prime-factor algorithm
+/*!
+The lengths up to 16 are computed by the butterflies of StockhamButterfly (PFABfly),
+the larger primes by the kernels PrimeDFTk (PFAPrime). Other prime powers need
+the mixed-radix recursion (PFAMixed), since the quadratic kernel DFTk
+is valid for the prime lengths only.
+*/
+enum { PFABfly, PFAPrime, PFAMixed };
+
+template<ulong_t P, ulong_t E>
+struct PFAKind {
+   static const int value = (IPow<P,E>::value <= 16) ? PFABfly : (E == 1) ? PFAPrime : PFAMixed;
+};
+
+
+/// One dimension of the prime-factor algorithm
+/*!
+\tparam N transform length
+\tparam K length of the dimension
+\tparam Stride step between the samples of the dimension in complex numbers
+\tparam NFact factorization of K
+\tparam VType type of data element
+\tparam S sign of the transform: 1 - forward, -1 - backward
+\tparam Kind algorithm of the length K (see PFAKind)
+
+Computes N/K transforms of the length K along the dimension in place.
+No twiddle factors are involved.
+The butterflies are computed for SIMDTraits::Width neighbouring transforms at once,
+so the data are loaded contiguously as in StockhamStep.
+*/
+template<long_t N, long_t K, long_t Stride, typename NFact, typename VType, int S, int Kind>
+class PFADim;
+
+template<long_t N, long_t K, long_t Stride, typename NFact, typename VType, int S>
+class PFADim<N,K,Stride,NFact,VType,S,PFABfly>
+{
+   typedef typename VType::ValueType T;
+   typedef typename VType::base_type BT;
+   typedef ScalarComplexOps<BT> Ops;
+   typedef typename Loki::Select<(SIMDTraits<BT>::Width > 1), SIMDComplexOps<BT>, Ops>::Result VOps;
+   static const long_t SV = Stride - Stride%VOps::Width;
+
+   StockhamButterfly<K,BT,S> m_bfly;
+
+   template<class COps>
+   void apply(BT* data, const long_t j0, const long_t j1) const
+   {
+      typedef typename COps::V V;
+      for (long_t j = j0; j < j1; j += COps::Width) {
+        V a[K], b[K];
+        for (long_t k = 0; k < K; ++k)
+          a[k] = COps::load(data + 2*(j + k*Stride));
+        m_bfly.template apply<COps>(a, b);
+        for (long_t k = 0; k < K; ++k)
+          COps::store(data + 2*(j + k*Stride), b[k]);
+      }
+   }
+
+public:
+   void apply(T* data) const
+   {
+      BT* d = reinterpret_cast<BT*>(data);
+      for (long_t o = 0; o < 2*N; o += 2*K*Stride) {
+        apply<VOps>(d + o, 0, SV);
+        apply<Ops>(d + o, SV, Stride);
+      }
+   }
+};
+
+// The kernel is applied to the strided data directly
+template<long_t N, long_t K, long_t Stride, typename NFact, typename VType, int S>
+class PFADim<N,K,Stride,NFact,VType,S,PFAPrime>
+{
+   typedef typename VType::ValueType T;
+   static const int C = Loki::TypeTraits<T>::isStdFundamental ? 2 : 1;
+   static const long_t St = Stride*C;
+
+   typename PrimeDFTk<K,St,St,VType,S>::Result m_dft;
+public:
+   void apply(T* data)
+   {
+      for (long_t o = 0; o < N*C; o += K*St)
+        for (long_t j = o; j < o + St; j += C)
+          m_dft.apply(data + j, data + j);
+   }
+};
+
+// InTimeOOP reads the strided data and writes into a buffer, which is copied back
+template<long_t N, long_t K, long_t Stride, typename NFact, typename VType, int S>
+class PFADim<N,K,Stride,NFact,VType,S,PFAMixed>
+{
+   typedef typename VType::ValueType T;
+   static const int C = Loki::TypeTraits<T>::isStdFundamental ? 2 : 1;
+   static const long_t St = Stride*C;
+
+   typedef typename GetFirstRoot<K,S,VType::Accuracy>::Result W1;
+   InTimeOOP<K,typename GroupRadix<NFact>::Result,VType,S,W1,Stride> m_dft;
+public:
+   void apply(T* data)
+   {
+      T* buf = ThreadScratch<PFADim,T>::get(K*C);
+      for (long_t o = 0; o < N*C; o += K*St)
+        for (long_t j = o; j < o + St; j += C) {
+          m_dft.apply(data + j, buf);
+          for (long_t k = 0; k < K; ++k)
+            for (int c = 0; c < C; ++c)
+              data[j + k*St + c] = buf[k*C + c];
+        }
+   }
+};
+
+
+/// Transforms of all the dimensions except the last one
+/*!
+\tparam N transform length
+\tparam NRest product of the lengths of NFact and the last dimension
+\tparam NFact list of the prime powers of the dimensions
+\tparam VType type of data element
+\tparam S sign of the transform: 1 - forward, -1 - backward
+*/
+template<long_t N, long_t NRest, typename NFact, typename VType, int S>
+class PFADims;
+
+template<long_t N, long_t NRest, ulong_t P, ulong_t E, typename Tail, typename VType, int S>
+class PFADims<N,NRest,Loki::Typelist<pair_<ulong_<P>, ulong_<E> >, Tail>,VType,S>
+{
+   typedef typename VType::ValueType T;
+   static const long_t K = IPow<P,E>::value;
+   typedef Loki::Typelist<pair_<ulong_<P>, ulong_<E> >, Loki::NullType> KFact;
+
+   PFADim<N,K,NRest/K,KFact,VType,S,PFAKind<P,E>::value> m_dim;
+   PFADims<N,NRest/K,Tail,VType,S> m_next;
+public:
+   void apply(T* data)
+   {
+      m_dim.apply(data);
+      m_next.apply(data);
+   }
+};
+
+template<long_t N, long_t NRest, typename VType, int S>
+class PFADims<N,NRest,Loki::NullType,VType,S>
+{
+public:
+   template<typename T>
+   void apply(T*) { }
+};
+
+
+/// Contiguous out-of-place DFT of the last dimension of the prime-factor algorithm
+/*!
+\tparam P,E the length of the dimension is p^e
+\tparam VType type of data element
+\tparam S sign of the transform: 1 - forward, -1 - backward
+\tparam Kind algorithm of the length p^e (see PFAKind)
+
+The mixed-radix lengths are transformed by Stockham or InTimeOOP
+as chosen for the out-of-place transforms (see PreferStockham).
+*/
+template<ulong_t P, ulong_t E, typename VType, int S, int Kind = PFAKind<P,E>::value>
+class PFALastDim
+{
+   static const long_t K = IPow<P,E>::value;
+   typedef typename VType::ValueType T;
+   typedef typename GroupRadix<Loki::Typelist<pair_<ulong_<P>, ulong_<E> >, Loki::NullType> >::Result KFact;
+   typedef typename GetFirstRoot<K,S,VType::Accuracy>::Result W1;
+   typename Loki::Select<PreferStockham<K,KFact>::value, Stockham<K,KFact,VType,S>,
+      InTimeOOP<K,KFact,VType,S,W1> >::Result m_dft;
+public:
+   void apply(const T* src, T* dst) { m_dft.apply(src, dst); }
+};
+
+template<ulong_t P, ulong_t E, typename VType, int S>
+class PFALastDim<P,E,VType,S,PFAPrime>
+{
+   typedef typename VType::ValueType T;
+   static const int C = Loki::TypeTraits<T>::isStdFundamental ? 2 : 1;
+   typename PrimeDFTk<P,C,C,VType,S>::Result m_dft;
+public:
+   void apply(const T* src, T* dst) { m_dft.apply(src, dst); }
+};
+
+template<ulong_t P, ulong_t E, typename VType, int S>
+class PFALastDim<P,E,VType,S,PFABfly>
+{
+   static const long_t K = IPow<P,E>::value;
+   typedef typename VType::ValueType T;
+   typedef typename VType::base_type BT;
+   typedef ScalarComplexOps<BT> Ops;
+   StockhamButterfly<K,BT,S> m_bfly;
+public:
+   void apply(const T* src, T* dst)
+   {
+      const BT* s = reinterpret_cast<const BT*>(src);
+      BT* d = reinterpret_cast<BT*>(dst);
+      typename Ops::V a[K], b[K];
+      for (long_t k = 0; k < K; ++k)
+        a[k] = Ops::load(s + 2*k);
+      m_bfly.template apply<Ops>(a, b);
+      for (long_t k = 0; k < K; ++k)
+        Ops::store(d + 2*k, b[k]);
+   }
+};
+
+
+/// Prime-factor (Good-Thomas) FFT
+/*!
+\tparam N transform length
+\tparam NFact factorization list of N into primes, at least two different ones
+\tparam VType type of data element
+\tparam S sign of the transform: 1 - forward, -1 - backward
+
+The length \f$ N = N_1 N_2 \cdots N_m \f$ is split into the coprime prime powers
+(see CoprimeFactors). The index maps
+\f[ n = \sum_i n_i \frac{N}{N_i} \bmod N, \qquad
+    k = \sum_i k_i \frac{N}{N_i} \left[ \left(\frac{N}{N_i}\right)^{-1} \bmod N_i \right] \bmod N \f]
+turn the DFT into the m-dimensional DFT of the sizes \f$ N_i \f$ without
+any twiddle factors between the dimensions. The steps of the maps are computed
+at compile time from NFact.
+
+The input is gathered by the first map row by row, and every row is transformed
+along the last, largest dimension into the internal buffer (see PFALastDim).
+The other dimensions are transformed in the buffer in place (see PFADims).
+Finally, the buffer is scattered by the second map into the output.
+The input is read completely before the output is written,
+so the transform may be computed in place as well.
+The buffers are taken from ThreadScratch, so that the object may be shared by the threads.
+*/
+template<long_t N, typename NFact, typename VType, int S>
+class PrimeFactor
+{
+   typedef typename VType::ValueType T;
+   static const int C = Loki::TypeTraits<T>::isStdFundamental ? 2 : 1;
+
+   typedef typename MaxPrimePower<NFact>::Result Last;
+   typedef typename CoprimeFactors<NFact>::Front Front;
+   static const long_t L = MaxPrimePower<NFact>::value;
+   static const long_t R = N/L;
+
+   // steps of the last dimension in the input and the output
+   static const long_t InStep = R;
+   static const long_t OutStep = (R*ModInverse<R,L>::value) % N;
+
+   // fills the starting indices of the rows
+   template<typename List, long_t NRest>
+   struct RowIndex;
+
+   template<ulong_t P, ulong_t E, typename Tail, long_t NRest>
+   struct RowIndex<Loki::Typelist<pair_<ulong_<P>, ulong_<E> >, Tail>, NRest> {
+      static const long_t K = IPow<P,E>::value;
+      static const long_t M = N/K;
+      static const long_t Out = (M*ModInverse<M,K>::value) % N;
+      static void apply(long_t* in, long_t* out, const long_t n, const long_t k)
+      {
+        for (long_t i = 0; i < K; ++i)
+          RowIndex<Tail,NRest/K>::apply(in + i*(NRest/K), out + i*(NRest/K),
+                                        (n + i*M) % N, (k + i*Out) % N);
+      }
+   };
+
+   template<long_t NRest>
+   struct RowIndex<Loki::NullType, NRest> {
+      static void apply(long_t* in, long_t* out, const long_t n, const long_t k)
+      {
+        *in = n;
+        *out = k;
+      }
+   };
+
+   // the first input and output index of every row, shared by all the instances
+   struct Index {
+      std::vector<long_t> in, out;
+      Index() : in(R), out(R) { RowIndex<Front,R>::apply(&in[0], &out[0], 0, 0); }
+   };
+
+   PFALastDim<Last::first::value,Last::second::value,VType,S> m_last;
+   PFADims<N,N,Front,VType,S> m_dims;
+   const long_t* m_in;
+   const long_t* m_out;
+
+public:
+   PrimeFactor() 
+   : m_in(&SharedTable<Index>::Instance().in[0]), m_out(&SharedTable<Index>::Instance().out[0]) { }
+
+   void apply(const T* src, T* dst)
+   {
+      T* buf = ThreadScratch<PrimeFactor,T,0>::get(N*C);
+      T* row = ThreadScratch<PrimeFactor,T,1>::get(L*C);
+      for (long_t r = 0; r < R; ++r) {
+        for (long_t j = 0, n = m_in[r]; j < L; ++j) {
+          for (int c = 0; c < C; ++c)
+            row[j*C + c] = src[n*C + c];
+          n += InStep;
+          if (n >= N) n -= N;
+        }
+        m_last.apply(row, buf + r*L*C);
+      }
+
+      m_dims.apply(buf);
+
+      for (long_t r = 0; r < R; ++r) {
+        const T* b = buf + r*L*C;
+        for (long_t j = 0, k = m_out[r]; j < L; ++j) {
+          for (int c = 0; c < C; ++c)
+            dst[k*C + c] = b[j*C + c];
+          k += OutStep;
+          if (k >= N) k -= N;
+        }
+      }
+   }
+
+   void apply(T* data)
+   {
+      apply(data, data);
+   }
+};
+
+}  //namespace GFFT
+
+#endif /*__gfftalgpfa_h*/
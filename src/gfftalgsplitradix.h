@@ -0,0 +1,320 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Vladimir Mirnyy                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ ***************************************************************************/
+
+#ifndef __gfftalgsplitradix_h
+#define __gfftalgsplitradix_h
+
+/** \file
+    \brief Split-radix decimation-in-time FFT for the lengths of power of two
+*/
+
+#include <vector>
+#include <complex>
+#include <cmath>
+
+#include "gfftalg.h"
+
+namespace GFFT {
+
+/// True, if the factorization NFact is a single power of two
+template<typename NFact>
+struct IsPowerOf2 {
+   static const bool value = false;
+};
+
+template<ulong_t P>
+struct IsPowerOf2<Loki::Typelist<pair_<ulong_<2>, ulong_<P> >, Loki::NullType> > {
+   static const bool value = true;
+};
+
+
+/// The butterflies of the split-radix step
+/*!
+\tparam N transform length
+\tparam T floating-point type
+\tparam S sign of the transform: 1 - forward, -1 - backward
+\tparam Conj use the conjugate pair of the twiddle factors
+
+The data contain the DFT U of the length N/2 followed by the DFTs Z1 and Z3
+of the length N/4. They are combined as
+\f[ X_k = U_k + (a + b),\quad X_{k+N/2} = U_k - (a + b), \f]
+\f[ X_{k+N/4} = U_{k+N/4} - iS(a - b),\quad X_{k+3N/4} = U_{k+N/4} + iS(a - b), \f]
+where \f$ a = w^k Z1_k \f$, \f$ w = e^{-2\pi iS/N} \f$.
+If Conj is true, Z3 is the DFT of the samples \f$ x_{4n-1} \f$ and \f$ b = w^{-k} Z3_k \f$,
+so only the table of \f$ w^k \f$ is loaded. Otherwise, Z3 is the DFT of \f$ x_{4n+3} \f$
+and \f$ b = w^{3k} Z3_k \f$ is taken from the second table.
+The butterflies are computed by SIMDComplexOps<T>::Width at once, if possible.
+*/
+template<long_t N, typename T, int S, bool Conj>
+class SplitRadixButterfly
+{
+   static const long_t N4 = N/4;
+   typedef ScalarComplexOps<T> Ops;
+   typedef typename Loki::Select<(SIMDTraits<T>::Width > 1), SIMDComplexOps<T>, Ops>::Result VOps;
+   static const long_t NV = (VOps::Width > 1) ? N4 - N4%VOps::Width : 0;
+
+   // w^k and w^{3k}, k = 0,...,N/4-1, shared by all the instances
+   struct Roots {
+      std::vector<T> w;
+      Roots() : w(Conj ? 2*N4 : 4*N4)
+      {
+         for (long_t k = 0; k < N4; ++k) {
+           const long double a = 2*M_PIl*k/N;
+           w[2*k]     = static_cast<T>(std::cos(a));
+           w[2*k + 1] = static_cast<T>(-S*std::sin(a));
+           if (!Conj) {
+             w[2*(N4 + k)]     = static_cast<T>(std::cos(3*a));
+             w[2*(N4 + k) + 1] = static_cast<T>(-S*std::sin(3*a));
+           }
+         }
+      }
+   };
+   const T* m_w;
+
+   template<class COps>
+   static typename COps::V third(const T* z3, const T* w, const long_t k, Loki::Int2Type<true>)
+   {
+      return COps::cmulc(COps::load(z3 + 2*k), COps::load(w + 2*k));
+   }
+
+   template<class COps>
+   static typename COps::V third(const T* z3, const T* w, const long_t k, Loki::Int2Type<false>)
+   {
+      return COps::cmul(COps::load(z3 + 2*k), COps::load(w + 2*(N4 + k)));
+   }
+
+   template<class COps>
+   void apply(T* data, const long_t k0, const long_t k1)
+   {
+      typedef typename COps::V V;
+      T* u0 = data;
+      T* u1 = data + 2*N4;
+      T* z1 = data + 4*N4;
+      T* z3 = data + 6*N4;
+      const T* w = m_w;
+      for (long_t k = k0; k < k1; k += COps::Width) {
+        const V a = COps::cmul(COps::load(z1 + 2*k), COps::load(w + 2*k));
+        const V b = third<COps>(z3, w, k, Loki::Int2Type<Conj>());
+        const V s = COps::add(a, b);
+        const V d = COps::template imul<-S>(COps::sub(a, b));
+        const V x0 = COps::load(u0 + 2*k);
+        const V x1 = COps::load(u1 + 2*k);
+        COps::store(u0 + 2*k, COps::add(x0, s));
+        COps::store(z1 + 2*k, COps::sub(x0, s));
+        COps::store(u1 + 2*k, COps::add(x1, d));
+        COps::store(z3 + 2*k, COps::sub(x1, d));
+      }
+   }
+
+public:
+   SplitRadixButterfly() : m_w(&SharedTable<Roots>::Instance().w[0]) { }
+
+   void apply(T* data)
+   {
+      apply<VOps>(data, 0, NV);
+      apply<Ops>(data, NV, N4);
+   }
+};
+
+
+/// DFT of the length N = 2, 4, 8, 16 as the leaf of the split-radix recursion
+/*!
+\tparam N transform length
+\tparam T floating-point type
+\tparam S sign of the transform: 1 - forward, -1 - backward
+
+The sample j is taken from the position index(j), the result is stored in natural order.
+All the samples are loaded before the result is stored, so src and dst may coincide.
+\sa ShortDFTPow2
+*/
+template<long_t N, typename T, int S>
+class SplitRadixLeaf
+{
+   typedef ScalarComplexOps<T> Ops;
+   typedef typename Ops::V V;
+   ShortDFTPow2<S,Ops> m_dft;
+
+public:
+   template<class Index>
+   void apply(const T* src, T* dst, const Index& index) const
+   {
+      V x[N], y[N];
+      for (long_t j = 0; j < N; ++j)
+        x[j] = Ops::load(src + 2*index(j));
+      m_dft.template apply<N,1,1>(x, y);
+      for (long_t k = 0; k < N; ++k)
+        Ops::store(dst + 2*k, y[k]);
+   }
+};
+
+
+/// In-place split-radix FFT
+/*!
+\tparam N transform length, power of two
+\tparam VType type of data element
+\tparam S sign of the transform: 1 - forward, -1 - backward
+
+The input must be in bit-reversed order (see GFFTswap2). Then the first half of the data
+holds the samples \f$ x_{2n} \f$, the third and the fourth quarter the samples
+\f$ x_{4n+1} \f$ and \f$ x_{4n+3} \f$, so that the three shorter transforms
+are computed recursively in place.
+The conjugate pair of the twiddle factors is not applicable here, since the samples
+\f$ x_{4n-1} \f$ would start from the last quarter with a cyclic shift.
+The lengths up to 16 are computed by the codelets.
+\sa SplitRadixButterfly, SplitRadixOOP
+*/
+template<long_t N, typename VType, int S>
+class SplitRadix
+{
+   typedef typename VType::base_type T;
+   SplitRadix<N/2,VType,S> m_half;
+   SplitRadix<N/4,VType,S> m_quarter;
+   SplitRadixButterfly<N,T,S,false> m_bfly;
+public:
+   void apply(T* data)
+   {
+      m_half.apply(data);
+      m_quarter.apply(data + N);
+      m_quarter.apply(data + 3*N/2);
+      m_bfly.apply(data);
+   }
+
+   void apply(std::complex<T>* data)
+   {
+      apply(reinterpret_cast<T*>(data));
+   }
+};
+
+// Leaves of the in-place recursion
+template<long_t N, typename VType, int S>
+class SplitRadixLeaf_inp
+{
+   typedef typename VType::base_type T;
+
+   // bit-reversed index of j
+   struct Index {
+      long_t operator()(const long_t j) const
+      {
+        long_t r = 0;
+        for (long_t m = 1, b = N/2; m < N; m <<= 1, b >>= 1)
+          if (j & m) r |= b;
+        return r;
+      }
+   };
+
+   SplitRadixLeaf<N,T,S> m_leaf;
+public:
+   void apply(T* data)
+   {
+      m_leaf.apply(data, data, Index());
+   }
+
+   void apply(std::complex<T>* data)
+   {
+      apply(reinterpret_cast<T*>(data));
+   }
+};
+
+template<typename VType, int S>
+class SplitRadix<16,VType,S> : public SplitRadixLeaf_inp<16,VType,S> {};
+
+template<typename VType, int S>
+class SplitRadix<8,VType,S> : public SplitRadixLeaf_inp<8,VType,S> {};
+
+template<typename VType, int S>
+class SplitRadix<4,VType,S> : public SplitRadixLeaf_inp<4,VType,S> {};
+
+template<typename VType, int S>
+class SplitRadix<2,VType,S> : public SplitRadixLeaf_inp<2,VType,S> {};
+
+
+/// Out-of-place conjugate-pair split-radix FFT
+/*!
+\tparam N transform length, power of two
+\tparam VType type of data element
+\tparam S sign of the transform: 1 - forward, -1 - backward
+\tparam Stride step between the input samples of the current transform
+\tparam NTot length of the whole transform
+
+The input sample j of the current transform is
+\f$ x_{(off + j\cdot Stride) \bmod NTot} \f$, where the offset \a off is passed
+to apply(). The transform of the samples \f$ x_{4n-1} \f$ starts therefore
+from the offset off-Stride, and all the twiddle factors of the step are the
+conjugate pairs \f$ w^{\pm k} \f$ (see SplitRadixButterfly).
+The lengths up to 16 are computed by the codelets.
+\sa SplitRadix
+*/
+template<long_t N, typename VType, int S, long_t Stride = 1, long_t NTot = N>
+class SplitRadixOOP
+{
+   typedef typename VType::base_type T;
+   SplitRadixOOP<N/2,VType,S,2*Stride,NTot> m_half;
+   SplitRadixOOP<N/4,VType,S,4*Stride,NTot> m_quarter;
+   SplitRadixButterfly<N,T,S,true> m_bfly;
+public:
+   void apply(const T* src, T* dst, const long_t off = 0)
+   {
+      m_half.apply(src, dst, off);
+      m_quarter.apply(src, dst + N, off + Stride);
+      m_quarter.apply(src, dst + 3*N/2, off - Stride);
+      m_bfly.apply(dst);
+   }
+
+   void apply(const std::complex<T>* src, std::complex<T>* dst)
+   {
+      apply(reinterpret_cast<const T*>(src), reinterpret_cast<T*>(dst));
+   }
+};
+
+// Leaves of the out-of-place recursion
+template<long_t N, typename VType, int S, long_t Stride, long_t NTot>
+class SplitRadixLeafOOP
+{
+   typedef typename VType::base_type T;
+
+   // cyclic index of the sample j
+   struct Index {
+      const long_t m_off;
+      Index(const long_t off) : m_off(off) { }
+      long_t operator()(const long_t j) const { return (m_off + j*Stride) & (NTot-1); }
+   };
+
+   SplitRadixLeaf<N,T,S> m_leaf;
+public:
+   void apply(const T* src, T* dst, const long_t off = 0)
+   {
+      m_leaf.apply(src, dst, Index(off));
+   }
+
+   void apply(const std::complex<T>* src, std::complex<T>* dst)
+   {
+      apply(reinterpret_cast<const T*>(src), reinterpret_cast<T*>(dst));
+   }
+};
+
+template<typename VType, int S, long_t Stride, long_t NTot>
+class SplitRadixOOP<16,VType,S,Stride,NTot> : public SplitRadixLeafOOP<16,VType,S,Stride,NTot> {};
+
+template<typename VType, int S, long_t Stride, long_t NTot>
+class SplitRadixOOP<8,VType,S,Stride,NTot> : public SplitRadixLeafOOP<8,VType,S,Stride,NTot> {};
+
+template<typename VType, int S, long_t Stride, long_t NTot>
+class SplitRadixOOP<4,VType,S,Stride,NTot> : public SplitRadixLeafOOP<4,VType,S,Stride,NTot> {};
+
+template<typename VType, int S, long_t Stride, long_t NTot>
+class SplitRadixOOP<2,VType,S,Stride,NTot> : public SplitRadixLeafOOP<2,VType,S,Stride,NTot> {};
+
+}  //namespace GFFT
+
+#endif /*__gfftalgsplitradix_h*/
@@ -0,0 +1,330 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Vladimir Mirnyy                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ ***************************************************************************/
+
+#ifndef __gfftalgstockham_h
+#define __gfftalgstockham_h
+
+/** \file
+    \brief Stockham autosort out-of-place FFT
+*/
+
+#include <vector>
+#include <complex>
+#include <cmath>
+
+#include "gfftalg.h"
+
+namespace GFFT {
+
+/// Largest factor of the factorization NFact
+template<typename NFact>
+struct MaxFactor;
+
+template<ulong_t K, typename P, typename Tail>
+struct MaxFactor<Loki::Typelist<pair_<ulong_<K>, P>, Tail> > {
+   static const ulong_t Next = MaxFactor<Tail>::value;
+   static const ulong_t value = (K > Next) ? K : Next;
+};
+
+template<>
+struct MaxFactor<Loki::NullType> {
+   static const ulong_t value = 1;
+};
+
+/// Number of the factors of NFact counted with their powers
+template<typename NFact>
+struct FactorCount;
+
+template<typename K, ulong_t P, typename Tail>
+struct FactorCount<Loki::Typelist<pair_<K, ulong_<P> >, Tail> > {
+   static const ulong_t value = P + FactorCount<Tail>::value;
+};
+
+template<>
+struct FactorCount<Loki::NullType> {
+   static const ulong_t value = 0;
+};
+
+
+/// Length, from which on Stockham is used instead of InTimeOOP for the lengths of power of two
+static const long_t StockhamThreshold = (1<<17);
+
+/// Chooses Stockham for the serial out-of-place transforms of the default decimation INTIME
+/*!
+\tparam N transform length
+\tparam NFact factorization list of N into primes
+
+The choice follows the measurements: Stockham is faster, if N has a prime factor
+from 5 to 13, since its butterflies are vectorized, and for N >= StockhamThreshold,
+when the strided access of InTimeOOP does not fit into the cache.
+The larger prime factors are not supported by StockhamButterfly.
+*/
+template<long_t N, typename NFact>
+struct PreferStockham {
+   static const ulong_t MaxK = MaxFactor<NFact>::value;
+   static const bool value = (MaxK <= 13) && (MaxK >= 5 || N >= StockhamThreshold);
+};
+
+
+/// DFT of the length K for StockhamStep
+/*!
+\tparam K length of the DFT
+\tparam T floating-point type
+\tparam S sign of the transform: 1 - forward, -1 - backward
+
+The member apply() transforms K complex numbers by the operations COps,
+which are either ScalarComplexOps or SIMDComplexOps.
+The lengths 2, 4, 8 and 16 are computed by ShortDFTPow2,
+the odd lengths by ShortDFTOdd.
+*/
+template<long_t K, typename T, int S,
+bool isPow2 = (K == 2 || K == 4 || K == 8 || K == 16)>
+class StockhamButterfly;
+
+template<long_t K, typename T, int S>
+class StockhamButterfly<K,T,S,true>
+{
+   typedef ScalarComplexOps<T> Ops;
+   typedef typename Loki::Select<(SIMDTraits<T>::Width > 1),
+                                 SIMDComplexOps<T>, Ops>::Result VOps;
+   ShortDFTPow2<S,Ops> m_dft;
+   ShortDFTPow2<S,VOps> m_vdft;
+
+   const ShortDFTPow2<S,Ops>& get(Loki::Int2Type<false>) const { return m_dft; }
+   const ShortDFTPow2<S,VOps>& get(Loki::Int2Type<true>) const { return m_vdft; }
+
+public:
+   template<class COps>
+   void apply(const typename COps::V* a, typename COps::V* b) const
+   {
+      get(Loki::Int2Type<(COps::Width > 1)>()).template apply<K,1,1>(a, b);
+   }
+};
+
+template<long_t K, typename T, int S>
+class StockhamButterfly<K,T,S,false>
+{
+   typedef ScalarComplexOps<T> Ops;
+   typedef typename Loki::Select<(SIMDTraits<T>::Width > 1),
+                                 SIMDComplexOps<T>, Ops>::Result VOps;
+   ShortDFTOdd<K,S,Ops> m_dft;
+   ShortDFTOdd<K,S,VOps> m_vdft;
+
+   const ShortDFTOdd<K,S,Ops>& get(Loki::Int2Type<false>) const { return m_dft; }
+   const ShortDFTOdd<K,S,VOps>& get(Loki::Int2Type<true>) const { return m_vdft; }
+
+public:
+   template<class COps>
+   void apply(const typename COps::V* a, typename COps::V* b) const
+   {
+      get(Loki::Int2Type<(COps::Width > 1)>()).apply(a, b);
+   }
+};
+
+
+/// Step of the Stockham autosort FFT
+/*!
+\tparam N current transform length
+\tparam Stride number of the transforms of the length N
+\tparam NFact factorization list of N
+\tparam T floating-point type
+\tparam S sign of the transform: 1 - forward, -1 - backward
+
+The array x contains Stride interleaved sequences of the length N,
+so the sample j of the sequence q is \f$ x_{q + j\cdot Stride} \f$.
+The step computes the butterflies of the radix K over the samples
+\f$ p + jM \f$, \f$ M = N/K \f$, multiplies the output k by \f$ w^{pk} \f$,
+\f$ w = e^{-2\pi iS/N} \f$, and writes it to the sample \f$ Kp + k \f$ of y.
+So y contains K*Stride sequences of the length M, which are transformed
+by the next step from y to z. The result is in natural order without any permutation.
+
+If Stride is not less than SIMDTraits<T>::Width, the Width sequences are processed
+at once, so the reading and writing is contiguous. The twiddle factors are stored
+Width times then to be loaded as vectors. In the first step (Stride is one),
+Width butterflies are computed at once instead, and their outputs are written
+through a small buffer.
+*/
+template<long_t N, long_t Stride, typename NFact, typename T, int S>
+class StockhamStep;
+
+template<long_t N, long_t Stride, typename Head, typename Tail, typename T, int S>
+class StockhamStep<N,Stride,Loki::Typelist<Head,Tail>,T,S>
+{
+   static const long_t K = Head::first::value;
+   static const long_t M = N/K;
+
+   typedef ScalarComplexOps<T> Ops;
+   typedef SIMDComplexOps<T> SOps;
+   static const long_t Width = SIMDTraits<T>::Width;
+   static const bool isSeqVec = (Width > 1 && Stride >= Width);
+   static const bool isBflyVec = (Width > 1 && Stride == 1 && M >= Width);
+   typedef typename Loki::Select<(isSeqVec || isBflyVec), SOps, Ops>::Result VOps;
+   static const long_t WRep = isSeqVec ? Width : 1;   // copies of every twiddle factor
+
+   typedef typename Loki::Select<(Head::second::value > 1),
+      Loki::Typelist<pair_<typename Head::first, ulong_<Head::second::value-1> >, Tail>,
+      Tail>::Result NFactNext;
+   StockhamStep<M,K*Stride,NFactNext,T,S> m_next;
+   StockhamButterfly<K,T,S> m_bfly;
+
+   // position of w^{pk} in m_w
+   static long_t index(const long_t p, const long_t k)
+   {
+      return isBflyVec ? 2*((k-1)*M + p) : 2*WRep*(p*(K-1) + k-1);
+   }
+
+   // the twiddle factors shared by all the instances
+   struct Roots {
+      std::vector<T> w;
+      Roots() : w(2*M*(K-1)*WRep)
+      {
+         for (long_t p = 0; p < M; ++p)
+           for (long_t k = 1; k < K; ++k) {
+             const long double a = 2*M_PIl*p*k/N;
+             for (long_t i = 0; i < WRep; ++i) {
+               w[index(p,k) + 2*i]     = static_cast<T>(std::cos(a));
+               w[index(p,k) + 2*i + 1] = static_cast<T>(-S*std::sin(a));
+             }
+           }
+      }
+   };
+   const T* m_w;
+
+   // sequences from q0 to q1 by COps::Width at once
+   template<class COps>
+   void apply_seq(const T* x, T* y, const long_t p, const long_t q0, const long_t q1) const
+   {
+      typedef typename COps::V V;
+      V w[K];
+      for (long_t k = 1; k < K; ++k)
+        w[k] = COps::load(&m_w[index(p,k)]);
+      for (long_t q = q0; q < q1; q += COps::Width) {
+        V a[K], b[K];
+        for (long_t j = 0; j < K; ++j)
+          a[j] = COps::load(x + 2*(q + Stride*(p + j*M)));
+        m_bfly.template apply<COps>(a, b);
+        COps::store(y + 2*(q + Stride*K*p), b[0]);
+        for (long_t k = 1; k < K; ++k)
+          COps::store(y + 2*(q + Stride*(K*p + k)), COps::cmul(b[k], w[k]));
+      }
+   }
+
+   // butterflies from p0 to p1 by COps::Width at once, Stride is one
+   template<class COps>
+   void apply_bfly(const T* x, T* y, const long_t p0, const long_t p1) const
+   {
+      typedef typename COps::V V;
+      T buf[2*K*COps::Width];
+      for (long_t p = p0; p < p1; p += COps::Width) {
+        V a[K], b[K];
+        for (long_t j = 0; j < K; ++j)
+          a[j] = COps::load(x + 2*(p + j*M));
+        m_bfly.template apply<COps>(a, b);
+        COps::store(buf, b[0]);
+        for (long_t k = 1; k < K; ++k)
+          COps::store(buf + 2*k*COps::Width, COps::cmul(b[k], COps::load(&m_w[index(p,k)])));
+        for (long_t i = 0; i < COps::Width; ++i)
+          for (long_t k = 0; k < K; ++k) {
+            y[2*(K*(p+i) + k)]     = buf[2*(k*COps::Width + i)];
+            y[2*(K*(p+i) + k) + 1] = buf[2*(k*COps::Width + i) + 1];
+          }
+      }
+   }
+
+   void apply(const T* x, T* y, Loki::Int2Type<true>)
+   {
+      const long_t pv = M - M%VOps::Width;
+      apply_bfly<VOps>(x, y, 0, pv);
+      apply_bfly<Ops>(x, y, pv, M);
+   }
+
+   void apply(const T* x, T* y, Loki::Int2Type<false>)
+   {
+      const long_t qv = isSeqVec ? Stride - Stride%Width : 0;
+      for (long_t p = 0; p < M; ++p) {
+        apply_seq<VOps>(x, y, p, 0, qv);
+        apply_seq<Ops>(x, y, p, qv, Stride);
+      }
+   }
+
+public:
+   StockhamStep() : m_w(&SharedTable<Roots>::Instance().w[0]) { }
+
+   void apply(const T* x, T* y, T* z)
+   {
+      apply(x, y, Loki::Int2Type<isBflyVec>());
+      m_next.apply(y, z, y);
+   }
+};
+
+template<long_t Stride, typename T, int S>
+class StockhamStep<1,Stride,Loki::NullType,T,S>
+{
+public:
+   void apply(const T*, T*, T*) { }
+};
+
+
+/// Out-of-place Stockham autosort FFT
+/*!
+\tparam N transform length
+\tparam NFact factorization list
+\tparam VType type of data element
+\tparam S sign of the transform: 1 - forward, -1 - backward
+
+The steps (see StockhamStep) read and write the data contiguously
+and alternate between the output and the scratch buffer, which are chosen
+so that the last step writes the output. The input is not modified.
+The scratch buffer of N complex numbers is taken from ThreadScratch,
+unless the caller passes its own one, so that the object may be shared by the threads.
+Unlike InTimeOOP, no step accesses the input with the large strides,
+so the algorithm is cache-friendly for large N.
+\sa InTimeOOP, StockhamStep
+*/
+template<long_t N, typename NFact, typename VType, int S>
+class Stockham
+{
+   typedef typename VType::base_type T;
+   static const bool isOdd = (FactorCount<NFact>::value % 2 == 1);
+
+   StockhamStep<N,1,NFact,T,S> m_steps;
+
+public:
+   void apply(const T* src, T* dst, T* buf)
+   {
+      if (isOdd)
+        m_steps.apply(src, dst, buf);
+      else
+        m_steps.apply(src, buf, dst);
+   }
+
+   void apply(const T* src, T* dst)
+   {
+      apply(src, dst, ThreadScratch<Stockham,T>::get(2*N));
+   }
+
+   void apply(const std::complex<T>* src, std::complex<T>* dst, std::complex<T>* buf)
+   {
+      apply(reinterpret_cast<const T*>(src), reinterpret_cast<T*>(dst), reinterpret_cast<T*>(buf));
+   }
+
+   void apply(const std::complex<T>* src, std::complex<T>* dst)
+   {
+      apply(reinterpret_cast<const T*>(src), reinterpret_cast<T*>(dst));
+   }
+};
+
+}  //namespace GFFT
+
+#endif /*__gfftalgstockham_h*/
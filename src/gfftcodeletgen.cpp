@@ -0,0 +1,476 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Vladimir Mirnyy                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ ***************************************************************************/
+
+/** \file
+    \brief Generator of the straight-line DFT codelets in gfftcodelets.h
+
+    Usage: gfftcodeletgen [N ...] > gfftcodelets.h
+
+    The program writes the header with the class CodeletDFT<N,S,Ops> for every
+    length N from 2 to MaxLength given in the command line or for DefaultLengths.
+    The DFT is built as a graph of the operations on complex numbers:
+    the lengths of a prime power are split by Cooley-Tukey, the coprime factors
+    by the prime-factor algorithm without twiddle factors, and the prime lengths
+    are computed in the symmetric form with the real factors (see ShortDFTOdd).
+    The equal subexpressions are merged, the multiplications by 1, -1 and the
+    changes of sign are folded into the additions and subtractions,
+    the factors \f$ \pm i \f$ become Ops::imul() and the twiddle factors
+    \f$ (\pm 1 \pm i)/\sqrt 2 \f$ one real multiplication.
+    Every codelet is checked against the direct DFT before it is written.
+
+    The generated code depends on the sign S of the transform only through
+    Ops::imul<S>(), so the same code serves both directions.
+    The real factors are the constexpr array m_k, so the codelets have no state
+    and need no initialization.
+    The operations Ops (ScalarComplexOps or SIMDComplexOps) make it usable for
+    all value types through the wrappers DFTkOdd and DFTkOdd_inp.
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <complex>
+#include <vector>
+#include <map>
+#include <string>
+
+namespace {
+
+typedef long double Real;
+typedef std::complex<Real> Complex;
+
+const Real Pi = 3.141592653589793238462643383279502884L;
+const Real Eps = 1e-15L;
+
+/// Longest codelet the generator accepts
+const int MaxLength = 64;
+
+/// Lengths written by default: the odd radices up to RaderThreshold without
+/// the hand-written Winograd kernels for 3, 5 and 7 (see ShortDFTOdd).
+/// The larger primes are faster by Rader's algorithm (RaderDFTk) due to the
+/// quadratic number of the operations in the symmetric form.
+const int DefaultLengths[] = { 9, 11, 13 };
+
+enum Op { Input, Add, Sub, Scale, IMul };
+
+struct Node {
+  Op op;
+  int a, b;   // operands
+  int k;      // index of the input or of the real factor
+};
+
+/// Node of the graph with an optional change of sign
+struct Ref {
+  int node;
+  bool neg;
+  Ref(const int n = 0, const bool s = false) : node(n), neg(s) { }
+};
+
+Ref operator-(const Ref& x) { return Ref(x.node, !x.neg); }
+
+
+/// Graph of the operations on complex numbers with merged subexpressions
+class Graph
+{
+  std::vector<Node> m_nodes;
+  std::vector<Real> m_factors;
+  std::map<std::vector<int>, int> m_index;
+
+  int node(const Op op, int a, int b, const int k)
+  {
+    if (op == Add && a > b)
+      std::swap(a, b);
+    std::vector<int> key(4);
+    key[0] = op; key[1] = a; key[2] = b; key[3] = k;
+    std::map<std::vector<int>, int>::const_iterator it = m_index.find(key);
+    if (it != m_index.end())
+      return it->second;
+    const Node n = { op, a, b, k };
+    m_nodes.push_back(n);
+    const int id = m_nodes.size() - 1;
+    m_index[key] = id;
+    return id;
+  }
+
+  int factor(const Real c)
+  {
+    for (size_t i = 0; i < m_factors.size(); ++i)
+      if (std::fabs(m_factors[i] - c) < Eps)
+        return i;
+    m_factors.push_back(c);
+    return m_factors.size() - 1;
+  }
+
+public:
+  const std::vector<Node>& nodes() const { return m_nodes; }
+  const std::vector<Real>& factors() const { return m_factors; }
+
+  Ref input(const int i) { return Ref(node(Input, -1, -1, i)); }
+
+  Ref add(const Ref& x, const Ref& y)
+  {
+    if (x.neg && y.neg)
+      return -Ref(node(Add, x.node, y.node, -1));
+    if (x.neg)
+      return Ref(node(Sub, y.node, x.node, -1));
+    if (y.neg)
+      return Ref(node(Sub, x.node, y.node, -1));
+    return Ref(node(Add, x.node, y.node, -1));
+  }
+
+  Ref sub(const Ref& x, const Ref& y) { return add(x, -y); }
+
+  Ref scale(const Ref& x, const Real c)
+  {
+    if (std::fabs(c - 1) < Eps)
+      return x;
+    if (std::fabs(c + 1) < Eps)
+      return -x;
+    if (c < 0)
+      return -scale(x, -c);
+    return Ref(node(Scale, x.node, -1, factor(c)), x.neg);
+  }
+
+  // multiplication by i
+  Ref imul(const Ref& x) { return Ref(node(IMul, x.node, -1, -1), x.neg); }
+
+  // multiplication by c + i*s
+  Ref mul(const Ref& x, const Real c, const Real s)
+  {
+    if (std::fabs(s) < Eps)
+      return scale(x, c);
+    if (std::fabs(c) < Eps)
+      return scale(imul(x), s);
+    if (std::fabs(std::fabs(c) - std::fabs(s)) < Eps)
+      return scale((c*s > 0) ? add(x, imul(x)) : sub(x, imul(x)), c);
+    return add(scale(x, c), scale(imul(x), s));
+  }
+
+  // values of all nodes for the input x
+  std::vector<Complex> evaluate(const std::vector<Complex>& x) const
+  {
+    std::vector<Complex> v(m_nodes.size());
+    for (size_t i = 0; i < m_nodes.size(); ++i) {
+      const Node& n = m_nodes[i];
+      switch (n.op) {
+        case Input: v[i] = x[n.k]; break;
+        case Add:   v[i] = v[n.a] + v[n.b]; break;
+        case Sub:   v[i] = v[n.a] - v[n.b]; break;
+        case Scale: v[i] = v[n.a] * m_factors[n.k]; break;
+        case IMul:  v[i] = v[n.a] * Complex(0, 1); break;
+      }
+    }
+    return v;
+  }
+};
+
+
+// twiddle factor w^e, w = exp(-2*pi*i/n)
+Ref twiddle(Graph& g, const Ref& x, const int e, const int n)
+{
+  const int r = e % n;
+  if (r == 0)
+    return x;
+  const Real a = 2*Pi*r/n;
+  return g.mul(x, std::cos(a), -std::sin(a));
+}
+
+std::vector<Ref> dft(Graph& g, const std::vector<Ref>& x);
+
+// symmetric form of the prime length
+std::vector<Ref> dftPrime(Graph& g, const std::vector<Ref>& x)
+{
+  const int n = x.size();
+  const int k2 = (n-1)/2;
+  std::vector<Ref> s(k2+1), d(k2+1), y(n);
+  Ref y0 = x[0];
+  for (int j = 1; j <= k2; ++j) {
+    s[j] = g.add(x[j], x[n-j]);
+    d[j] = g.sub(x[j], x[n-j]);
+    y0 = g.add(y0, s[j]);
+  }
+  y[0] = y0;
+  for (int k = 1; k <= k2; ++k) {
+    Ref a = x[0], b;
+    for (int j = 1; j <= k2; ++j) {
+      const Real t = 2*Pi*((j*k) % n)/n;
+      a = g.add(a, g.scale(s[j], std::cos(t)));
+      const Ref c = g.scale(d[j], std::sin(t));
+      b = (j == 1) ? c : g.add(b, c);
+    }
+    const Ref ib = g.imul(b);
+    y[k]   = g.sub(a, ib);
+    y[n-k] = g.add(a, ib);
+  }
+  return y;
+}
+
+// Cooley-Tukey decimation in time, n = r*m
+std::vector<Ref> dftSplit(Graph& g, const std::vector<Ref>& x, const int r)
+{
+  const int n = x.size();
+  const int m = n/r;
+  std::vector<std::vector<Ref> > z(r);
+  for (int j = 0; j < r; ++j) {
+    std::vector<Ref> t(m);
+    for (int q = 0; q < m; ++q)
+      t[q] = x[r*q + j];
+    z[j] = dft(g, t);
+  }
+  std::vector<Ref> y(n);
+  for (int k = 0; k < m; ++k) {
+    std::vector<Ref> t(r);
+    for (int j = 0; j < r; ++j)
+      t[j] = twiddle(g, z[j][k], j*k, n);
+    const std::vector<Ref> u = dft(g, t);
+    for (int q = 0; q < r; ++q)
+      y[k + m*q] = u[q];
+  }
+  return y;
+}
+
+int inverse(const int a, const int m)
+{
+  for (int i = 1; i < m; ++i)
+    if ((a*i) % m == 1)
+      return i;
+  return 0;
+}
+
+// prime-factor algorithm, n = n1*n2 with coprime n1, n2
+std::vector<Ref> dftPrimeFactor(Graph& g, const std::vector<Ref>& x, const int n1)
+{
+  const int n = x.size();
+  const int n2 = n/n1;
+  std::vector<std::vector<Ref> > z(n1);
+  for (int j1 = 0; j1 < n1; ++j1) {
+    std::vector<Ref> t(n2);
+    for (int j2 = 0; j2 < n2; ++j2)
+      t[j2] = x[(j1*n2 + j2*n1) % n];
+    z[j1] = dft(g, t);
+  }
+  const int e1 = n2*inverse(n2, n1);
+  const int e2 = n1*inverse(n1, n2);
+  std::vector<Ref> y(n);
+  for (int k2 = 0; k2 < n2; ++k2) {
+    std::vector<Ref> t(n1);
+    for (int j1 = 0; j1 < n1; ++j1)
+      t[j1] = z[j1][k2];
+    const std::vector<Ref> u = dft(g, t);
+    for (int k1 = 0; k1 < n1; ++k1)
+      y[(k1*e1 + k2*e2) % n] = u[k1];
+  }
+  return y;
+}
+
+std::vector<Ref> dft(Graph& g, const std::vector<Ref>& x)
+{
+  const int n = x.size();
+  if (n == 1)
+    return x;
+  if (n == 2) {
+    std::vector<Ref> y(2);
+    y[0] = g.add(x[0], x[1]);
+    y[1] = g.sub(x[0], x[1]);
+    return y;
+  }
+  int p = 2;
+  while (n % p)
+    ++p;
+  int q = 1, e = 0;
+  while (n % (q*p) == 0) {
+    q *= p;
+    ++e;
+  }
+  if (q < n)
+    return dftPrimeFactor(g, x, q);
+  if (e == 1)
+    return dftPrime(g, x);
+  int r = 1;
+  for (int i = 0; i < e/2; ++i)
+    r *= p;
+  return dftSplit(g, x, r);
+}
+
+
+// checks the graph against the direct DFT
+bool check(const Graph& g, const std::vector<Ref>& y)
+{
+  const int n = y.size();
+  std::vector<Complex> x(n);
+  for (int j = 0; j < n; ++j)
+    x[j] = Complex(std::rand()/(Real)RAND_MAX - 0.5L, std::rand()/(Real)RAND_MAX - 0.5L);
+  const std::vector<Complex> v = g.evaluate(x);
+  for (int k = 0; k < n; ++k) {
+    Complex r = 0;
+    for (int j = 0; j < n; ++j) {
+      const Real a = 2*Pi*((j*k) % n)/n;
+      r += x[j]*Complex(std::cos(a), -std::sin(a));
+    }
+    const Complex t = y[k].neg ? -v[y[k].node] : v[y[k].node];
+    if (std::abs(t - r) > 1e-14L*n)
+      return false;
+  }
+  return true;
+}
+
+void writeCodelet(const int n)
+{
+  Graph g;
+  std::vector<Ref> x(n);
+  for (int j = 0; j < n; ++j)
+    x[j] = g.input(j);
+  const std::vector<Ref> y = dft(g, x);
+  if (!check(g, y)) {
+    std::fprintf(stderr, "gfftcodeletgen: wrong codelet for N=%d\n", n);
+    std::exit(1);
+  }
+
+  // nodes needed for the result
+  const std::vector<Node>& nodes = g.nodes();
+  std::vector<bool> used(nodes.size(), false);
+  for (int k = 0; k < n; ++k)
+    used[y[k].node] = true;
+  for (int i = nodes.size() - 1; i >= 0; --i)
+    if (used[i] && nodes[i].op != Input) {
+      used[nodes[i].a] = true;
+      if (nodes[i].op == Add || nodes[i].op == Sub)
+        used[nodes[i].b] = true;
+    }
+
+  // names of the temporaries and the numbers of the real factors
+  std::vector<int> name(nodes.size(), -1), fnum(g.factors().size(), -1);
+  std::vector<Real> factors;
+  int temps = 0, adds = 0, muls = 0;
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    if (!used[i] || nodes[i].op == Input)
+      continue;
+    name[i] = temps++;
+    if (nodes[i].op == Add || nodes[i].op == Sub)
+      ++adds;
+    if (nodes[i].op == Scale) {
+      ++muls;
+      if (fnum[nodes[i].k] < 0) {
+        fnum[nodes[i].k] = factors.size();
+        factors.push_back(g.factors()[nodes[i].k]);
+      }
+    }
+  }
+
+  std::vector<std::string> var(nodes.size());
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    char buf[32];
+    if (nodes[i].op == Input)
+      std::sprintf(buf, "x[%d]", nodes[i].k);
+    else
+      std::sprintf(buf, "t%d", name[i]);
+    var[i] = buf;
+  }
+
+  std::printf("template<int S, class Ops>\n");
+  std::printf("class CodeletDFT<%d,S,Ops>\n{\n", n);
+  std::printf("  typedef typename Ops::V V;\n");
+  std::printf("  typedef typename Ops::Scalar T;\n");
+  if (!factors.empty()) {
+    std::printf("\n  static constexpr long double m_k[%d] = {\n", (int)factors.size());
+    for (size_t i = 0; i < factors.size(); ++i)
+      std::printf("    %.21LeL%s\n", factors[i], (i+1 < factors.size()) ? "," : "");
+    std::printf("  };\n\n");
+    std::printf("  static V mul(const V a, const int i) { return Ops::scale(a, Ops::real(static_cast<T>(m_k[i]))); }\n");
+  }
+  std::printf("\npublic:\n");
+  std::printf("  // %d additions, %d multiplications by real factors\n", adds, muls);
+  std::printf("  void apply(const V* x, V* y) const\n  {\n");
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    if (!used[i] || nodes[i].op == Input)
+      continue;
+    const Node& nd = nodes[i];
+    std::printf("    const V %s = ", var[i].c_str());
+    switch (nd.op) {
+      case Add:   std::printf("Ops::add(%s, %s);\n", var[nd.a].c_str(), var[nd.b].c_str()); break;
+      case Sub:   std::printf("Ops::sub(%s, %s);\n", var[nd.a].c_str(), var[nd.b].c_str()); break;
+      case Scale: std::printf("mul(%s, %d);\n", var[nd.a].c_str(), fnum[nd.k]); break;
+      case IMul:  std::printf("Ops::template imul<S>(%s);\n", var[nd.a].c_str()); break;
+      default: break;
+    }
+  }
+  for (int k = 0; k < n; ++k) {
+    const Node& nd = nodes[y[k].node];
+    const char* v = var[y[k].node].c_str();
+    std::printf("    y[%d] = ", k);
+    if (!y[k].neg)
+      std::printf("%s;\n", v);
+    else if (nd.op == Sub)
+      std::printf("Ops::sub(%s, %s);\n", var[nd.b].c_str(), var[nd.a].c_str());
+    else if (nd.op == IMul)
+      std::printf("Ops::template imul<-S>(%s);\n", var[nd.a].c_str());
+    else
+      std::printf("Ops::scale(%s, Ops::real(static_cast<T>(-1)));\n", v);
+  }
+  std::printf("  }\n};\n\n");
+  if (!factors.empty()) {
+    std::printf("template<int S, class Ops>\n");
+    std::printf("constexpr long double CodeletDFT<%d,S,Ops>::m_k[%d];\n\n", n, (int)factors.size());
+  }
+}
+
+}  // namespace
+
+
+int main(int argc, char** argv)
+{
+  std::vector<int> lengths;
+  for (int i = 1; i < argc; ++i)
+    lengths.push_back(std::atoi(argv[i]));
+  if (lengths.empty())
+    lengths.assign(DefaultLengths, DefaultLengths + sizeof(DefaultLengths)/sizeof(int));
+  for (size_t i = 0; i < lengths.size(); ++i)
+    if (lengths[i] < 2 || lengths[i] > MaxLength) {
+      std::fprintf(stderr, "gfftcodeletgen: the length must be from 2 to %d\n", MaxLength);
+      return 1;
+    }
+
+  std::printf("/***************************************************************************\n"
+              " *   Copyright (C) 2015 by Vladimir Mirnyy                                 *\n"
+              " *                                                                         *\n"
+              " *   This program is free software; you can redistribute it and/or modify  *\n"
+              " *   it under the terms of the GNU General Public License as published by  *\n"
+              " *   the Free Software Foundation; either version 2 of the License, or     *\n"
+              " *   (at your option) any later version.                                   *\n"
+              " *                                                                         *\n"
+              " *   This program is distributed in the hope that it will be useful,       *\n"
+              " *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *\n"
+              " *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *\n"
+              " *   GNU General Public License for more details.                          *\n"
+              " ***************************************************************************/\n\n");
+  std::printf("#ifndef __gfftcodelets_h\n#define __gfftcodelets_h\n\n");
+  std::printf("/** \\file\n    \\brief Straight-line DFT codelets\n\n");
+  std::printf("    This file is generated by gfftcodeletgen (see gfftcodeletgen.cpp), do not edit.\n*/\n\n");
+  std::printf("namespace GFFT {\n\n");
+  std::printf("/// Straight-line DFT of the length N\n/*!\n");
+  std::printf("\\tparam N transform length\n");
+  std::printf("\\tparam S sign of the transform (-1 for inverse)\n");
+  std::printf("\\tparam Ops operations on complex numbers (ScalarComplexOps or SIMDComplexOps)\n\n");
+  std::printf("The member apply() transforms N complex numbers from the array x into the array y.\n");
+  std::printf("HasCodelet<N>::value is true, if the codelet of the length N is generated.\n");
+  std::printf("\\sa ShortDFTOdd\n*/\n");
+  std::printf("template<long_t N, int S, class Ops>\nclass CodeletDFT;\n\n");
+  std::printf("template<long_t N>\nstruct HasCodelet {\n   static const bool value = false;\n};\n\n");
+  for (size_t i = 0; i < lengths.size(); ++i)
+    std::printf("template<>\nstruct HasCodelet<%d> {\n   static const bool value = true;\n};\n\n", lengths[i]);
+  for (size_t i = 0; i < lengths.size(); ++i)
+    writeCodelet(lengths[i]);
+  std::printf("}  //namespace GFFT\n\n#endif /*__gfftcodelets_h*/\n");
+  return 0;
+}
@@ -0,0 +1,556 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Vladimir Mirnyy                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ ***************************************************************************/
+
+#ifndef __gfftcodelets_h
+#define __gfftcodelets_h
+
+/** \file
+    \brief Straight-line DFT codelets
+
+    This file is generated by gfftcodeletgen (see gfftcodeletgen.cpp), do not edit.
+*/
+
+namespace GFFT {
+
+/// Straight-line DFT of the length N
+/*!
+\tparam N transform length
+\tparam S sign of the transform (-1 for inverse)
+\tparam Ops operations on complex numbers (ScalarComplexOps or SIMDComplexOps)
+
+The member apply() transforms N complex numbers from the array x into the array y.
+HasCodelet<N>::value is true, if the codelet of the length N is generated.
+\sa ShortDFTOdd
+*/
+template<long_t N, int S, class Ops>
+class CodeletDFT;
+
+template<long_t N>
+struct HasCodelet {
+   static const bool value = false;
+};
+
+template<>
+struct HasCodelet<9> {
+   static const bool value = true;
+};
+
+template<>
+struct HasCodelet<11> {
+   static const bool value = true;
+};
+
+template<>
+struct HasCodelet<13> {
+   static const bool value = true;
+};
+
+template<int S, class Ops>
+class CodeletDFT<9,S,Ops>
+{
+  typedef typename Ops::V V;
+  typedef typename Ops::Scalar T;
+
+  static constexpr long double m_k[8] = {
+    4.999999999999999999729e-01L,
+    8.660254037844386467869e-01L,
+    6.427876096865393263269e-01L,
+    7.660444431189780351899e-01L,
+    9.848077530122080594011e-01L,
+    1.736481776669303488049e-01L,
+    3.420201433256687329658e-01L,
+    9.396926207859083841033e-01L
+  };
+
+  static V mul(const V a, const int i) { return Ops::scale(a, Ops::real(static_cast<T>(m_k[i]))); }
+
+public:
+  // 40 additions, 20 multiplications by real factors
+  void apply(const V* x, V* y) const
+  {
+    const V t0 = Ops::add(x[3], x[6]);
+    const V t1 = Ops::sub(x[3], x[6]);
+    const V t2 = Ops::add(x[0], t0);
+    const V t3 = mul(t0, 0);
+    const V t4 = Ops::sub(x[0], t3);
+    const V t5 = mul(t1, 1);
+    const V t6 = Ops::template imul<S>(t5);
+    const V t7 = Ops::sub(t4, t6);
+    const V t8 = Ops::add(t4, t6);
+    const V t9 = Ops::add(x[4], x[7]);
+    const V t10 = Ops::sub(x[4], x[7]);
+    const V t11 = Ops::add(x[1], t9);
+    const V t12 = mul(t9, 0);
+    const V t13 = Ops::sub(x[1], t12);
+    const V t14 = mul(t10, 1);
+    const V t15 = Ops::template imul<S>(t14);
+    const V t16 = Ops::sub(t13, t15);
+    const V t17 = Ops::add(t13, t15);
+    const V t18 = Ops::add(x[5], x[8]);
+    const V t19 = Ops::sub(x[5], x[8]);
+    const V t20 = Ops::add(x[2], t18);
+    const V t21 = mul(t18, 0);
+    const V t22 = Ops::sub(x[2], t21);
+    const V t23 = mul(t19, 1);
+    const V t24 = Ops::template imul<S>(t23);
+    const V t25 = Ops::sub(t22, t24);
+    const V t26 = Ops::add(t22, t24);
+    const V t27 = Ops::add(t11, t20);
+    const V t28 = Ops::sub(t11, t20);
+    const V t29 = Ops::add(t2, t27);
+    const V t30 = mul(t27, 0);
+    const V t31 = Ops::sub(t2, t30);
+    const V t32 = mul(t28, 1);
+    const V t33 = Ops::template imul<S>(t32);
+    const V t34 = Ops::sub(t31, t33);
+    const V t35 = Ops::add(t31, t33);
+    const V t36 = Ops::template imul<S>(t16);
+    const V t37 = mul(t36, 2);
+    const V t38 = mul(t16, 3);
+    const V t39 = Ops::sub(t38, t37);
+    const V t40 = Ops::template imul<S>(t25);
+    const V t41 = mul(t40, 4);
+    const V t42 = mul(t25, 5);
+    const V t43 = Ops::sub(t42, t41);
+    const V t44 = Ops::add(t39, t43);
+    const V t45 = Ops::sub(t39, t43);
+    const V t46 = Ops::add(t7, t44);
+    const V t47 = mul(t44, 0);
+    const V t48 = Ops::sub(t7, t47);
+    const V t49 = mul(t45, 1);
+    const V t50 = Ops::template imul<S>(t49);
+    const V t51 = Ops::sub(t48, t50);
+    const V t52 = Ops::add(t48, t50);
+    const V t53 = Ops::template imul<S>(t17);
+    const V t54 = mul(t53, 4);
+    const V t55 = mul(t17, 5);
+    const V t56 = Ops::sub(t55, t54);
+    const V t57 = Ops::template imul<S>(t26);
+    const V t58 = mul(t57, 6);
+    const V t59 = mul(t26, 7);
+    const V t60 = Ops::add(t58, t59);
+    const V t61 = Ops::sub(t56, t60);
+    const V t62 = Ops::add(t56, t60);
+    const V t63 = Ops::add(t8, t61);
+    const V t64 = mul(t61, 0);
+    const V t65 = Ops::sub(t8, t64);
+    const V t66 = mul(t62, 1);
+    const V t67 = Ops::template imul<S>(t66);
+    const V t68 = Ops::sub(t65, t67);
+    const V t69 = Ops::add(t65, t67);
+    y[0] = t29;
+    y[1] = t46;
+    y[2] = t63;
+    y[3] = t34;
+    y[4] = t51;
+    y[5] = t68;
+    y[6] = t35;
+    y[7] = t52;
+    y[8] = t69;
+  }
+};
+
+template<int S, class Ops>
+constexpr long double CodeletDFT<9,S,Ops>::m_k[8];
+
+template<int S, class Ops>
+class CodeletDFT<11,S,Ops>
+{
+  typedef typename Ops::V V;
+  typedef typename Ops::Scalar T;
+
+  static constexpr long double m_k[10] = {
+    8.412535328311811688631e-01L,
+    5.406408174555975821012e-01L,
+    4.154150130018864254893e-01L,
+    9.096319953545183714183e-01L,
+    1.423148382732851404602e-01L,
+    9.898214418809327323594e-01L,
+    6.548607339452850641267e-01L,
+    7.557495743542582837039e-01L,
+    9.594929736144973899011e-01L,
+    2.817325568414296976523e-01L
+  };
+
+  static V mul(const V a, const int i) { return Ops::scale(a, Ops::real(static_cast<T>(m_k[i]))); }
+
+public:
+  // 70 additions, 50 multiplications by real factors
+  void apply(const V* x, V* y) const
+  {
+    const V t0 = Ops::add(x[1], x[10]);
+    const V t1 = Ops::sub(x[1], x[10]);
+    const V t2 = Ops::add(x[0], t0);
+    const V t3 = Ops::add(x[2], x[9]);
+    const V t4 = Ops::sub(x[2], x[9]);
+    const V t5 = Ops::add(t2, t3);
+    const V t6 = Ops::add(x[3], x[8]);
+    const V t7 = Ops::sub(x[3], x[8]);
+    const V t8 = Ops::add(t5, t6);
+    const V t9 = Ops::add(x[4], x[7]);
+    const V t10 = Ops::sub(x[4], x[7]);
+    const V t11 = Ops::add(t8, t9);
+    const V t12 = Ops::add(x[5], x[6]);
+    const V t13 = Ops::sub(x[5], x[6]);
+    const V t14 = Ops::add(t11, t12);
+    const V t15 = mul(t0, 0);
+    const V t16 = Ops::add(x[0], t15);
+    const V t17 = mul(t1, 1);
+    const V t18 = mul(t3, 2);
+    const V t19 = Ops::add(t16, t18);
+    const V t20 = mul(t4, 3);
+    const V t21 = Ops::add(t17, t20);
+    const V t22 = mul(t6, 4);
+    const V t23 = Ops::sub(t19, t22);
+    const V t24 = mul(t7, 5);
+    const V t25 = Ops::add(t21, t24);
+    const V t26 = mul(t9, 6);
+    const V t27 = Ops::sub(t23, t26);
+    const V t28 = mul(t10, 7);
+    const V t29 = Ops::add(t25, t28);
+    const V t30 = mul(t12, 8);
+    const V t31 = Ops::sub(t27, t30);
+    const V t32 = mul(t13, 9);
+    const V t33 = Ops::add(t29, t32);
+    const V t34 = Ops::template imul<S>(t33);
+    const V t35 = Ops::sub(t31, t34);
+    const V t36 = Ops::add(t31, t34);
+    const V t37 = mul(t0, 2);
+    const V t38 = Ops::add(x[0], t37);
+    const V t39 = mul(t1, 3);
+    const V t40 = mul(t3, 6);
+    const V t41 = Ops::sub(t38, t40);
+    const V t42 = mul(t4, 7);
+    const V t43 = Ops::add(t39, t42);
+    const V t44 = mul(t6, 8);
+    const V t45 = Ops::sub(t41, t44);
+    const V t46 = mul(t7, 9);
+    const V t47 = Ops::sub(t43, t46);
+    const V t48 = mul(t9, 4);
+    const V t49 = Ops::sub(t45, t48);
+    const V t50 = mul(t10, 5);
+    const V t51 = Ops::sub(t47, t50);
+    const V t52 = mul(t12, 0);
+    const V t53 = Ops::add(t49, t52);
+    const V t54 = mul(t13, 1);
+    const V t55 = Ops::sub(t51, t54);
+    const V t56 = Ops::template imul<S>(t55);
+    const V t57 = Ops::sub(t53, t56);
+    const V t58 = Ops::add(t53, t56);
+    const V t59 = mul(t0, 4);
+    const V t60 = Ops::sub(x[0], t59);
+    const V t61 = mul(t1, 5);
+    const V t62 = mul(t3, 8);
+    const V t63 = Ops::sub(t60, t62);
+    const V t64 = mul(t4, 9);
+    const V t65 = Ops::sub(t61, t64);
+    const V t66 = mul(t6, 2);
+    const V t67 = Ops::add(t63, t66);
+    const V t68 = mul(t7, 3);
+    const V t69 = Ops::sub(t65, t68);
+    const V t70 = mul(t9, 0);
+    const V t71 = Ops::add(t67, t70);
+    const V t72 = mul(t10, 1);
+    const V t73 = Ops::add(t69, t72);
+    const V t74 = mul(t12, 6);
+    const V t75 = Ops::sub(t71, t74);
+    const V t76 = mul(t13, 7);
+    const V t77 = Ops::add(t73, t76);
+    const V t78 = Ops::template imul<S>(t77);
+    const V t79 = Ops::sub(t75, t78);
+    const V t80 = Ops::add(t75, t78);
+    const V t81 = mul(t0, 6);
+    const V t82 = Ops::sub(x[0], t81);
+    const V t83 = mul(t1, 7);
+    const V t84 = mul(t3, 4);
+    const V t85 = Ops::sub(t82, t84);
+    const V t86 = mul(t4, 5);
+    const V t87 = Ops::sub(t83, t86);
+    const V t88 = mul(t6, 0);
+    const V t89 = Ops::add(t85, t88);
+    const V t90 = mul(t7, 1);
+    const V t91 = Ops::add(t87, t90);
+    const V t92 = mul(t9, 8);
+    const V t93 = Ops::sub(t89, t92);
+    const V t94 = mul(t10, 9);
+    const V t95 = Ops::add(t91, t94);
+    const V t96 = mul(t12, 2);
+    const V t97 = Ops::add(t93, t96);
+    const V t98 = mul(t13, 3);
+    const V t99 = Ops::sub(t95, t98);
+    const V t100 = Ops::template imul<S>(t99);
+    const V t101 = Ops::sub(t97, t100);
+    const V t102 = Ops::add(t97, t100);
+    const V t103 = mul(t0, 8);
+    const V t104 = Ops::sub(x[0], t103);
+    const V t105 = mul(t1, 9);
+    const V t106 = mul(t3, 0);
+    const V t107 = Ops::add(t104, t106);
+    const V t108 = mul(t4, 1);
+    const V t109 = Ops::sub(t105, t108);
+    const V t110 = mul(t6, 6);
+    const V t111 = Ops::sub(t107, t110);
+    const V t112 = mul(t7, 7);
+    const V t113 = Ops::add(t109, t112);
+    const V t114 = mul(t9, 2);
+    const V t115 = Ops::add(t111, t114);
+    const V t116 = mul(t10, 3);
+    const V t117 = Ops::sub(t113, t116);
+    const V t118 = mul(t12, 4);
+    const V t119 = Ops::sub(t115, t118);
+    const V t120 = mul(t13, 5);
+    const V t121 = Ops::add(t117, t120);
+    const V t122 = Ops::template imul<S>(t121);
+    const V t123 = Ops::sub(t119, t122);
+    const V t124 = Ops::add(t119, t122);
+    y[0] = t14;
+    y[1] = t35;
+    y[2] = t57;
+    y[3] = t79;
+    y[4] = t101;
+    y[5] = t123;
+    y[6] = t124;
+    y[7] = t102;
+    y[8] = t80;
+    y[9] = t58;
+    y[10] = t36;
+  }
+};
+
+template<int S, class Ops>
+constexpr long double CodeletDFT<11,S,Ops>::m_k[10];
+
+template<int S, class Ops>
+class CodeletDFT<13,S,Ops>
+{
+  typedef typename Ops::V V;
+  typedef typename Ops::Scalar T;
+
+  static constexpr long double m_k[12] = {
+    8.854560256532098958719e-01L,
+    4.647231720437685456625e-01L,
+    5.680647467311558024869e-01L,
+    8.229838658936563945798e-01L,
+    1.205366802553230532499e-01L,
+    9.927088740980539928352e-01L,
+    3.546048870425356260027e-01L,
+    9.350162426854148234497e-01L,
+    7.485107481711010986845e-01L,
+    6.631226582407952023219e-01L,
+    9.709418174260520271925e-01L,
+    2.393156642875577669522e-01L
+  };
+
+  static V mul(const V a, const int i) { return Ops::scale(a, Ops::real(static_cast<T>(m_k[i]))); }
+
+public:
+  // 96 additions, 72 multiplications by real factors
+  void apply(const V* x, V* y) const
+  {
+    const V t0 = Ops::add(x[1], x[12]);
+    const V t1 = Ops::sub(x[1], x[12]);
+    const V t2 = Ops::add(x[0], t0);
+    const V t3 = Ops::add(x[2], x[11]);
+    const V t4 = Ops::sub(x[2], x[11]);
+    const V t5 = Ops::add(t2, t3);
+    const V t6 = Ops::add(x[3], x[10]);
+    const V t7 = Ops::sub(x[3], x[10]);
+    const V t8 = Ops::add(t5, t6);
+    const V t9 = Ops::add(x[4], x[9]);
+    const V t10 = Ops::sub(x[4], x[9]);
+    const V t11 = Ops::add(t8, t9);
+    const V t12 = Ops::add(x[5], x[8]);
+    const V t13 = Ops::sub(x[5], x[8]);
+    const V t14 = Ops::add(t11, t12);
+    const V t15 = Ops::add(x[6], x[7]);
+    const V t16 = Ops::sub(x[6], x[7]);
+    const V t17 = Ops::add(t14, t15);
+    const V t18 = mul(t0, 0);
+    const V t19 = Ops::add(x[0], t18);
+    const V t20 = mul(t1, 1);
+    const V t21 = mul(t3, 2);
+    const V t22 = Ops::add(t19, t21);
+    const V t23 = mul(t4, 3);
+    const V t24 = Ops::add(t20, t23);
+    const V t25 = mul(t6, 4);
+    const V t26 = Ops::add(t22, t25);
+    const V t27 = mul(t7, 5);
+    const V t28 = Ops::add(t24, t27);
+    const V t29 = mul(t9, 6);
+    const V t30 = Ops::sub(t26, t29);
+    const V t31 = mul(t10, 7);
+    const V t32 = Ops::add(t28, t31);
+    const V t33 = mul(t12, 8);
+    const V t34 = Ops::sub(t30, t33);
+    const V t35 = mul(t13, 9);
+    const V t36 = Ops::add(t32, t35);
+    const V t37 = mul(t15, 10);
+    const V t38 = Ops::sub(t34, t37);
+    const V t39 = mul(t16, 11);
+    const V t40 = Ops::add(t36, t39);
+    const V t41 = Ops::template imul<S>(t40);
+    const V t42 = Ops::sub(t38, t41);
+    const V t43 = Ops::add(t38, t41);
+    const V t44 = mul(t0, 2);
+    const V t45 = Ops::add(x[0], t44);
+    const V t46 = mul(t1, 3);
+    const V t47 = mul(t3, 6);
+    const V t48 = Ops::sub(t45, t47);
+    const V t49 = mul(t4, 7);
+    const V t50 = Ops::add(t46, t49);
+    const V t51 = mul(t6, 10);
+    const V t52 = Ops::sub(t48, t51);
+    const V t53 = mul(t7, 11);
+    const V t54 = Ops::add(t50, t53);
+    const V t55 = mul(t9, 8);
+    const V t56 = Ops::sub(t52, t55);
+    const V t57 = mul(t10, 9);
+    const V t58 = Ops::sub(t54, t57);
+    const V t59 = mul(t12, 4);
+    const V t60 = Ops::add(t56, t59);
+    const V t61 = mul(t13, 5);
+    const V t62 = Ops::sub(t58, t61);
+    const V t63 = mul(t15, 0);
+    const V t64 = Ops::add(t60, t63);
+    const V t65 = mul(t16, 1);
+    const V t66 = Ops::sub(t62, t65);
+    const V t67 = Ops::template imul<S>(t66);
+    const V t68 = Ops::sub(t64, t67);
+    const V t69 = Ops::add(t64, t67);
+    const V t70 = mul(t0, 4);
+    const V t71 = Ops::add(x[0], t70);
+    const V t72 = mul(t1, 5);
+    const V t73 = mul(t3, 10);
+    const V t74 = Ops::sub(t71, t73);
+    const V t75 = mul(t4, 11);
+    const V t76 = Ops::add(t72, t75);
+    const V t77 = mul(t6, 6);
+    const V t78 = Ops::sub(t74, t77);
+    const V t79 = mul(t7, 7);
+    const V t80 = Ops::sub(t76, t79);
+    const V t81 = mul(t9, 0);
+    const V t82 = Ops::add(t78, t81);
+    const V t83 = mul(t10, 1);
+    const V t84 = Ops::sub(t80, t83);
+    const V t85 = mul(t12, 2);
+    const V t86 = Ops::add(t82, t85);
+    const V t87 = mul(t13, 3);
+    const V t88 = Ops::add(t84, t87);
+    const V t89 = mul(t15, 8);
+    const V t90 = Ops::sub(t86, t89);
+    const V t91 = mul(t16, 9);
+    const V t92 = Ops::add(t88, t91);
+    const V t93 = Ops::template imul<S>(t92);
+    const V t94 = Ops::sub(t90, t93);
+    const V t95 = Ops::add(t90, t93);
+    const V t96 = mul(t0, 6);
+    const V t97 = Ops::sub(x[0], t96);
+    const V t98 = mul(t1, 7);
+    const V t99 = mul(t3, 8);
+    const V t100 = Ops::sub(t97, t99);
+    const V t101 = mul(t4, 9);
+    const V t102 = Ops::sub(t98, t101);
+    const V t103 = mul(t6, 0);
+    const V t104 = Ops::add(t100, t103);
+    const V t105 = mul(t7, 1);
+    const V t106 = Ops::sub(t102, t105);
+    const V t107 = mul(t9, 4);
+    const V t108 = Ops::add(t104, t107);
+    const V t109 = mul(t10, 5);
+    const V t110 = Ops::add(t106, t109);
+    const V t111 = mul(t12, 10);
+    const V t112 = Ops::sub(t108, t111);
+    const V t113 = mul(t13, 11);
+    const V t114 = Ops::sub(t110, t113);
+    const V t115 = mul(t15, 2);
+    const V t116 = Ops::add(t112, t115);
+    const V t117 = mul(t16, 3);
+    const V t118 = Ops::sub(t114, t117);
+    const V t119 = Ops::template imul<S>(t118);
+    const V t120 = Ops::sub(t116, t119);
+    const V t121 = Ops::add(t116, t119);
+    const V t122 = mul(t0, 8);
+    const V t123 = Ops::sub(x[0], t122);
+    const V t124 = mul(t1, 9);
+    const V t125 = mul(t3, 4);
+    const V t126 = Ops::add(t123, t125);
+    const V t127 = mul(t4, 5);
+    const V t128 = Ops::sub(t124, t127);
+    const V t129 = mul(t6, 2);
+    const V t130 = Ops::add(t126, t129);
+    const V t131 = mul(t7, 3);
+    const V t132 = Ops::add(t128, t131);
+    const V t133 = mul(t9, 10);
+    const V t134 = Ops::sub(t130, t133);
+    const V t135 = mul(t10, 11);
+    const V t136 = Ops::sub(t132, t135);
+    const V t137 = mul(t12, 0);
+    const V t138 = Ops::add(t134, t137);
+    const V t139 = mul(t13, 1);
+    const V t140 = Ops::sub(t136, t139);
+    const V t141 = mul(t15, 6);
+    const V t142 = Ops::sub(t138, t141);
+    const V t143 = mul(t16, 7);
+    const V t144 = Ops::add(t140, t143);
+    const V t145 = Ops::template imul<S>(t144);
+    const V t146 = Ops::sub(t142, t145);
+    const V t147 = Ops::add(t142, t145);
+    const V t148 = mul(t0, 10);
+    const V t149 = Ops::sub(x[0], t148);
+    const V t150 = mul(t1, 11);
+    const V t151 = mul(t3, 0);
+    const V t152 = Ops::add(t149, t151);
+    const V t153 = mul(t4, 1);
+    const V t154 = Ops::sub(t150, t153);
+    const V t155 = mul(t6, 8);
+    const V t156 = Ops::sub(t152, t155);
+    const V t157 = mul(t7, 9);
+    const V t158 = Ops::add(t154, t157);
+    const V t159 = mul(t9, 2);
+    const V t160 = Ops::add(t156, t159);
+    const V t161 = mul(t10, 3);
+    const V t162 = Ops::sub(t158, t161);
+    const V t163 = mul(t12, 6);
+    const V t164 = Ops::sub(t160, t163);
+    const V t165 = mul(t13, 7);
+    const V t166 = Ops::add(t162, t165);
+    const V t167 = mul(t15, 4);
+    const V t168 = Ops::add(t164, t167);
+    const V t169 = mul(t16, 5);
+    const V t170 = Ops::sub(t166, t169);
+    const V t171 = Ops::template imul<S>(t170);
+    const V t172 = Ops::sub(t168, t171);
+    const V t173 = Ops::add(t168, t171);
+    y[0] = t17;
+    y[1] = t42;
+    y[2] = t68;
+    y[3] = t94;
+    y[4] = t120;
+    y[5] = t146;
+    y[6] = t172;
+    y[7] = t173;
+    y[8] = t147;
+    y[9] = t121;
+    y[10] = t95;
+    y[11] = t69;
+    y[12] = t43;
+  }
+};
+
+template<int S, class Ops>
+constexpr long double CodeletDFT<13,S,Ops>::m_k[12];
+
+}  //namespace GFFT
+
+#endif /*__gfftcodelets_h*/
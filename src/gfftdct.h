@@ -0,0 +1,487 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Vladimir Mirnyy                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ ***************************************************************************/
+
+#ifndef __gfftdct_h
+#define __gfftdct_h
+
+/** \file
+    \brief Discrete cosine transforms based on the real- and complex-valued FFT
+*/
+
+#include <vector>
+#include <cmath>
+
+#include "gfftcaller.h"
+#include "twiddles.h"
+
+namespace GFFT {
+
+/// Table of \f$ \cos(\pi j/D) \f$ and \f$ \sin(\pi j/D) \f$, j=0,...,L-1
+/*! Shared by all the instances of a transform through SharedTable. */
+template<long_t L, long_t D, typename BT>
+struct CosSinTable
+{
+   std::vector<BT> c, s;
+
+   CosSinTable() : c(L), s(L)
+   {
+      for (long_t j = 0; j < L; ++j) {
+         const long double a = M_PIl*j/D;
+         c[j] = static_cast<BT>(std::cos(a));
+         s[j] = static_cast<BT>(std::sin(a));
+      }
+   }
+};
+
+/// Discrete cosine transform of type I
+/*!
+\tparam N half of the transform length
+\tparam VType type of data element
+\tparam RList Typelist of the real-valued transform RDFT of the length N
+\tparam S sign of the transform: 1 - forward, -1 - backward
+
+The data array contains n+1 = 2N+1 real numbers (for complex value types,
+N elements and the real part of the next one):
+\f$ Y_k = x_0 + (-1)^k x_n + 2\sum_{j=1}^{n-1} x_j \cos(\pi jk/n) \f$.
+The backward transform is scaled by 1/(2n), so that it is the exact inverse.
+The strided batches of the transforms (fft_many) gather exactly 2N+1 real numbers
+(see TransformLength), the distance between the batches must be at least N+1 elements.
+
+The input is folded into n real numbers, which are transformed by RDFT.
+The even outputs are then the real parts of the result and the odd outputs
+are computed by the recurrence over the imaginary parts
+(see "Numerical recipes in C++", function cosft1).
+*/
+template<long_t N, typename VType, class RList, int S>
+class DCT1_impl
+{
+   typedef typename VType::ValueType T;
+   typedef typename VType::base_type BT;
+   static const long_t N2 = 2*N;
+
+   typedef SharedTable<CosSinTable<N,N2,BT> > Table;
+
+   Caller<RList> m_rdft;
+   const BT *m_c, *m_s;
+   BT m_scale;
+
+   // folds x[0..n] into z[0..n-1], z may coincide with x
+   BT fold(const BT* x, BT* z)
+   {
+      BT sum = m_scale*(x[0] - x[N2]);
+      z[0] = m_scale*(x[0] + x[N2]);
+      for (long_t j = 1; j < N; ++j) {
+         const BT s = m_scale*(x[j] + x[N2-j]);
+         const BT d = m_scale*(x[j] - x[N2-j]);
+         z[j]    = s - 2*m_s[j]*d;
+         z[N2-j] = s + 2*m_s[j]*d;
+         sum += 2*m_c[j]*d;
+      }
+      z[N] = 2*m_scale*x[N];
+      return sum;
+   }
+
+   // restores y[0..n] from the RDFT output in y[0..n-1]
+   void unfold(BT* y, BT sum)
+   {
+      y[N2] = y[1];
+      y[1] = sum;
+      for (long_t m = 1; m < N; ++m) {
+         sum -= y[2*m+1];
+         y[2*m+1] = sum;
+      }
+   }
+
+public:
+   DCT1_impl() 
+   : m_c(&Table::Instance().c[0]), m_s(&Table::Instance().s[0]),
+     m_scale((S==1) ? 1 : 1./(2*N2)) { }
+
+   void apply(T* data)
+   {
+      BT* x = reinterpret_cast<BT*>(data);
+      const BT sum = fold(x, x);
+      m_rdft.apply(data);
+      unfold(x, sum);
+   }
+
+   void apply(const T* src, T* dst)
+   {
+      BT* buf = ThreadScratch<DCT1_impl,BT>::get(N2);
+      const BT sum = fold(reinterpret_cast<const BT*>(src), buf);
+      m_rdft.apply(reinterpret_cast<const T*>(buf), dst);
+      unfold(reinterpret_cast<BT*>(dst), sum);
+   }
+};
+
+
+/// Discrete cosine transform of type II
+/*!
+\tparam N half of the transform length
+\tparam VType type of data element
+\tparam RList Typelist of the real-valued transform RDFT of the length N
+
+The data array contains n = 2N real numbers:
+\f$ Y_k = 2\sum_{j=0}^{n-1} x_j \cos(\pi (2j+1)k/(2n)) \f$.
+
+The input is reordered as \f$ v_j = x_{2j}, v_{n-1-j} = x_{2j+1} \f$ (Makhoul)
+and transformed by RDFT. Then \f$ Y_k = 2 Re(w^k V_k) \f$ and
+\f$ Y_{n-k} = -2 Im(w^k V_k) \f$, where \f$ w = \exp(-\pi i/(2n)) \f$.
+\sa IDCT2_impl
+*/
+template<long_t N, typename VType, class RList>
+class DCT2_impl
+{
+   typedef typename VType::ValueType T;
+   typedef typename VType::base_type BT;
+   static const long_t N2 = 2*N;
+
+   typedef SharedTable<CosSinTable<N+1,2*N2,BT> > Table;
+
+   Caller<RList> m_rdft;
+   const BT *m_c, *m_s;
+
+   static void reorder(const BT* x, BT* v)
+   {
+      for (long_t j = 0; j < N; ++j) {
+         v[j] = x[2*j];
+         v[N2-1-j] = x[2*j+1];
+      }
+   }
+
+   void twiddle(const BT* v, BT* y)
+   {
+      y[0] = 2*v[0];
+      y[N] = 2*m_c[N]*v[1];
+      for (long_t k = 1; k < N; ++k) {
+         const BT re = v[2*k], im = v[2*k+1];
+         y[k]    = 2*(m_c[k]*re + m_s[k]*im);
+         y[N2-k] = 2*(m_s[k]*re - m_c[k]*im);
+      }
+   }
+
+public:
+   DCT2_impl() : m_c(&Table::Instance().c[0]), m_s(&Table::Instance().s[0]) { }
+
+   void apply(T* data)
+   {
+      BT* buf = ThreadScratch<DCT2_impl,BT>::get(N2);
+      BT* x = reinterpret_cast<BT*>(data);
+      reorder(x, buf);
+      m_rdft.apply(reinterpret_cast<T*>(buf));
+      twiddle(buf, x);
+   }
+
+   void apply(const T* src, T* dst)
+   {
+      BT* buf = ThreadScratch<DCT2_impl,BT>::get(N2);
+      BT* y = reinterpret_cast<BT*>(dst);
+      reorder(reinterpret_cast<const BT*>(src), y);
+      m_rdft.apply(dst, reinterpret_cast<T*>(buf));
+      twiddle(buf, y);
+   }
+};
+
+
+/// Inverse discrete cosine transform of type II (scaled DCT-III)
+/*!
+\tparam N half of the transform length
+\tparam VType type of data element
+\tparam RList Typelist of the real-valued transform IRDFT of the length N
+
+The exact inverse of DCT2_impl:
+\f$ x_j = \frac{1}{n}(Y_0/2 + \sum_{k=1}^{n-1} Y_k \cos(\pi (2j+1)k/(2n))) \f$.
+The steps of DCT2_impl are done in the reverse order.
+*/
+template<long_t N, typename VType, class RList>
+class IDCT2_impl
+{
+   typedef typename VType::ValueType T;
+   typedef typename VType::base_type BT;
+   static const long_t N2 = 2*N;
+
+   typedef SharedTable<CosSinTable<N+1,2*N2,BT> > Table;
+
+   Caller<RList> m_irdft;
+   const BT *m_c, *m_s;
+
+   void twiddle(const BT* y, BT* v)
+   {
+      v[0] = 0.5*y[0];
+      v[1] = 0.5*y[N]/m_c[N];
+      for (long_t k = 1; k < N; ++k) {
+         const BT re = 0.5*y[k], im = -0.5*y[N2-k];
+         v[2*k]   = m_c[k]*re - m_s[k]*im;
+         v[2*k+1] = m_c[k]*im + m_s[k]*re;
+      }
+   }
+
+   static void reorder(const BT* v, BT* x)
+   {
+      for (long_t j = 0; j < N; ++j) {
+         x[2*j] = v[j];
+         x[2*j+1] = v[N2-1-j];
+      }
+   }
+
+public:
+   IDCT2_impl() : m_c(&Table::Instance().c[0]), m_s(&Table::Instance().s[0]) { }
+
+   void apply(T* data)
+   {
+      BT* buf = ThreadScratch<IDCT2_impl,BT>::get(N2);
+      BT* x = reinterpret_cast<BT*>(data);
+      twiddle(x, buf);
+      m_irdft.apply(reinterpret_cast<T*>(buf));
+      reorder(buf, x);
+   }
+
+   void apply(const T* src, T* dst)
+   {
+      BT* buf = ThreadScratch<IDCT2_impl,BT>::get(N2);
+      BT* x = reinterpret_cast<BT*>(dst);
+      twiddle(reinterpret_cast<const BT*>(src), x);
+      m_irdft.apply(dst, reinterpret_cast<T*>(buf));
+      reorder(buf, x);
+   }
+};
+
+
+/// Discrete cosine transform of type IV by the complex DFT of the half length
+/*!
+\tparam N half of the transform length
+\tparam VType type of data element
+\tparam DList Typelist of the out-of-place complex DFT of the length N
+
+Computes \f$ Y_k = s\sum_{j=0}^{n-1} x_j \cos(\pi (2j+1)(2k+1)/(4n)) \f$, n = 2N,
+where s is the scaling factor given to the constructor.
+The pairs \f$ (x_{2j}, x_{n-1-2j}) \f$ are combined into the complex numbers
+and multiplied by \f$ \exp(-\pi i(4j+1)/(4n)) \f$ in the same pass.
+After the DFT the result is multiplied by \f$ \exp(-\pi ik/n) \f$ and
+written into \f$ Y_{2k} \f$ (real part) and \f$ Y_{n-1-2k} \f$ (negative imaginary part).
+\sa DCT4_impl, MDCT_impl, IMDCT_impl
+*/
+template<long_t N, typename VType, class DList>
+class DCT4_core
+{
+   typedef typename VType::ValueType T;
+   typedef typename VType::base_type BT;
+   static const long_t N2 = 2*N;
+
+   // pre- and post-twiddles, shared by all the instances
+   struct Tables {
+      std::vector<BT> pre, post;
+
+      Tables() : pre(N2), post(N2)
+      {
+         for (long_t j = 0; j < N; ++j) {
+            const long double a = M_PIl*(4*j+1)/(4*N2);
+            const long double b = M_PIl*j/N2;
+            pre[2*j]    = static_cast<BT>(std::cos(a));
+            pre[2*j+1]  = static_cast<BT>(std::sin(a));
+            post[2*j]   = static_cast<BT>(std::cos(b));
+            post[2*j+1] = static_cast<BT>(std::sin(b));
+         }
+      }
+   };
+
+   Caller<DList> m_dft;
+   const BT *m_pre, *m_post;
+   BT m_scale;
+
+public:
+   DCT4_core(const long double scale = 1) 
+   : m_pre(&SharedTable<Tables>::Instance().pre[0]),
+     m_post(&SharedTable<Tables>::Instance().post[0]),
+     m_scale(static_cast<BT>(scale)) { }
+
+   /// Transforms 2N real numbers from x into y, which may coincide with x
+   void apply(const BT* x, BT* y)
+   {
+      BT* buf = ThreadScratch<DCT4_core,BT>::get(N2);
+      // the pairs j and N-1-j share their input elements
+      for (long_t j = 0; j < (N+1)/2; ++j) {
+         const long_t jj = N-1-j;
+         const BT a0 = x[2*j],  b0 = x[2*jj+1];
+         const BT a1 = x[2*jj], b1 = x[2*j+1];
+         y[2*j]    = a0*m_pre[2*j] + b0*m_pre[2*j+1];
+         y[2*j+1]  = b0*m_pre[2*j] - a0*m_pre[2*j+1];
+         y[2*jj]   = a1*m_pre[2*jj] + b1*m_pre[2*jj+1];
+         y[2*jj+1] = b1*m_pre[2*jj] - a1*m_pre[2*jj+1];
+      }
+
+      m_dft.apply(reinterpret_cast<const T*>(y), reinterpret_cast<T*>(buf));
+
+      for (long_t k = 0; k < N; ++k) {
+         const BT re = m_scale*buf[2*k], im = m_scale*buf[2*k+1];
+         y[2*k]      = re*m_post[2*k] + im*m_post[2*k+1];
+         y[N2-1-2*k] = re*m_post[2*k+1] - im*m_post[2*k];
+      }
+   }
+};
+
+
+/// Discrete cosine transform of type IV
+/*!
+\tparam N half of the transform length
+\tparam VType type of data element
+\tparam DList Typelist of the out-of-place complex DFT of the length N
+\tparam S sign of the transform: 1 - forward, -1 - backward
+
+The data array contains n = 2N real numbers. 
+The backward transform is scaled by 2/n, so that it is the exact inverse.
+\sa DCT4_core
+*/
+template<long_t N, typename VType, class DList, int S>
+class DCT4_impl
+{
+   typedef typename VType::ValueType T;
+   typedef typename VType::base_type BT;
+
+   DCT4_core<N,VType,DList> m_core;
+
+public:
+   DCT4_impl() : m_core((S==1) ? 1 : 1./N) { }
+
+   void apply(T* data)
+   {
+      m_core.apply(reinterpret_cast<const BT*>(data), reinterpret_cast<BT*>(data));
+   }
+
+   void apply(const T* src, T* dst)
+   {
+      m_core.apply(reinterpret_cast<const BT*>(src), reinterpret_cast<BT*>(dst));
+   }
+};
+
+
+/// Modified discrete cosine transform
+/*!
+\tparam N quarter of the input length
+\tparam VType type of data element
+\tparam DList Typelist of the out-of-place complex DFT of the length N
+
+Transforms 4N real numbers into M = 2N coefficients:
+\f$ X_k = \sum_{j=0}^{2M-1} x_j \cos(\pi (2j+1+M)(2k+1)/(4M)) \f$.
+The in-place transform writes the coefficients into the first half of the data.
+The input is folded into M real numbers, which are transformed by DCT4_core.
+The input may be multiplied by a window in the same pass (see MDCTOverlapAdd).
+*/
+template<long_t N, typename VType, class DList>
+class MDCT_impl
+{
+   typedef typename VType::ValueType T;
+   typedef typename VType::base_type BT;
+   static const long_t N2 = 2*N;
+   static const long_t N3 = 3*N;
+
+   DCT4_core<N,VType,DList> m_core;
+
+   static BT win(const BT* x, const BT* w, const long_t i) 
+   { 
+      return w ? w[i]*x[i] : x[i]; 
+   }
+
+   static void fold(const BT* x, BT* u, const BT* w)
+   {
+      for (long_t j = 0; j < N; ++j) {
+         u[j]   = -win(x,w,N3-1-j) - win(x,w,N3+j);
+         u[N+j] =  win(x,w,j) - win(x,w,N2-1-j);
+      }
+   }
+
+public:
+   void apply(T* data)
+   {
+      BT* buf = ThreadScratch<MDCT_impl,BT>::get(N2);
+      fold(reinterpret_cast<const BT*>(data), buf, 0);
+      m_core.apply(buf, reinterpret_cast<BT*>(data));
+   }
+
+   /// Out-of-place transform, the input is multiplied by the window of length 4N, if given
+   void apply(const T* src, T* dst, const BT* window = 0)
+   {
+      BT* u = reinterpret_cast<BT*>(dst);
+      fold(reinterpret_cast<const BT*>(src), u, window);
+      m_core.apply(u, u);
+   }
+};
+
+
+/// Inverse modified discrete cosine transform
+/*!
+\tparam N quarter of the output length
+\tparam VType type of data element
+\tparam DList Typelist of the out-of-place complex DFT of the length N
+
+Transforms M = 2N coefficients into 4N real numbers:
+\f$ y_j = \frac{1}{M}\sum_{k=0}^{M-1} X_k \cos(\pi (2j+1+M)(2k+1)/(4M)) \f$.
+The in-place transform requires the data array of 4N real numbers.
+The overlap-add of the consecutive outputs restores the input of MDCT_impl
+(time domain aliasing cancellation), see MDCTOverlapAdd.
+*/
+template<long_t N, typename VType, class DList>
+class IMDCT_impl
+{
+   typedef typename VType::ValueType T;
+   typedef typename VType::base_type BT;
+   static const long_t N2 = 2*N;
+   static const long_t N3 = 3*N;
+
+   DCT4_core<N,VType,DList> m_core;
+
+   // element i of the output from the result u of DCT-IV
+   static BT unfold(const BT* u, const long_t i)
+   {
+      if (i < N)  return u[N+i];
+      if (i < N3) return -u[N3-1-i];
+      return -u[i-N3];
+   }
+
+public:
+   IMDCT_impl() : m_core(1./N2) { }
+
+   void apply(T* data)
+   {
+      apply(data, data);
+   }
+
+   void apply(const T* src, T* dst)
+   {
+      BT* buf = ThreadScratch<IMDCT_impl,BT>::get(N2);
+      m_core.apply(reinterpret_cast<const BT*>(src), buf);
+      BT* y = reinterpret_cast<BT*>(dst);
+      for (long_t i = 0; i < 2*N2; ++i)
+        y[i] = unfold(buf, i);
+   }
+
+   /// Windowed overlap-add
+   /*! The first half of the windowed output is added to the array overlap
+       and written into dst (2N real numbers). The second half is stored into overlap.
+   */
+   void apply(const T* src, T* dst, const BT* window, BT* overlap)
+   {
+      BT* buf = ThreadScratch<IMDCT_impl,BT>::get(N2);
+      m_core.apply(reinterpret_cast<const BT*>(src), buf);
+      BT* y = reinterpret_cast<BT*>(dst);
+      for (long_t i = 0; i < N2; ++i) {
+        y[i] = overlap[i] + window[i]*unfold(buf, i);
+        overlap[i] = window[N2+i]*unfold(buf, N2+i);
+      }
+   }
+};
+
+}  //namespace GFFT
+
+#endif /*__gfftdct_h*/
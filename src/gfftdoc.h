@@ -79,6 +79,10 @@ amount of transforms you would like to compile within your code.
 To start using %GFFT please take a look into simple example programs (gfft*.cpp and cgfft*.cpp).
 The first one defines the data as a C-like array, where each even element represents the real and
 odd - the imaginary part of a complex number. The second one uses array of std::complex type.
+The value types SPLIT_DOUBLE and SPLIT_FLOAT take the complex data in split format:
+the array of N complex numbers contains N real parts followed by N imaginary parts.
+Only DFT and IDFT are defined for them. Batches of such transforms must have stride 1
+and the distance between the transforms at least N.
 
 Since all the parameters of %GFFT are static constants and defined as template parameters,
 you have to deside before compilation, which kind of transforms of which length you might need
@@ -98,6 +102,63 @@ TransformSet gfft;
 TransformSet::ObjectType* fftobj = gfft.CreateTransformObject(10, DOUBLE::ID, DFT::ID, 1, Serial::ID, OUT_OF_PLACE::ID);
 \endcode
 
+Many transforms of the same length can be computed within one call of fft_many().
+It takes the number of transforms, the distance between two elements of a transform (stride)
+and the distance between the first elements of two consequent transforms (dist), 
+both in complex numbers. If a single transform is too short to be parallelized,
+the whole batch is distributed between the OpenMP threads:
+\code
+// 100 transforms of length 1024 stored one after another
+fftobj->fft_many(src, dst, 100, 1, 1024);
+// 1024 interleaved transforms: element j of transform b is at position b + j*1024
+fftobj->fft_many(src, dst, 1024, 1024, 1);
+\endcode
+
 If you need only single transform type of fixed length, then you can use directly template class 
 GFFT::Transform without object factory.
+Its template parameter Decimation chooses the algorithm. The default INTIME is the mixed-radix
+decimation in time. SPLITRADIX selects the split-radix algorithm for the serial transforms
+of the length of power of two. INFREQ selects the decimation in frequency, which runs the butterflies
+before the twiddle factors and reorders the result at the end, so the algorithms can be compared for every length:
+\code
+typedef Transform<SIntID<4096>, DOUBLE, DFT, SIntID<1>, Serial, OUT_OF_PLACE, SPLITRADIX> SRTransform;
+SRTransform::Instance sr;
+sr.fft(src, dst);
+\endcode
+SCRAMBLED skips the reordering of the in-place transforms: the forward DFT returns
+the spectrum in digit-reversed order, and the inverse DFT expects it in this order.
+This is sufficient for the convolution, where the spectra are only multiplied pointwise.
+STOCKHAM selects the Stockham autosort algorithm for the out-of-place transforms.
+It reads and writes the data contiguously, alternating between the output and a scratch buffer,
+and is chosen for INTIME as well, where it is faster (see PreferStockham).
+The class Stockham accepts the scratch buffer of the caller as the third argument of apply().
+PRIMEFACTOR selects the Good-Thomas algorithm for the lengths with coprime factors like 1200 = 16*3*25,
+which maps the DFT onto a multidimensional one without twiddle factors. The in-place
+transforms of such lengths are always computed by it, the out-of-place ones on request only,
+because the vectorized Stockham steps are faster for them.
+The decimation is the last template parameter of GenerateTransform as well
+and the last argument of CreateTransformObject (INTIME by default).
+
+The parallelization policy OpenMP<NT> opens a new %OpenMP parallel region for every parallel step.
+ThreadPool<NT> runs the same steps on a persistent pool of NT-1 spinning worker threads and
+the calling thread, which is cheaper for the transforms of the lengths from 1K to 64K:
+\code
+typedef Transform<SIntID<8192>, DOUBLE, DFT, SIntID<1>, ThreadPool<4>, OUT_OF_PLACE> PoolTransform;
+PoolTransform::Instance pt;
+pt.fft(src, dst);
+\endcode
+The number of threads of OpenMPRuntime<NTMax> is not a template parameter. 
+The transform is split into NTMax blocks at compile-time, which are distributed among
+the threads at run-time. Their number is taken from RuntimeThreads, when the object is created:
+omp_get_max_threads() limited by the CPU quota of the container, unless set explicitly:
+\code
+RuntimeThreads::set(6);
+Transform<SIntID<8192>, DOUBLE, DFT, SIntID<1>, OpenMPRuntime<>, OUT_OF_PLACE>::Instance rt;
+\endcode
+OpenMPTasks<NT> does not reserve a factor of the length for the threads. Every step of the
+decimation in time spawns its sub-transforms as %OpenMP tasks, which the NT threads
+take from each other, so the lengths like \f$ 3^{10} \f$ run in parallel on any number of threads:
+\code
+typedef Transform<SIntID<59049>, DOUBLE, DFT, SIntID<1>, OpenMPTasks<6>, IN_PLACE> TaskTransform;
+\endcode
 */
@@ -169,6 +169,44 @@ struct Factorize<PowerHolder<M,P> >
 };
 
 
+/// Groups the factor 2^P of the factorization into higher radices
+/*!
+\tparam NFact factorization list
+
+The power of two is replaced by 2^(P mod 4) followed by 16^(P/4),
+so that the codelets of the length 4, 8 and 16 (see ShortDFTPow2) 
+are used instead of the chain of radix-2 stages.
+This reduces the number of passes over the data about four times.
+The digit-reversal permutation of the in-place transforms expects the prime factors,
+therefore the grouping is applied to the out-of-place transforms only.
+*/
+template<typename NFact>
+struct GroupRadix;
+
+template<ulong_t P, typename Tail>
+struct GroupRadix<Loki::Typelist<pair_<ulong_<2>, ulong_<P> >, Tail> >
+{
+    static const ulong_t P16 = P/4;
+    static const ulong_t R = P%4;
+    typedef typename Loki::Select<(P16 > 0),
+       Loki::Typelist<pair_<ulong_<16>, ulong_<P16> >, Tail>, Tail>::Result List16;
+    typedef typename Loki::Select<(R > 0),
+       Loki::Typelist<pair_<ulong_<(1<<R)>, ulong_<1> >, List16>, List16>::Result Result;
+};
+
+template<typename Head, typename Tail>
+struct GroupRadix<Loki::Typelist<Head,Tail> >
+{
+    typedef Loki::Typelist<Head, typename GroupRadix<Tail>::Result> Result;
+};
+
+template<>
+struct GroupRadix<Loki::NullType>
+{
+    typedef Loki::NullType Result;
+};
+
+
 template<long_t N, typename FactorList, long_t Accum = 1, bool C = (N > Accum)>
 struct ExtractFactor;
 
@@ -23,6 +23,8 @@
 #include "sint.h"
 #include "typelistgen.h"
 #include "gfftparamgroups.h"
+#include "gfftruntime.h"
+#include "gfftmultidim.h"
 
 #include "Singleton.h"
 
@@ -36,9 +38,12 @@ namespace GFFT {
 \tparam VType type of data element
 \tparam Type type of transform: DFT, IDFT, RDFT, IRDFT
 \tparam Dim dimension of transform, defined as SIntID<N>, N=1,2,...
+        The multidimensional transform has the size N x ... x N (see MultiDim)
 \tparam Parall parallelization
-\tparam Decimation in-time or in-frequency: INTIME, INFREQ
-\tparam FactoryPolicy policy used to create an object factory. Don't define it explicitely, if unsure
+\tparam Place IN_PLACE or OUT_OF_PLACE
+\tparam Decimation algorithm: INTIME (default), SPLITRADIX, INFREQ, SCRAMBLED, STOCKHAM
+        or PRIMEFACTOR
+\tparam IDN unique id of the transform in the object factory
 
 Use this class only, if you need transform of a single fixed type and length.
 Otherwise, rely on template class GenerateTransform
@@ -49,29 +54,40 @@ class Type,                    // DFT, IDFT, RDFT, IRDFT
 class Dim,
 class Parall,
 class Place,              // IN_PLACE, OUT_OF_PLACE
+class Decimation = INTIME,
 id_t IDN = N::ID>
 class Transform 
 {
    typedef typename VType::ValueType T;
+
+   // the other transform types need the complex DFT in natural order
+   static const bool isComplexDFT = (Type::ID == DFT::ID || Type::ID == IDFT::ID);
+   static_assert(!IsSplitComplex<VType>::value || (isComplexDFT && Dim::value == 1),
+                 "The split-complex value types support one-dimensional DFT and IDFT only");
+   typedef typename Loki::Select<(Decimation::ID == SCRAMBLED::ID && !isComplexDFT),
+                                 INTIME, Decimation>::Result ActualDecimation;
+   typedef DecimationPlace<Place,ActualDecimation> DPlace;
    
    typedef typename Parall::template Factor<N>::Result NFactor;
-   //static const long_t NR = PrecomputeRoots;
-   //typedef ExtractFactor<NR, NFactor> EF;
-   //static const long_t NN = N::value/NFactor::Head::first::value;
-   //typedef Loki::Typelist<Pair<typename NFactor::Head::first, long_<NFactor::Head::second::value-1> >, typename NFactor::Tail> NFactNext;
+   typedef typename DimAlgorithm<N::value,Dim::value,NFactor,VType,Type,Parall,DPlace>::Result Alg;
    
-   //typedef Loki::SingletonHolder<RootsHolder<NR,typename EF::Result,VType,Type::Sign> > Twiddles;
+   // batches of transforms, which are not parallelized themselves, run in parallel
+   typedef typename Parall::template ActualParall<N::value>::Result ActualParall;
+   static const ulong_t NBatchThreads = (ActualParall::NParProc > 1 || Dim::value > 1) 
+                                      ? 1 : Parall::NParProc;
 
-   typedef typename Type::template Algorithm<N::value,NFactor,VType,Parall,Place>::Result Alg;
-   
    typedef typename Place::template Interface<typename VType::ValueType>::Result ReturnType;
-   typedef typename Place::template Function<Caller<Loki::Typelist<Parall,Alg> >, T> ExecType;
+   typedef TransformLength<Type,DimLength<N::value,Dim::value>::value> Length;
+   typedef typename Place::template Function<Caller<Loki::Typelist<Parall,Alg> >, T,
+                                             Length::In, Length::Out, NBatchThreads> ExecType;
    
 public:
    typedef VType ValueType;
    typedef Type TransformType;
    typedef Parall ParallType;
    typedef Place PlaceType;
+   typedef Dim DimType;
+   typedef Decimation DecimationType;
 
    typedef ExecType Instance;
 
@@ -101,33 +117,123 @@ struct DefineTransform {
    typedef typename TList::Tail::Head VType;
    typedef typename TList::Tail::Tail::Head TransformType;
    typedef typename TList::Tail::Tail::Tail::Tail::Tail::Head Place;
+   typedef typename TList::Tail::Tail::Tail::Tail::Tail::Tail::Head Decimation;
 //    typedef typename Place::template Interface<typename VType::ValueType>::Result Abstract;
    
    typedef Transform<typename TList::Head, VType, TransformType,
                 typename TList::Tail::Tail::Tail::Head,
                 typename TList::Tail::Tail::Tail::Tail::Head,
-                Place,ID> Result;
+                Place,Decimation,ID> Result;
 };
 
 
 
-template<class NList>
+/// Position of the parameter with the given ID in the entry of GenerateTransform
+/**
+\tparam TList a single parameter or Typelist of the parameters, see getID
+
+The ID not found in the entry gives its length.
+*/
+template<class TList>
+struct EntryIndex {
+   static ulong_t apply(ulong_t) {
+      return 0;
+   }
+};
+
+template<class H, class Tail>
+struct EntryIndex<Loki::Typelist<H,Tail> > {
+   static ulong_t apply(ulong_t id) {
+      return (id == getID<H>::ID) ? 0 : 1 + EntryIndex<Tail>::apply(id);
+   }
+};
+
+template<>
+struct EntryIndex<Loki::NullType> {
+   static ulong_t apply(ulong_t) {
+      return 0;
+   }
+};
+
+/// Computes at run-time the ID of the transform generated by ListGenerator
+/**
+\tparam TList Typelist of the entries of GenerateTransform in the order of the arguments
+
+The digits are the positions of the parameters in their entries (see EntryIndex),
+so the IDs of the parameters may be arbitrary large, e.g. ThreadPool<NT>.
+*/
+template<class TList>
 struct TranslateID;
 
-template<ulong_t N, class T>
-struct TranslateID<Loki::Typelist<ulong_<N>,T> > {
+template<class H, class T>
+struct TranslateID<Loki::Typelist<H,T> > {
    static ulong_t apply(const ulong_t* n) {
-      return TranslateID<T>::apply(n+1)*N + *n;
+      return TranslateID<T>::apply(n+1)*EntryLength<H>::value + EntryIndex<H>::apply(*n);
    }
 };
 
-template<ulong_t N>
-struct TranslateID<Loki::Typelist<ulong_<N>,Loki::NullType> > {
-   static ulong_t apply(const ulong_t* n) {
-      return *n;
+template<>
+struct TranslateID<Loki::NullType> {
+   static ulong_t apply(const ulong_t*) {
+      return 0;
    }
 };
 
+/// Checks at compile-time, whether the IDs of the types in TList are different (see getID)
+/**
+\tparam TList a single type or Typelist
+*/
+template<class TList>
+struct UniqueIDs {
+   static const bool value = true;
+};
+
+template<class H, class Tail>
+struct UniqueIDs<Loki::Typelist<H,Tail> > {
+   template<class TList, id_t ID>
+   struct Contains {
+      static const bool value = false;
+   };
+   template<class H1, class Tail1, id_t ID>
+   struct Contains<Loki::Typelist<H1,Tail1>,ID> {
+      static const bool value = (getID<H1>::ID == ID) || Contains<Tail1,ID>::value;
+   };
+
+   static const bool value = !Contains<Tail,getID<H>::ID>::value && UniqueIDs<Tail>::value;
+};
+
+
+/// Checks at run-time, whether the transform is in the generated Typelist
+/**
+\tparam TList Typelist of Transform classes generated by GenerateTransform
+
+The unique ID of the object factory is not sufficient for this check,
+since lengths out of NList may produce the ID of another transform.
+*/
+template<class TList>
+struct FindTransform;
+
+template<class H, class Tail>
+struct FindTransform<Loki::Typelist<H,Tail> > {
+   static bool apply(ulong_t n, ulong_t vtype_id, ulong_t trans_id,
+                     ulong_t dim, ulong_t parall_id, ulong_t place_id, ulong_t decimation_id) {
+      return (n == static_cast<ulong_t>(H::Len)
+           && vtype_id == H::ValueType::ID
+           && trans_id == H::TransformType::ID
+           && dim == static_cast<ulong_t>(H::DimType::value)
+           && parall_id == H::ParallType::ID
+           && place_id == H::PlaceType::ID
+           && decimation_id == H::DecimationType::ID)
+           || FindTransform<Tail>::apply(n, vtype_id, trans_id, dim, parall_id, place_id, decimation_id);
+   }
+};
+
+template<>
+struct FindTransform<Loki::NullType> {
+   static bool apply(ulong_t, ulong_t, ulong_t, ulong_t, ulong_t, ulong_t, ulong_t) {
+      return false;
+   }
+};
 
 
 template <typename IdentifierType, class AbstractProduct>
@@ -150,13 +256,17 @@ struct TransformFactoryError
 \tparam NList Typelist containing transform lengths
 \tparam T type of data element
 \tparam TransType type of transform: DFT, IDFT, RDFT, IRDFT
-\tparam Dim dimension of transform, defined as SIntID<N>, N=1,2,...
-        By now, only one-dimensional transforms are implemented.
+\tparam Dim dimension of transform, defined as SIntID<N>, N=1,2,3
+        The multidimensional transforms are generated at compile-time only.
 \tparam Parall parallelization method
-\tparam Decimation in-time or in-frequency: INTIME, INFREQ
+\tparam Place IN_PLACE or OUT_OF_PLACE
+\tparam Decimation algorithm: INTIME, SPLITRADIX, INFREQ, SCRAMBLED, STOCKHAM or PRIMEFACTOR
 \tparam FactoryPolicy policy used to create an object factory. Don't define it explicitely, if unsure
 
 This generator class makes possible to generate a set of necessary transforms.
+A transform, which was not generated, is planned at run-time by CreateTransformObject
+(see RuntimeTransform), as long as its value type and place are the generated ones.
+The run-time plan has its own algorithm, so the decimation is ignored then.
 The first three template parameters: minimum and maximum power of two and value type
 must be defined. Further parameters have default values and may be omitted.
 Default values for template parameters are taken from the corresponding group-classes
@@ -191,25 +301,32 @@ class T         /* = ValueTypeList*/,        // has to be set explicitely becaus
 class TransType  = TransformTypeGroup::Default,     // DFT, IDFT, RDFT, IRDFT
 class Dim        = ulong_<1>,
 class Parall     = ParallelizationGroup::Default,
-class Place      = PlaceGroup::Default>             // IN_PLACE, OUT_OF_PLACE
+class Place      = PlaceGroup::Default,             // IN_PLACE, OUT_OF_PLACE
+class Decimation = DecimationGroup::Default>        // INTIME, SPLITRADIX, INFREQ, SCRAMBLED, STOCKHAM, PRIMEFACTOR
 class GenerateTransform {
    //typedef typename GenNumList<Begin,End>::Result NList;
-   static const ulong_t L1 = Loki::TL::Length<NList>::value;
-   static const ulong_t L2 = Loki::TL::Length<ValueTypeGroup::FullList>::value;
-   static const ulong_t L3 = Loki::TL::Length<TransformTypeGroup::FullList>::value;
-   static const ulong_t L4 = 1;
-   static const ulong_t L5 = Loki::TL::Length<ParallelizationGroup::FullList>::value;
-   static const ulong_t L6 = Loki::TL::Length<PlaceGroup::FullList>::value;
-   typedef TYPELIST_6(ulong_<L1>,ulong_<L2>,ulong_<L3>,ulong_<L4>,ulong_<L5>,ulong_<L6>) LenList;
+   typedef TYPELIST_7(NList,T,TransType,Dim,Parall,Place,Decimation) ParamList;
+   typedef TYPELIST_7(ulong_<EntryLength<NList>::value>,ulong_<EntryLength<T>::value>,
+                      ulong_<EntryLength<TransType>::value>,ulong_<EntryLength<Dim>::value>,
+                      ulong_<EntryLength<Parall>::value>,ulong_<EntryLength<Place>::value>,
+                      ulong_<EntryLength<Decimation>::value>) LenList;
 
    typedef typename Loki::TL::Reverse<LenList>::Result RevLenList;
 
-   typedef TYPELIST_6(Place,Parall,Dim,TransType,T,NList) RevList;
+   typedef TYPELIST_7(Decimation,Place,Parall,Dim,TransType,T,NList) RevList;
+
+   typedef TranslateID<ParamList> Translate;
 
-   typedef TranslateID<LenList> Translate;
+   // the object factory finds the position of a parameter by its ID
+   static_assert(UniqueIDs<NList>::value && UniqueIDs<T>::value && UniqueIDs<TransType>::value
+              && UniqueIDs<Dim>::value && UniqueIDs<Parall>::value && UniqueIDs<Place>::value
+              && UniqueIDs<Decimation>::value, 
+                 "The parameters of GenerateTransform must have different IDs");
 
 public:
    typedef typename ListGenerator<RevList,RevLenList,DefineTransform>::Result Result;
+
+   static_assert(UniqueIDs<Result>::value, "The generated transforms must have unique IDs");
    typedef typename Place::template Interface<typename T::ValueType>::Result ObjectType;
    typedef Place PlaceType;
 
@@ -219,14 +336,27 @@ public:
       FactoryInit<Result>::apply(factory);
    }
 
+   /// Creates the transform object
+   /** If the transform was not generated, the compile-time specialization
+       is replaced by the transform of the same type planned at run-time.
+       The exception TransformFactoryError::Exception is thrown only,
+       if the transform can not be planned at run-time either.
+    */
    ObjectType* CreateTransformObject(ulong_t n, ulong_t vtype_id,
                                      ulong_t trans_id = TransformTypeGroup::Default::ID,
                                      ulong_t dim = 1,
                                      ulong_t parall_id = ParallelizationGroup::Default::ID,
-                                     ulong_t place_id = PlaceGroup::Default::ID)
+                                     ulong_t place_id = PlaceGroup::Default::ID,
+                                     ulong_t decimation_id = DecimationGroup::Default::ID)
    {
-      ulong_t narr[] = {n-1, vtype_id, trans_id, dim-1, parall_id, place_id};
+      ulong_t narr[] = {n-1, vtype_id, trans_id, dim-1, parall_id, place_id, decimation_id};
       ulong_t obj_id = Translate::apply(narr);
+      if (!FindTransform<Result>::apply(n, vtype_id, trans_id, dim, parall_id, place_id, decimation_id)) {
+         if (n > 0 && dim == 1 && vtype_id == T::ID && place_id == Place::ID
+             && RuntimePlan<T>::supports(trans_id))
+            return new RuntimeTransform<T,Place>(n, trans_id, ParallThreads(parall_id));
+         return TransformFactoryError<ulong_t,ObjectType>::OnUnknownType(obj_id);
+      }
       return factory.CreateObject(obj_id);
    }
 
@@ -0,0 +1,105 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Vladimir Mirnyy                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ ***************************************************************************/
+
+#ifndef __gfftmdct_h
+#define __gfftmdct_h
+
+/** \file
+    \brief Windowed MDCT of consecutive frames with overlap-add
+*/
+
+#include <vector>
+#include <cmath>
+
+#include "gfftpolicy.h"
+#include "gfftdct.h"
+
+namespace GFFT {
+
+/// Windowed MDCT analysis and synthesis of consecutive frames
+/*!
+\tparam N quarter of the frame length
+\tparam VType type of data element
+\tparam Parall parallelization of the underlying complex DFT
+
+The frames of 4N real numbers overlap by half, so the next frame begins 2N numbers later.
+Both analysis and synthesis use the sine window
+\f$ w_j = \sin(\pi(j+1/2)/(4N)) \f$, which satisfies the Princen-Bradley condition.
+The window is multiplied by \f$ \sqrt 2 \f$, since IMDCT_impl is normalized for the 
+unwindowed frames.
+The window is applied, while the input is folded (analysis) or unfolded (synthesis),
+so the frames are processed back-to-back without intermediate arrays.
+The synthesis returns 2N numbers for every frame: the sum of the first half of
+the current frame with the second half of the previous one, which is kept in this object.
+The output for the very first frame is incomplete, since there is no previous frame.
+\code
+MDCTOverlapAdd<256, DOUBLE> tdac;
+for (long_t f = 0; f < nframes; ++f) {
+   tdac.analysis(signal + f*512, coef);
+   // process 512 coefficients
+   tdac.synthesis(coef, output + f*512);
+}
+\endcode
+*/
+template<long_t N, typename VType, class Parall = Serial>
+class MDCTOverlapAdd
+{
+   typedef typename VType::ValueType T;
+   typedef typename VType::base_type BT;
+   static const long_t N2 = 2*N;
+
+   typedef typename Parall::template Factor<ulong_<N> >::Result NFact;
+   typedef typename DFT::template Algorithm<N,NFact,VType,Parall,OUT_OF_PLACE>::Result DList;
+
+   // sine window, shared by all the instances
+   struct Window {
+      std::vector<BT> w;
+      Window() : w(2*N2)
+      {
+         for (long_t j = 0; j < 2*N2; ++j)
+           w[j] = static_cast<BT>(std::sqrt(2.L)*std::sin(M_PIl*(j+0.5L)/(2*N2)));
+      }
+   };
+
+   MDCT_impl<N,VType,DList> m_mdct;
+   IMDCT_impl<N,VType,DList> m_imdct;
+   const BT* m_window;
+   std::vector<BT> m_overlap;
+
+public:
+   MDCTOverlapAdd() : m_window(&SharedTable<Window>::Instance().w[0]), m_overlap(N2) { }
+
+   /// Computes 2N coefficients from the frame of 4N real numbers
+   void analysis(const T* frame, T* coef)
+   {
+      m_mdct.apply(frame, coef, m_window);
+   }
+
+   /// Adds the frame restored from 2N coefficients and returns 2N real numbers
+   void synthesis(const T* coef, T* out)
+   {
+      m_imdct.apply(coef, out, m_window, &m_overlap[0]);
+   }
+
+   /// Clears the stored second half of the previous frame
+   void reset()
+   {
+      for (long_t i = 0; i < N2; ++i)
+        m_overlap[i] = 0;
+   }
+};
+
+}  //namespace GFFT
+
+#endif /*__gfftmdct_h*/
@@ -0,0 +1,229 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Vladimir Mirnyy                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ ***************************************************************************/
+
+#ifndef __gfftmultidim_h
+#define __gfftmultidim_h
+
+/** \file
+    \brief Multidimensional transforms
+*/
+
+#include <vector>
+
+#include "gfftpolicy.h"
+#include "gfftcaller.h"
+
+namespace GFFT {
+
+/// Total number of complex elements N^Dim in the multidimensional transform
+template<long_t N, long_t Dim>
+struct DimLength {
+   static const long_t value = N*DimLength<N,Dim-1>::value;
+};
+
+template<long_t N>
+struct DimLength<N,1> {
+   static const long_t value = N;
+};
+
+
+/// Multidimensional transform of the size N x N x ... x N (Dim times)
+/*!
+\tparam N length of the transform along each dimension
+\tparam Dim number of dimensions
+\tparam VType type of data element
+\tparam Type type of transform: DFT, IDFT, RDFT, IRDFT
+\tparam Parall parallelization
+\tparam Place IN_PLACE or OUT_OF_PLACE
+
+The data are stored in row-major order, the first dimension (row) is contiguous.
+The one-dimensional transform of the given Type is applied to every row.
+The complex-valued DFT (IDFT for backward transforms) is applied along the
+other dimensions with the same Place and decimation as the rows.
+
+The real-valued transforms (RDFT, IRDFT) take rows of 2N real numbers.
+Their output is not the usual half-spectrum of N+1 columns, which would not fit
+into the data array. The columns k=1,...,N-1 hold the spectrum \f$ Y_{q,k} \f$, 
+where q is the multi-index of the other dimensions. The column zero holds the packed
+pairs \f$ (X_0, X_N) \f$ of the rows (see Separate) transformed like the other columns,
+i.e. \f$ Z_q = Y_{q,0} + iY_{q,N} \f$. Since \f$ Y_{q,0} \f$ and \f$ Y_{q,N} \f$ 
+are spectra of real sequences, they are unpacked as 
+\f$ Y_{q,0} = (Z_q + \bar Z_{-q})/2 \f$ and \f$ Y_{q,N} = (Z_q - \bar Z_{-q})/(2i) \f$,
+where -q is taken modulo N in every dimension. The backward transform IRDFT
+expects the same packed layout.
+
+The columns are gathered in blocks of ColumnBlock neighbouring columns into a work array,
+so that each row is read in contiguous pieces. The rows and the blocks of columns
+are distributed between Parall::NParProc threads (RuntimeThreads::get(),
+if it is zero). The one-dimensional transforms themselves are serial.
+*/
+template<long_t N, long_t Dim, typename VType, class Type,
+         class Parall, class Place>
+class MultiDim
+{
+   typedef typename VType::ValueType T;
+   static const int C = Loki::TypeTraits<T>::isStdFundamental ? 2 : 1;
+   static const int NT = Parall::NParProc;
+   static const long_t NRows = DimLength<N,Dim-1>::value;
+   static const long_t ColumnBlock = 16;
+
+   static_assert(Type::ID == DFT::ID || Type::ID == IDFT::ID 
+              || Type::ID == RDFT::ID || Type::ID == IRDFT::ID,
+                 "MultiDim supports the types DFT, IDFT, RDFT and IRDFT only");
+
+   static const bool isInPlace = (Place::ID == IN_PLACE::ID);
+
+   typedef typename Loki::Select<(Type::Sign==1),DFT,IDFT>::Result ColType;
+   typedef typename Factorize<ulong_<N> >::Result NFact;
+
+   typedef typename Type::template Algorithm<N,NFact,VType,Serial,Place>::Result RowList;
+   typedef typename ColType::template Algorithm<N,NFact,VType,Serial,Place>::Result ColList;
+
+   Caller<RowList> m_row;
+   Caller<ColList> m_col;
+   const int m_nt;
+
+   // in-place row transforms
+   void rows(T* data)
+   {
+      #pragma omp parallel for schedule(static) num_threads(m_nt) if(m_nt > 1)
+      for (long_t r = 0; r < NRows; ++r)
+        m_row.apply(data + r*N*C);
+   }
+
+   // out-of-place row transforms
+   void rows(const T* src, T* dst)
+   {
+      #pragma omp parallel for schedule(static) num_threads(m_nt) if(m_nt > 1)
+      for (long_t r = 0; r < NRows; ++r)
+        m_row.apply(src + r*N*C, dst + r*N*C);
+   }
+
+   // out-of-place row transforms within the array dst
+   void rows_inp(T* dst)
+   {
+      #pragma omp parallel num_threads(m_nt) if(m_nt > 1)
+      {
+        T* buf = ThreadScratch<MultiDim,T,2>::get(N*C);
+        #pragma omp for schedule(static)
+        for (long_t r = 0; r < NRows; ++r) {
+          T* p = dst + r*N*C;
+          for (long_t i = 0; i < N*C; ++i)
+            buf[i] = p[i];
+          m_row.apply(buf, p);
+        }
+      }
+   }
+
+   // column transform of the given Place, the result is in src or dst
+   void column(T* src, T*, Loki::Int2Type<true>) { m_col.apply(src); }
+   void column(T* src, T* dst, Loki::Int2Type<false>) { m_col.apply(src, dst); }
+
+   // transforms along the dimension with the given stride (in complex elements);
+   // src and dst may coincide
+   void columns(const T* src, T* dst, const long_t stride)
+   {
+      const long_t nblocks = (stride + ColumnBlock - 1)/ColumnBlock;
+      const long_t nouter = NRows/stride;
+
+      #pragma omp parallel num_threads(m_nt) if(m_nt > 1)
+      {
+        T* bufin = ThreadScratch<MultiDim,T>::get(ColumnBlock*N*C);
+        T* bufout = isInPlace ? bufin : ThreadScratch<MultiDim,T,1>::get(ColumnBlock*N*C);
+        #pragma omp for schedule(static)
+        for (long_t ib = 0; ib < nouter*nblocks; ++ib) {
+          const long_t o = ib/nblocks;
+          const long_t i0 = (ib%nblocks)*ColumnBlock;
+          const long_t nb = (i0 + ColumnBlock > stride) ? stride - i0 : ColumnBlock;
+          const long_t base = (o*stride*N + i0)*C;
+
+          for (long_t j = 0; j < N; ++j) {
+            const T* s = src + base + j*stride*C;
+            for (long_t b = 0; b < nb; ++b)
+              for (int c = 0; c < C; ++c)
+                bufin[(b*N + j)*C + c] = s[b*C + c];
+          }
+
+          for (long_t b = 0; b < nb; ++b)
+            column(&bufin[b*N*C], &bufout[b*N*C], Loki::Int2Type<isInPlace>());
+          const T* res = isInPlace ? bufin : bufout;
+
+          for (long_t j = 0; j < N; ++j) {
+            T* d = dst + base + j*stride*C;
+            for (long_t b = 0; b < nb; ++b)
+              for (int c = 0; c < C; ++c)
+                d[b*C + c] = res[(b*N + j)*C + c];
+          }
+        }
+      }
+   }
+
+public:
+   MultiDim() : m_nt(RuntimeThreads::count(NT)) { }
+
+   void apply(T* data)
+   {
+      if (Type::Sign == 1) {
+        rows(data);
+        for (long_t s = N; s < NRows*N; s *= N)
+          columns(data, data, s);
+      }
+      else {
+        for (long_t s = NRows; s >= N; s /= N)
+          columns(data, data, s);
+        rows(data);
+      }
+   }
+
+   void apply(const T* src, T* dst)
+   {
+      if (Type::Sign == 1) {
+        rows(src, dst);
+        for (long_t s = N; s < NRows*N; s *= N)
+          columns(dst, dst, s);
+      }
+      else {
+        columns(src, dst, NRows);
+        for (long_t s = NRows/N; s >= N; s /= N)
+          columns(dst, dst, s);
+        rows_inp(dst);
+      }
+   }
+};
+
+
+/// Selects the algorithm of one- or multidimensional transform
+/*!
+\tparam N length of the transform along each dimension
+\tparam Dim number of dimensions
+\tparam NFact factorization of N for the one-dimensional transform
+
+Returns the Typelist of the one-dimensional transform, if Dim is one,
+and MultiDim otherwise.
+*/
+template<long_t N, long_t Dim, typename NFact, typename VType, class Type,
+         class Parall, class Place>
+struct DimAlgorithm {
+   typedef Loki::Typelist<MultiDim<N,Dim,VType,Type,Parall,Place>,Loki::NullType> Result;
+};
+
+template<long_t N, typename NFact, typename VType, class Type,
+         class Parall, class Place>
+struct DimAlgorithm<N,1,NFact,VType,Type,Parall,Place> {
+   typedef typename Type::template Algorithm<N,NFact,VType,Parall,Place>::Result Result;
+};
+
+}  //namespace GFFT
+
+#endif /*__gfftmultidim_h*/
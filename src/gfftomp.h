@@ -23,8 +23,15 @@
 #include "gfftstdalg.h"
 #include "gfftalgfreq.h"
 #include "gfftswap.h"
+#include "gfftprime.h"
 
 #include <omp.h>
+#include <vector>
+#include <complex>
+#include <fstream>
+#include <string>
+#include <cstdlib>
+#include <algorithm>
 
 namespace GFFT {
 
@@ -37,51 +44,163 @@ too large for transforms with smaller sizes.
 
 
 
-// Assume: K >= NThreads
-template<long_t M2, long_t NThreads, int K, int I = 0, bool C = (K>NThreads)>
-struct ParallLoop;
+/// Number of threads chosen at run-time
+/*!
+The default is the smaller of omp_get_max_threads() and the CPU quota of the cgroup
+(cpu.max of cgroup v2 or cpu.cfs_quota_us / cpu.cfs_period_us of cgroup v1) rounded up,
+so that a container limited to a few cores does not oversubscribe them.
+The transform objects take the number, when they are constructed,
+so set() affects the objects created afterwards.
+\sa OpenMPRuntime
+*/
+class RuntimeThreads
+{
+  static int cgroupQuota()
+  {
+      long quota = -1, period = 0;
+      std::ifstream v2("/sys/fs/cgroup/cpu.max");
+      if (v2) {
+        std::string q;
+        if (v2 >> q >> period && q != "max")
+          quota = std::atol(q.c_str());
+      }
+      else {
+        std::ifstream q1("/sys/fs/cgroup/cpu/cpu.cfs_quota_us");
+        std::ifstream p1("/sys/fs/cgroup/cpu/cpu.cfs_period_us");
+        if (!(q1 >> quota) || !(p1 >> period))
+          quota = -1;
+      }
+      if (quota <= 0 || period <= 0)
+        return 0;
+      return static_cast<int>((quota + period - 1)/period);
+  }
+
+  static int detect()
+  {
+      const int nt = omp_get_max_threads();
+      const int quota = cgroupQuota();
+      return std::max(1, (quota > 0) ? std::min(nt, quota) : nt);
+  }
+
+  static int& value()
+  {
+      static int n = detect();
+      return n;
+  }
+
+public:
+  /// Current number of threads
+  static int get() { return value(); }
+
+  /// Sets the number of threads, n <= 0 restores the default
+  static void set(const int n) { value() = (n > 0) ? n : detect(); }
+
+  /// n, if it is positive, otherwise the current number
+  static int count(const long_t n) { return (n > 0) ? static_cast<int>(n) : get(); }
+};
+
 
-template<long_t M2, long_t NThreads, int K, int I>
-struct ParallLoop<M2,NThreads,K,I,true>
+/// Team of %OpenMP threads
+/*! Every call of run() opens a new parallel region.
+    \sa PoolTeam, SerialTeam, RuntimeOMPTeam
+*/
+struct OMPTeam
 {
-  static const long_t NThreadsAlreadyCreated = I*NThreads;
-  
-  ParallLoop<M2,NThreads,K-NThreads,I+1> NextStep;
-  
-  template<class DftStr, class T>
-  void apply(DftStr& dft_str, T* data)
+  /// Number of threads of the loop, which is designed for nthreads threads
+  static int threads(const int nthreads) { return nthreads; }
+
+  /// Calls f(tid, nt) in every thread of the region of nthreads threads
+  template<class F>
+  static void run(const int nthreads, F& f)
   {
-      #pragma omp parallel num_threads(NThreads)
-      {
-	int tid = omp_get_thread_num() + NThreadsAlreadyCreated;
-	dft_str.apply(data + tid*M2);
-	//#pragma omp barrier
+      #pragma omp parallel num_threads(nthreads) if(nthreads > 1)
+      f(omp_get_thread_num(), omp_get_num_threads());
+  }
+};
+
+/// Team of %OpenMP threads, which number is limited by RuntimeThreads
+struct RuntimeOMPTeam : public OMPTeam
+{
+  static int threads(const int nthreads) { return std::min(nthreads, RuntimeThreads::get()); }
+};
+
+/// Team of the single calling thread
+struct SerialTeam
+{
+  static int threads(const int) { return 1; }
+
+  template<class F>
+  static void run(const int, F& f)
+  {
+      f(0, 1);
+  }
+};
+
+/// Length of the shortest sub-transform, that is spawned as a separate %OpenMP task
+/*! The shorter ones are computed serially by the task of the enclosing step. */
+static const long_t TaskCutoff = (1<<11);
+
+/// Team of %OpenMP tasks for the parallelization policy OpenMPTasks
+/*! Inside of a parallel region run() spawns nthreads tasks and waits for them,
+    so the chunks of a loop are taken by the idle threads of the region.
+    Outside of a region it opens a new one like OMPTeam.
+    The decimation in time is specialized for this team (see InTimeTask).
+    \sa OMPTeam
+*/
+struct OMPTaskTeam : public OMPTeam
+{
+  template<class F>
+  static void run(const int nthreads, F& f)
+  {
+      if (!omp_in_parallel()) {
+        OMPTeam::run(nthreads, f);
+        return;
       }
-      
-      NextStep.apply(dft_str, data);
+      for (int tid = 0; tid < nthreads; ++tid) {
+        #pragma omp task firstprivate(tid) shared(f)
+        f(tid, nthreads);
+      }
+      #pragma omp taskwait
   }
 };
 
-template<long_t M2, long_t NThreads, int K, int I>
-struct ParallLoop<M2,NThreads,K,I,false>
+
+/// K transforms of the blocks of the length M2 distributed among NThreads threads of Team
+/*! The block i is transformed by the thread i mod nt, where nt is the actual 
+    number of threads. The threads are synchronized once at the end of the loop.
+    The number of threads Team::threads(NThreads) is taken by the constructor.
+*/
+template<long_t M2, long_t NThreads, long_t K, class Team>
+class ParallLoop
 {
-  static const long_t NThreadsAlreadyCreated = I*NThreads;
-  
+  const int m_nthreads;
+
+public:
+  ParallLoop() : m_nthreads(Team::threads(NThreads)) { }
+
   template<class DftStr, class T>
-  void apply(DftStr& dft_str, T* data)
-  {
-      #pragma omp parallel num_threads(K)
+  struct Body {
+      DftStr& m_dft;
+      T* m_data;
+      Body(DftStr& dft, T* data) : m_dft(dft), m_data(data) { }
+      void operator()(const int tid, const int nt)
       {
-	int tid = omp_get_thread_num() + NThreadsAlreadyCreated;
-	dft_str.apply(data + tid*M2);
-	#pragma omp barrier
+        for (long_t i = tid; i < K; i += nt)
+          m_dft.apply(m_data + i*M2);
       }
+  };
+
+  template<class DftStr, class T>
+  void apply(DftStr& dft_str, T* data)
+  {
+      Body<DftStr,T> body(dft_str, data);
+      Team::run(m_nthreads, body);
   }
 };
 
 
 template<long_t NThreads, ulong_t K, typename KFact, ulong_t M, long_t Step, typename VType, int S, class W1,
-long_t SimpleSpec = (M / Step),
+class Team = OMPTeam, long_t SimpleSpec = (M / Step),
 bool isStd = Loki::TypeTraits<typename VType::ValueType>::isStdFundamental>
 class DFTk_x_Im_T_omp;
 
@@ -92,21 +211,21 @@ class DFTk_x_Im_T_omp;
 \tparam N current transform length
 \tparam T value type of the data array
 \tparam S sign of the transform: 1 - forward, -1 - backward
-\tparam C condition to ensure that (N>NThreads) and (N>=SwitchToOMP), otherwise 
-        parallelization is meaningless and sequential implementation InTime
-        is inherited.
+\tparam Team threads running the parallel loops (see OMPTeam, PoolTeam)
 
 Comparing to sequential implementation in template class InTime, this class
 runs apply() function of both instances of the half length (N/2) in the separated
 threads and so on until NThreads has become equal 1. Then the sequential version
 in template class InTime is inherited.
-\sa InFreqOMP, InTime, InFreq
+\sa InFreq_omp, InTime, InFreq
 */
-template<long_t NThreads, long_t N, typename NFact, typename VType, int S, class W1, long_t LastK = 1>
+template<long_t NThreads, long_t N, typename NFact, typename VType, int S, class W1, long_t LastK = 1,
+class Team = OMPTeam>
 class InTime_omp;
 
-template<long_t NThreads, long_t N, typename Head, typename Tail, typename VType, int S, class W1, long_t LastK>
-class InTime_omp<NThreads,N,Loki::Typelist<Head,Tail>,VType,S,W1,LastK> 
+template<long_t NThreads, long_t N, typename Head, typename Tail, typename VType, int S, class W1, long_t LastK,
+class Team>
+class InTime_omp<NThreads,N,Loki::Typelist<Head,Tail>,VType,S,W1,LastK,Team> 
 {
    typedef typename VType::ValueType T;
    typedef typename VType::TempType LocalVType;
@@ -124,9 +243,9 @@ class InTime_omp<NThreads,N,Loki::Typelist<Head,Tail>,VType,S,W1,LastK>
 
    InTime<M,Tail,VType,S,WK,K*LastK> dft_str;
 //    DFTk_x_Im_T<K,KFact,M,1,VType,S,W1> dft_scaled;
-   DFTk_x_Im_T_omp<NThreads,K,KFact,M,1,VType,S,W1> dft_scaled;
+   DFTk_x_Im_T_omp<NThreads,K,KFact,M,1,VType,S,W1,Team> dft_scaled;
 
-   ParallLoop<M2,NThreadsCreate,K> parall;
+   ParallLoop<M2,NThreadsCreate,K,Team> parall;
 public:
    void apply(T* data) 
    {
@@ -139,55 +258,147 @@ public:
    }
 };
 
-template<long_t N, typename Head, typename Tail, typename VType, int S, class W1, long_t LastK>
-class InTime_omp<1,N,Loki::Typelist<Head,Tail>,VType,S,W1,LastK> 
+template<long_t N, typename Head, typename Tail, typename VType, int S, class W1, long_t LastK, class Team>
+class InTime_omp<1,N,Loki::Typelist<Head,Tail>,VType,S,W1,LastK,Team> 
 : public InTime<N,Loki::Typelist<Head,Tail>,VType,S,W1,LastK> {};
 
 ///////////////////////
 
-// Assume: K >= NThreadsCreate
-template<typename Perm, long_t N2, long_t M2, long_t LastK2, long_t NThreads, int K,
-int I = 0, bool C = (K>NThreads)>
-struct ParallLoopOOP;
-
-template<typename Perm, long_t N2, long_t M2, long_t LastK2, long_t NThreads, int K, int I>
-struct ParallLoopOOP<Perm,N2,M2,LastK2,NThreads,K,I,true>
+/// Out-of-place version of ParallLoop
+/*! The block i reads the input from the offset Perm::value(i)*LastK2
+    and writes the output to the offset i*M2.
+*/
+template<typename Perm, long_t N2, long_t M2, long_t LastK2, long_t NThreads, long_t K, class Team>
+class ParallLoopOOP
 {
-  static const long_t NThreadsAlreadyCreated = I*NThreads;
-  
-  ParallLoopOOP<Perm,N2,M2,LastK2,NThreads,K-NThreads,I+1> NextStep;
-  
+  const int m_nthreads;
+
+public:
+  ParallLoopOOP() : m_nthreads(Team::threads(NThreads)) { }
+
   template<class DftStr, class T>
-  void apply(DftStr& dft_str, const T* src, T* dst)
-  {
-      #pragma omp parallel num_threads(NThreads)
+  struct Body {
+      DftStr& m_dft;
+      const T* m_src;
+      T* m_dst;
+      Body(DftStr& dft, const T* src, T* dst) : m_dft(dft), m_src(src), m_dst(dst) { }
+      void operator()(const int tid, const int nt)
       {
-	int tid = omp_get_thread_num() + NThreadsAlreadyCreated;
-	dft_str.apply(src + Perm::value(tid)*LastK2, dst + tid*M2);
-	//#pragma omp barrier
+        for (long_t i = tid; i < K; i += nt)
+          m_dft.apply(m_src + Perm::value(i)*LastK2, m_dst + i*M2);
       }
-      
-      NextStep.apply(dft_str, src, dst);
+  };
+
+  template<class DftStr, class T>
+  void apply(DftStr& dft_str, const T* src, T* dst)
+  {
+      Body<DftStr,T> body(dft_str, src, dst);
+      Team::run(m_nthreads, body);
   }
 };
 
-template<typename Perm, long_t N2, long_t M2, long_t LastK2, long_t NThreads, int K, int I>
-struct ParallLoopOOP<Perm,N2,M2,LastK2,NThreads,K,I,false>
+
+/// Loop over a batch of transforms
+/*!
+\tparam C number of values of type T in one complex element
+
+Runs the transform \a howmany times. The element j of the transform b
+is located at the position (b*dist + j*stride), where \a stride and 
+\a dist are given in complex elements. The transform reads \a nin and
+writes \a nout real numbers (see TransformLength). The loop is parallelized with
+\a nthreads threads, if nthreads > 1, so the transform must be reentrant.
+Strided transforms (stride > 1) are gathered into a contiguous work array,
+which is taken from ThreadScratch of each thread.
+*/
+template<int C>
+struct BatchLoop
 {
-  static const long_t NThreadsAlreadyCreated = I*NThreads;
-  
-  template<class DftStr, class T>
-  void apply(DftStr& dft_str, const T* src, T* dst)
+  template<class Run, class T>
+  static void apply(Run& run, T* data, const long_t nin, const long_t nout, const long_t howmany,
+                    const long_t stride, const long_t dist, const int nthreads)
   {
-      #pragma omp parallel num_threads(K)
+      if (stride == 1) {
+        #pragma omp parallel for schedule(static) num_threads(nthreads) if(nthreads > 1)
+        for (long_t b = 0; b < howmany; ++b)
+          run.apply(data + b*dist*C);
+        return;
+      }
+
+      #pragma omp parallel num_threads(nthreads) if(nthreads > 1)
       {
-	int tid = omp_get_thread_num() + NThreadsAlreadyCreated;
-	dft_str.apply(src + Perm::value(tid)*LastK2, dst + tid*M2);
-	#pragma omp barrier
+        // the in-place transform may write more numbers than it reads
+        T* buf = ThreadScratch<BatchLoop,T>::get(size(std::max(nin, nout)));
+        #pragma omp for schedule(static)
+        for (long_t b = 0; b < howmany; ++b) {
+          T* p = data + b*dist*C;
+          gather(p, buf, nin, stride);
+          run.apply(buf);
+          scatter(buf, p, nout, stride);
+        }
       }
   }
-};
 
+  template<class Run, class T>
+  static void apply(Run& run, const T* src, T* dst, const long_t nin, const long_t nout, 
+                    const long_t howmany, const long_t stride, const long_t dist, const int nthreads)
+  {
+      if (stride == 1) {
+        #pragma omp parallel for schedule(static) num_threads(nthreads) if(nthreads > 1)
+        for (long_t b = 0; b < howmany; ++b)
+          run.apply(src + b*dist*C, dst + b*dist*C);
+        return;
+      }
+
+      #pragma omp parallel num_threads(nthreads) if(nthreads > 1)
+      {
+        T* bufin = ThreadScratch<BatchLoop,T,1>::get(size(nin));
+        T* bufout = ThreadScratch<BatchLoop,T,2>::get(size(nout));
+        #pragma omp for schedule(static)
+        for (long_t b = 0; b < howmany; ++b) {
+          gather(src + b*dist*C, bufin, nin, stride);
+          run.apply(bufin, bufout);
+          scatter(bufout, dst + b*dist*C, nout, stride);
+        }
+      }
+  }
+
+private:
+  // number of values of type T holding n real numbers
+  static long_t size(const long_t n) { return C*((n+1)/2); }
+
+  // copies n real numbers of the strided transform into buf
+  template<class T>
+  static void gather(const T* p, T* buf, const long_t n, const long_t stride)
+  {
+      for (long_t i = 0; i < n/2; ++i) {
+        buf[2*i]   = p[2*i*stride];
+        buf[2*i+1] = p[2*i*stride + 1];
+      }
+      if (n%2) buf[n-1] = p[(n-1)*stride];
+  }
+
+  template<class T>
+  static void gather(const std::complex<T>* p, std::complex<T>* buf, const long_t n, const long_t stride)
+  {
+      gather(reinterpret_cast<const T*>(p), reinterpret_cast<T*>(buf), n, stride);
+  }
+
+  template<class T>
+  static void scatter(const T* buf, T* p, const long_t n, const long_t stride)
+  {
+      for (long_t i = 0; i < n/2; ++i) {
+        p[2*i*stride]     = buf[2*i];
+        p[2*i*stride + 1] = buf[2*i+1];
+      }
+      if (n%2) p[(n-1)*stride] = buf[n-1];
+  }
+
+  template<class T>
+  static void scatter(const std::complex<T>* buf, std::complex<T>* p, const long_t n, const long_t stride)
+  {
+      scatter(reinterpret_cast<const T*>(buf), reinterpret_cast<T*>(p), n, stride);
+  }
+};
 
 template<ulong_t K, typename KFact>
 struct Permutation;
@@ -245,7 +456,7 @@ struct DFTk_inp_adapter<K, Loki::Typelist<Head, Tail>, M, VType, S, W1, true>
 //    DFTk_x_Im_T_omp<1,KNext,KFactNext,KF*M,M,VType,S,W1> dft_scaled;
 
    DFTk_inp_adapter<KNext,KFactNext,M,VType,S,WK> dft_str;
-   DFTk_x_Im_T<KF,KF*KNext,KNext*M,M,VType,S,W1> dft_scaled;
+   DFTk_x_Im_T<KF,KF,KNext*M,M,VType,S,W1> dft_scaled;
 public:
 
    void apply(T* data) 
@@ -317,7 +528,7 @@ struct DFTk_inp_adapter<K, Loki::Typelist<Head, Tail>, M, VType, S, W1, false>
 //    DFTk_x_Im_T_omp<1,KNext,KFactNext,KF*M,M,VType,S,W1> dft_scaled;
 
    DFTk_inp_adapter<KNext,KFactNext,M,VType,S,WK> dft_str;
-   DFTk_x_Im_T<KF,KF*KNext,KNext*M,M,VType,S,W1> dft_scaled;
+   DFTk_x_Im_T<KF,KF,KNext*M,M,VType,S,W1> dft_scaled;
 public:
 
    void apply(CT* data) 
@@ -360,141 +571,123 @@ struct DFTk_inp_adapter<K,Loki::Typelist<pair_<ulong_<K>, ulong_<1> >, Loki::Nul
 ///////////////////////////////////////////////////
 
 
-// General implementation
-template<long_t NThreads, ulong_t K, typename KFact, ulong_t M, long_t Step, typename VType, int S, class W1, long_t SimpleSpec>
-class DFTk_x_Im_T_omp<NThreads,K,KFact,M,Step,VType,S,W1,SimpleSpec,true>
+/// Butterflies of the scaled step of InTime_omp distributed among the threads of Team
+/*! The M/Step butterflies are split into nt contiguous chunks, one per thread.
+    The twiddle factors \f$ w^{kb} \f$ of the butterfly b are loaded directly
+    from the shared RootsTable, so every thread starts at its own chunk
+    without stepping a recurrence from the first butterfly.
+    The number of threads Team::threads(NThreads) is taken by the constructor.
+*/
+template<long_t NThreads, ulong_t K, typename KFact, ulong_t M, long_t Step, typename VType, int S, class W1,
+class Team, long_t SimpleSpec>
+class DFTk_x_Im_T_omp<NThreads,K,KFact,M,Step,VType,S,W1,Team,SimpleSpec,true>
 {
    typedef typename VType::ValueType T;
-   typedef typename VType::TempType LocalVType;
-   static const long_t N = K*M;
-   static const long_t M2 = M*2;
+   static const long_t NB = M/Step;
    static const long_t S2 = 2*Step;
    
    typedef typename GetFirstRoot<K,S,VType::Accuracy>::Result W;
    DFTk_inp_adapter<K,KFact,M,VType,S,W> spec_inp_a;
 
-//   typedef Permutation<K,typename Loki::TL::Reverse<KFact>::Result> Perm;
    typedef Permutation<K,KFact> Perm;
 
-public:
-  /*  // This has low performance benefit and doesn't work for powers other than 2
-   void apply(T* data) 
-   {
-      #pragma omp parallel num_threads(K) shared(data)
+   const T* m_roots;
+   const int m_nthreads;
+
+   struct Body {
+      DFTk_x_Im_T_omp& m_dft;
+      T* m_data;
+      Body(DFTk_x_Im_T_omp& dft, T* data) : m_dft(dft), m_data(data) { }
+      void operator()(const int tid, const int nt)
       {
-	int tid = omp_get_thread_num();// + NThreadsAlreadyCreated;
-	if (tid == 0) {
-	  spec_inp_a.apply(data);
-	  ComputeRoots<K,VType,W1,Perm> roots(NThreads,tid);
-	  spec_inp_a.apply(data+S2*NThreads, roots.get_real(), roots.get_imag());
-      for (long_t j=2*NThreads*S2; j<M2; j+=S2*NThreads) {
-	    roots.step();
-	    spec_inp_a.apply(data+j, roots.get_real(), roots.get_imag());
-	  }
-	}
-	else {
-	  ComputeRoots<K,VType,W1,Perm> roots(NThreads,tid);
-	  spec_inp_a.apply(data+S2*tid, roots.get_real(), roots.get_imag());
-      for (long_t j=(NThreads+tid)*S2; j<M2; j+=S2*NThreads) {
-	    roots.step();
-	    spec_inp_a.apply(data+j, roots.get_real(), roots.get_imag());
-	  }
-	}
-	#pragma omp barrier
+        const long_t b0 = tid*NB/nt;
+        const long_t b1 = (tid+1)*NB/nt;
+        T wr[K-1], wi[K-1];
+        for (long_t b = b0; b < b1; ++b) {
+          if (b == 0) {
+            m_dft.spec_inp_a.apply(m_data);
+            continue;
+          }
+          // w^{kb} goes to the position of the k-th factor of the adapter
+          for (ulong_t k = 1; k < K; ++k) {
+            const long_t ii = Perm::value(k) - 1;
+            wr[ii] = m_dft.m_roots[2*k*b];
+            wi[ii] = m_dft.m_roots[2*k*b + 1];
+          }
+          m_dft.spec_inp_a.apply(m_data + b*S2, wr, wi);
+        }
       }
-   }
-   */
-  
-   // Sequential version
+   };
+
+public:
+   DFTk_x_Im_T_omp()
+   : m_roots(RootsTable<K*NB,T,S>::Instance().getData()), m_nthreads(Team::threads(NThreads)) { }
+
    void apply(T* data) 
    {
-     // M times call to spec_inp_a.apply()
-      spec_inp_a.apply(data);
-      ComputeRoots<K,VType,W1,Perm> roots;
-
-      spec_inp_a.apply(data+S2, roots.get_real(), roots.get_imag());
-      for (long_t j=S2+S2; j<M2; j+=S2) {
-        roots.step();
-        spec_inp_a.apply(data+j, roots.get_real(), roots.get_imag());
-      }
+      Body body(*this, data);
+      Team::run(m_nthreads, body);
    }
-    
 };
 
-/*
-template<long_t NThreads, typename KFact, long_t M, long_t Step, typename VType, int S, class W>
-class DFTk_x_Im_T_omp<NThreads,3,KFact,M,Step,VType,S,W,false,true>
-: public DFTk_x_Im_T<3,KFact,M,Step,VType,S,W,false,true> {};
-
-template<long_t NThreads, typename KFact, long_t M, long_t Step, typename VType, int S, class W>
-class DFTk_x_Im_T_omp<NThreads,2,KFact,M,Step,VType,S,W,false,true>
-: public DFTk_x_Im_T<2,KFact,M,Step,VType,S,W,false,true> {};
-*/
-
-template<long_t NThreads, ulong_t K, typename KFact, ulong_t M, long_t Step, typename VType, int S, class W1, long_t SimpleSpec>
-class DFTk_x_Im_T_omp<NThreads,K,KFact,M,Step,VType,S,W1,SimpleSpec,false>
+template<long_t NThreads, ulong_t K, typename KFact, ulong_t M, long_t Step, typename VType, int S, class W1,
+class Team, long_t SimpleSpec>
+class DFTk_x_Im_T_omp<NThreads,K,KFact,M,Step,VType,S,W1,Team,SimpleSpec,false>
 {
    typedef typename VType::ValueType CT;
-   static const long_t N = K*M;
+   typedef typename VType::base_type T;
+   static const long_t NB = M/Step;
    
    typedef typename GetFirstRoot<K,S,VType::Accuracy>::Result W;
    DFTk_inp_adapter<K,KFact,M,VType,S,W> spec_inp_a;
 
    typedef Permutation<K,KFact> Perm;
 
-public:
-  
-   /*  // This has low performance benefit and doesn't work for powers other than 2
-  void apply(CT* data) 
-   {
-      #pragma omp parallel num_threads(K) shared(data)
+   const CT* m_roots;
+   const int m_nthreads;
+
+   struct Body {
+      DFTk_x_Im_T_omp& m_dft;
+      CT* m_data;
+      Body(DFTk_x_Im_T_omp& dft, CT* data) : m_dft(dft), m_data(data) { }
+      void operator()(const int tid, const int nt)
       {
-	int tid = omp_get_thread_num();
-	if (tid == 0) {
-	  spec_inp_a.apply(data);
-	  ComputeRootsStd<K,VType,W1,Perm> roots(NThreads,tid);
-	  spec_inp_a.apply(data+Step*NThreads, roots.get());
-      for (long_t j=2*NThreads*Step; j<M; j+=Step*NThreads) {
-	    roots.step();
-	    spec_inp_a.apply(data+j, roots.get());
-	  }
-	}
-	else {
-	  ComputeRootsStd<K,VType,W1,Perm> roots(NThreads,tid);
-	  spec_inp_a.apply(data+Step*tid, roots.get());
-      for (long_t j=(NThreads+tid)*Step; j<M; j+=Step*NThreads) {
-	    roots.step();
-	    spec_inp_a.apply(data+j, roots.get());
-	  }
-	}
-	#pragma omp barrier
+        const long_t b0 = tid*NB/nt;
+        const long_t b1 = (tid+1)*NB/nt;
+        CT w[K-1];
+        for (long_t b = b0; b < b1; ++b) {
+          if (b == 0) {
+            m_dft.spec_inp_a.apply(m_data);
+            continue;
+          }
+          for (ulong_t k = 1; k < K; ++k)
+            w[Perm::value(k) - 1] = m_dft.m_roots[k*b];
+          m_dft.spec_inp_a.apply(m_data + b*Step, w);
+        }
       }
-   }
-   */
-  
-   // Sequential version
+   };
+
+public:
+   DFTk_x_Im_T_omp()
+   : m_roots(reinterpret_cast<const CT*>(RootsTable<K*NB,T,S>::Instance().getData())),
+     m_nthreads(Team::threads(NThreads)) { }
+
    void apply(CT* data) 
    {
-     // M times call to spec_inp_a.apply()
-      spec_inp_a.apply(data);
-      ComputeRootsStd<K,VType,W1,Perm> roots;
-
-      spec_inp_a.apply(data+Step, roots.get());
-      for (ulong_t j=Step+Step; j<M; j+=Step) {
-        roots.step();
-        spec_inp_a.apply(data+j, roots.get());
-      }
+      Body body(*this, data);
+      Team::run(m_nthreads, body);
    }
-    
 };
 
 ///////////////////////////////////////////////////////////
 
-template<long_t NThreads, long_t N, typename NFact, typename VType, int S, class W1, long_t LastK = 1>
+template<long_t NThreads, long_t N, typename NFact, typename VType, int S, class W1, long_t LastK = 1,
+class Team = OMPTeam>
 class InTimeOOP_omp;
 
-template<long_t NThreads, long_t N, typename Head, typename Tail, typename VType, int S, class W1, long_t LastK>
-class InTimeOOP_omp<NThreads,N,Loki::Typelist<Head,Tail>,VType,S,W1,LastK> 
+template<long_t NThreads, long_t N, typename Head, typename Tail, typename VType, int S, class W1, long_t LastK,
+class Team>
+class InTimeOOP_omp<NThreads,N,Loki::Typelist<Head,Tail>,VType,S,W1,LastK,Team> 
 {
    typedef typename VType::ValueType T;
    typedef typename VType::TempType LocalVType;
@@ -514,9 +707,9 @@ class InTimeOOP_omp<NThreads,N,Loki::Typelist<Head,Tail>,VType,S,W1,LastK>
    typedef typename IPowBig<W1,K>::Result WK;
    InTimeOOP<M,Tail,VType,S,WK,K*LastK> dft_str;
 //    DFTk_x_Im_T<K,M,VType,S,W1> dft_scaled;
-   DFTk_x_Im_T_omp<NThreadsCreate,K,KFact,M,1,VType,S,W1> dft_scaled;
+   DFTk_x_Im_T_omp<NThreads,K,KFact,M,1,VType,S,W1,Team> dft_scaled;
 
-   ParallLoopOOP<Perm,N2,M2,LastK2,NThreadsCreate,K> parall;
+   ParallLoopOOP<Perm,N2,M2,LastK2,NThreadsCreate,K,Team> parall;
 public:
 
    void apply(const T* src, T* dst) 
@@ -533,10 +726,349 @@ public:
    }
 };
 
+template<long_t N, typename Head, typename Tail, typename VType, int S, class W1, long_t LastK, class Team>
+class InTimeOOP_omp<1,N,Loki::Typelist<Head,Tail>,VType,S,W1,LastK,Team> 
+: public InTimeOOP<N,Loki::Typelist<Head,Tail>,VType,S,W1,LastK> {};
+
+///////////////////////
+
+///////////////////////
+
+/// Twiddle pass of a step of InTimeTask and InTimeOOPTask split into NChunks tasks
+/*! Any radix K runs through DFTk_x_Im_T_omp. Since its DFTk_inp_adapter decomposes
+    a composite K, the sub-transform i of the out-of-place step reads the input
+    from the position Perm::value(i).
+*/
+template<long_t NChunks, ulong_t K, ulong_t M, typename VType, int S, class W1,
+bool isPow2 = (K == 4 || K == 8 || K == 16)>
+class DFTk_x_Im_T_task
+: public DFTk_x_Im_T_omp<NChunks,K,typename Factorize<ulong_<K> >::Result,M,1,VType,S,W1,OMPTaskTeam>
+{
+public:
+   typedef Permutation<K,typename Loki::TL::Reverse<typename Factorize<ulong_<K> >::Result>::Result> Perm;
+};
+
+/// The codelets of the length K = 4, 8, 16 keep the vectorized DFTkPow2_x_Im_T and natural order of the input
+template<long_t NChunks, ulong_t K, ulong_t M, typename VType, int S, class W1>
+class DFTk_x_Im_T_task<NChunks,K,M,VType,S,W1,true>
+{
+   typedef typename VType::ValueType T;
+   typedef DFTkPow2_x_Im_T<K,M,1,VType,S> Dft;
+   Dft m_dft;
+
+   struct Body {
+      Dft& m_dft;
+      T* m_data;
+      Body(Dft& dft, T* data) : m_dft(dft), m_data(data) { }
+      void operator()(const int tid, const int nt)
+      {
+        m_dft.apply(m_data, tid*M/nt, (tid+1)*M/nt);
+      }
+   };
+
+public:
+   typedef Permutation<K,Loki::NullType> Perm;
+
+   void apply(T* data) 
+   {
+      Body body(m_dft, data);
+      OMPTaskTeam::run(NChunks, body);
+   }
+};
+
+/// In-place decimation in time, whose steps spawn the sub-transforms as %OpenMP tasks
+/*!
+\tparam N current transform length
+\tparam NFact factorization list
+\tparam VType type of data element
+\tparam S sign of the transform: 1 - forward, -1 - backward
+\tparam W1 compile-time root of unity
+\tparam LastK product of the factors of the enclosing steps
+
+The same recursion as InTime, but the K strided sub-transforms of a step are
+the tasks, which the threads of the enclosing region take from each other (work stealing).
+Every sub-transform of the length from TaskCutoff spawns its own tasks,
+the shorter ones are computed by InTime. The twiddle pass of the step is split into
+N/TaskCutoff chunks of butterflies, which are the tasks as well (see DFTk_x_Im_T_task).
+So the load is balanced for any number of threads and any factor K.
+Outside of a parallel region all the tasks are run by the calling thread.
+\sa InTime_omp, InTimeOOPTask
+*/
+template<long_t N, typename NFact, typename VType, int S, class W1, long_t LastK = 1>
+class InTimeTask;
+
+// Only the powers of primes are computed in place (see InTime)
+template<long_t N, typename Head, typename Tail, typename VType, int S, class W1, long_t LastK>
+class InTimeTask<N, Loki::Typelist<Head,Tail>, VType, S, W1, LastK>
+: public InTime<N, Loki::Typelist<Head,Tail>, VType, S, W1, LastK> {};
+
+template<long_t N, typename Head, typename VType, int S, class W1, long_t LastK>
+class InTimeTask<N, Loki::Typelist<Head,Loki::NullType>, VType, S, W1, LastK>
+{
+   typedef typename VType::ValueType T;
+   static const long_t K = Head::first::value;
+   static const long_t M = N/K;
+   
+   static const int C = Loki::TypeTraits<T>::isStdFundamental ? 2 : 1;
+   static const long_t M2 = M*C;
+   static const long_t N2 = N*C;
+   static const long_t NChunks = (N > TaskCutoff) ? N/TaskCutoff : 1;
+   
+   typedef typename IPowBig<W1,K>::Result WK;
+   typedef Loki::Typelist<pair_<typename Head::first, ulong_<Head::second::value-1> >, Loki::NullType> NFactNext;
+   typedef typename Loki::Select<(M >= TaskCutoff), InTimeTask<M,NFactNext,VType,S,WK,K*LastK>,
+                                 InTime<M,NFactNext,VType,S,WK,K*LastK> >::Result Str;
+   Str dft_str;
+   DFTk_x_Im_T_task<NChunks,K,M,VType,S,W1> dft_scaled;
+public:
+   void apply(T* data) 
+   {
+      for (long_t m=0; m < N2; m+=M2) {
+        #pragma omp task firstprivate(m)
+        dft_str.apply(data + m);
+      }
+      #pragma omp taskwait
+
+      dft_scaled.apply(data);
+   }
+};
+
+// Take the next factor from the list
+template<long_t N, long_t K, typename Tail, typename VType, int S, class W1, long_t LastK>
+class InTimeTask<N, Loki::Typelist<pair_<ulong_<K>, ulong_<0> >,Tail>, VType, S, W1, LastK>
+: public InTimeTask<N, Tail, VType, S, W1, LastK> {};
+
+// Specialization for a prime N
+template<long_t N, typename VType, int S, class W1, long_t LastK>
+class InTimeTask<N,Loki::Typelist<pair_<ulong_<N>, ulong_<1> >, Loki::NullType>,VType,S,W1,LastK>
+: public InTime<N,Loki::Typelist<pair_<ulong_<N>, ulong_<1> >, Loki::NullType>,VType,S,W1,LastK> {};
+
+
+/// Out-of-place version of InTimeTask
+/*! The sub-transform i writes the output to the offset i*M, each one as a separate task.
+    It reads the input from the offset Perm::value(i)*LastK, where the permutation
+    depends on the twiddle pass (see DFTk_x_Im_T_task).
+    \sa InTimeOOP_omp
+*/
+template<long_t N, typename NFact, typename VType, int S, class W1, long_t LastK = 1>
+class InTimeOOPTask;
+
+template<long_t N, typename Head, typename Tail, typename VType, int S, class W1, long_t LastK>
+class InTimeOOPTask<N, Loki::Typelist<Head,Tail>, VType, S, W1, LastK>
+{
+   typedef typename VType::ValueType T;
+   static const long_t K = Head::first::value;
+   static const long_t M = N/K;
+   
+   static const int C = Loki::TypeTraits<T>::isStdFundamental ? 2 : 1;
+   static const long_t M2 = M*C;
+   static const long_t N2 = N*C;
+   static const long_t LastK2 = LastK*C;
+   static const long_t NChunks = (N > TaskCutoff) ? N/TaskCutoff : 1;
+   
+   typedef typename IPowBig<W1,K>::Result WK;
+   typedef Loki::Typelist<pair_<typename Head::first, ulong_<Head::second::value-1> >, Tail> NFactNext;
+   typedef DFTk_x_Im_T_task<NChunks,K,M,VType,S,W1> Twiddles;
+   typedef typename Twiddles::Perm Perm;
+   typedef typename Loki::Select<(M >= TaskCutoff), InTimeOOPTask<M,NFactNext,VType,S,WK,K*LastK>,
+                                 InTimeOOP<M,NFactNext,VType,S,WK,K*LastK> >::Result Str;
+   Str dft_str;
+   Twiddles dft_scaled;
+public:
+   void apply(const T* src, T* dst) 
+   {
+      for (long_t i = 0; i < K; ++i) {
+        #pragma omp task firstprivate(i)
+        dft_str.apply(src + Perm::value(i)*LastK2, dst + i*M2);
+      }
+      #pragma omp taskwait
+
+      dft_scaled.apply(dst);
+   }
+};
+
+// Take the next factor from the list
+template<long_t N, long_t K, typename Tail, typename VType, int S, class W1, long_t LastK>
+class InTimeOOPTask<N, Loki::Typelist<pair_<ulong_<K>, ulong_<0> >,Tail>, VType, S, W1, LastK>
+: public InTimeOOPTask<N, Tail, VType, S, W1, LastK> {};
+
+// Specialization for prime N
+template<long_t N, typename VType, int S, class W1, long_t LastK>
+class InTimeOOPTask<N,Loki::Typelist<pair_<ulong_<N>, ulong_<1> >, Loki::NullType>,VType,S,W1,LastK>
+: public InTimeOOP<N,Loki::Typelist<pair_<ulong_<N>, ulong_<1> >, Loki::NullType>,VType,S,W1,LastK> {};
+
+
+// The task tree of OpenMPTasks is run by the threads of a single parallel region
+template<long_t NThreads, long_t N, typename Head, typename Tail, typename VType, int S, class W1, long_t LastK>
+class InTime_omp<NThreads,N,Loki::Typelist<Head,Tail>,VType,S,W1,LastK,OMPTaskTeam> 
+{
+   typedef typename VType::ValueType T;
+   InTimeTask<N,Loki::Typelist<Head,Tail>,VType,S,W1,LastK> m_tree;
+   const int m_nthreads;
+public:
+   InTime_omp() : m_nthreads(OMPTaskTeam::threads(NThreads)) { }
+
+   void apply(T* data) 
+   {
+      #pragma omp parallel num_threads(m_nthreads) if(m_nthreads > 1)
+      #pragma omp single
+      m_tree.apply(data);
+   }
+};
+
 template<long_t N, typename Head, typename Tail, typename VType, int S, class W1, long_t LastK>
-class InTimeOOP_omp<1,N,Loki::Typelist<Head,Tail>,VType,S,W1,LastK> 
+class InTime_omp<1,N,Loki::Typelist<Head,Tail>,VType,S,W1,LastK,OMPTaskTeam> 
+: public InTime<N,Loki::Typelist<Head,Tail>,VType,S,W1,LastK> {};
+
+// The tasks need no factor for the threads, so all the factors are grouped to the radix 16
+template<long_t NThreads, long_t N, typename Head, typename Tail, typename VType, int S, class W1, long_t LastK>
+class InTimeOOP_omp<NThreads,N,Loki::Typelist<Head,Tail>,VType,S,W1,LastK,OMPTaskTeam> 
+{
+   typedef typename VType::ValueType T;
+   typedef typename GroupRadix<Loki::Typelist<Head,Tail> >::Result NFact;
+   InTimeOOPTask<N,NFact,VType,S,W1,LastK> m_tree;
+   const int m_nthreads;
+public:
+   InTimeOOP_omp() : m_nthreads(OMPTaskTeam::threads(NThreads)) { }
+
+   void apply(const T* src, T* dst) 
+   {
+      #pragma omp parallel num_threads(m_nthreads) if(m_nthreads > 1)
+      #pragma omp single
+      m_tree.apply(src, dst);
+   }
+};
+
+template<long_t N, typename Head, typename Tail, typename VType, int S, class W1, long_t LastK>
+class InTimeOOP_omp<1,N,Loki::Typelist<Head,Tail>,VType,S,W1,LastK,OMPTaskTeam> 
 : public InTimeOOP<N,Loki::Typelist<Head,Tail>,VType,S,W1,LastK> {};
 
+/** \class {GFFT::InFreq_omp}
+\brief %OpenMP parallelized decimation-in-frequency FFT version.
+\tparam NThreads is number of threads
+\tparam N current transform length
+\tparam NFact factorization list
+\tparam VType type of data element
+\tparam S sign of the transform: 1 - forward, -1 - backward
+\tparam Team threads running the parallel loops (see OMPTeam, PoolTeam)
+
+The butterflies of the scaled DFT are shared among the threads.
+If K is not less than NThreads, the K blocks of the length M=N/K
+run in the separated threads by the sequential implementation InFreq
+like in InTime_omp. Otherwise, the blocks are transformed one after another
+by InFreq_omp, so the steps are parallelized until there are enough blocks.
+\sa InFreq, InTime_omp
+*/
+template<long_t NThreads, long_t N, typename NFact, typename VType, int S, class Team = OMPTeam>
+class InFreq_omp;
+
+template<long_t NThreads, long_t N, typename Head, typename Tail, typename VType, int S, class Team>
+class InFreq_omp<NThreads,N,Loki::Typelist<Head,Tail>,VType,S,Team>
+{
+   typedef typename VType::ValueType T;
+   static const long_t K = Head::first::value;
+   static const long_t M = N/K;
+
+   static const int C = Loki::TypeTraits<T>::isStdFundamental ? 2 : 1;
+   static const long_t M2 = M*C;
+   static const long_t N2 = N*C;
+   static const long_t NThreadsCreate = (NThreads > K) ? K : NThreads;
+   static const long_t NThreadsStep = (NThreads > M) ? M : NThreads;
+   static const bool isBlockParall = (K >= NThreads);
+
+   typedef typename Loki::Select<(Head::second::value > 1),
+      Loki::Typelist<pair_<typename Head::first, ulong_<Head::second::value-1> >, Tail>,
+      Tail>::Result NFactNext;
+   typedef typename Loki::Select<isBlockParall, InFreq<M,NFactNext,VType,S>,
+      InFreq_omp<NThreads,M,NFactNext,VType,S,Team> >::Result DftStr;
+   typedef T_DFTk_x_Im<K,M,VType,S> DftScaled;
+
+   DftStr dft_str;
+   DftScaled dft_scaled;
+
+   ParallLoop<M2,NThreadsCreate,K,Team> parall;
+   const int m_nstep;
+
+   // butterflies of the thread tid out of nt
+   struct StepBody {
+      DftScaled& m_dft;
+      T* m_data;
+      StepBody(DftScaled& dft, T* data) : m_dft(dft), m_data(data) { }
+      void operator()(const int tid, const int nt)
+      {
+        m_dft.apply(m_data, M*tid/nt, M*(tid+1)/nt);
+      }
+   };
+
+   void apply_blocks(T* data, Loki::Int2Type<true>)
+   {
+      parall.apply(dft_str, data);
+   }
+
+   void apply_blocks(T* data, Loki::Int2Type<false>)
+   {
+      for (long_t m = 0; m < N2; m+=M2)
+        dft_str.apply(data + m);
+   }
+
+public:
+   InFreq_omp() : m_nstep(Team::threads(NThreadsStep)) { }
+
+   void apply(T* data)
+   {
+      StepBody body(dft_scaled, data);
+      Team::run(m_nstep, body);
+
+      apply_blocks(data, Loki::Int2Type<isBlockParall>());
+   }
+};
+
+template<long_t N, typename Head, typename Tail, typename VType, int S, class Team>
+class InFreq_omp<1,N,Loki::Typelist<Head,Tail>,VType,S,Team>
+: public InFreq<N,Loki::Typelist<Head,Tail>,VType,S> {};
+
+// Specialization for prime N
+template<long_t NThreads, long_t N, typename VType, int S, class Team>
+class InFreq_omp<NThreads,N,Loki::Typelist<pair_<ulong_<N>, ulong_<1> >, Loki::NullType>,VType,S,Team>
+: public InFreq<N,Loki::Typelist<pair_<ulong_<N>, ulong_<1> >, Loki::NullType>,VType,S> {};
+
+template<long_t N, typename VType, int S, class Team>
+class InFreq_omp<1,N,Loki::Typelist<pair_<ulong_<N>, ulong_<1> >, Loki::NullType>,VType,S,Team>
+: public InFreq<N,Loki::Typelist<pair_<ulong_<N>, ulong_<1> >, Loki::NullType>,VType,S> {};
+
+
+/// %OpenMP parallelized out-of-place decimation-in-frequency FFT version
+/**
+\tparam NThreads is number of threads
+\tparam N transform length
+\tparam NFact factorization list
+\tparam VType type of data element
+\tparam S sign of the transform: 1 - forward, -1 - backward
+
+The same as InFreqOOP, but the transform itself is computed by InFreq_omp.
+\sa InFreqOOP, InTimeOOP_omp
+*/
+template<long_t NThreads, long_t N, typename NFact, typename VType, int S, class Team = OMPTeam>
+class InFreqOOP_omp
+{
+   typedef typename VType::ValueType T;
+   static const int C = Loki::TypeTraits<T>::isStdFundamental ? 2 : 1;
+
+   InFreq_omp<NThreads,N,NFact,VType,S,Team> dft;
+   DigitReversal<N,NFact,VType> perm;
+
+public:
+   void apply(const T* src, T* dst)
+   {
+      std::copy(src, src + N*C, dst);
+      dft.apply(dst);
+      perm.apply(dst);
+   }
+};
+
+template<long_t N, typename NFact, typename VType, int S, class Team>
+class InFreqOOP_omp<1,N,NFact,VType,S,Team> : public InFreqOOP<N,NFact,VType,S> {};
+
 
 /** \class {GFFT::GFFTswap2OMP}
 \brief Binary reordering parallelized by %OpenMP
@@ -34,8 +34,8 @@ namespace GFFT {
 /// \ingroup gr_groups
 struct ValueTypeGroup
 {
-  typedef TYPELIST_4(DOUBLE,FLOAT,COMPLEX_DOUBLE,COMPLEX_FLOAT) FullList;
-  static const ulong_t Length = 4;
+  typedef TYPELIST_6(DOUBLE,FLOAT,COMPLEX_DOUBLE,COMPLEX_FLOAT,SPLIT_DOUBLE,SPLIT_FLOAT) FullList;
+  static const ulong_t Length = 6;
   typedef DOUBLE Default;
 };
 
@@ -43,8 +43,8 @@ struct ValueTypeGroup
 /// \ingroup gr_groups
 struct TransformTypeGroup
 {
-  typedef TYPELIST_4(DFT,IDFT,RDFT,IRDFT) FullList;
-  static const ulong_t Length = 4;
+  typedef TYPELIST_12(DFT,IDFT,RDFT,IRDFT,DCT1,IDCT1,DCT2,IDCT2,DCT4,IDCT4,MDCT,IMDCT) FullList;
+  static const ulong_t Length = 12;
 //  typedef TYPELIST_2(DFT,IDFT) Default;
   typedef DFT Default;
 };
@@ -59,14 +59,14 @@ struct ParallelizationGroup
   typedef Serial Default;
 };
 
-// /// \brief Lists all acceptable decimation versions
-// /// \ingroup gr_groups
-// struct DecimationGroup
-// {
-//   typedef TYPELIST_2(INTIME,INFREQ) FullList;
-//   static const ulong_t Length = 2;
-//   typedef INFREQ Default;
-// };
+/// \brief Lists all acceptable decimation versions
+/// \ingroup gr_groups
+struct DecimationGroup
+{
+  typedef TYPELIST_6(INTIME,SPLITRADIX,INFREQ,SCRAMBLED,STOCKHAM,PRIMEFACTOR) FullList;
+  static const ulong_t Length = 6;
+  typedef INTIME Default;
+};
 
 /// \brief Lists in-place and out-of-place FFT algorithms
 /// \ingroup gr_groups
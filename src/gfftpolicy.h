@@ -29,9 +29,21 @@
 #include "twiddles.h"
 #include "gfftfactor.h"
 #include "gfftomp.h"
+#include "gfftpool.h"
+#include "gfftdct.h"
+#include "gfftsplit.h"
+#include "gfftalgsplitradix.h"
+#include "gfftalgstockham.h"
+#include "gfftalgpfa.h"
 
 static const long_t SwitchToOMP = (1<<8);
 
+/// Transform length, from which the policy ThreadPool runs in parallel
+static const long_t SwitchToPool = (1<<10);
+
+/// Transform length, from which the policy OpenMPTasks runs in parallel
+static const long_t SwitchToTasks = (1<<12);
+
 namespace GFFT {
 
 typedef unsigned int id_t;
@@ -42,11 +54,16 @@ typedef unsigned int id_t;
 This class represents basic interface for %GFFT classes.
 In other words, it shares the function fft(T*) between
 classes that represent FFT of different lengths and types.
+
+The function fft_many() runs a batch of \a howmany transforms within one call.
+The element j of the transform b is located at the position (b*dist + j*stride),
+where \a stride and \a dist are given in complex elements.
 */
 template<typename T>
 class AbstractFFT_inp {
 public:
    virtual void fft(T*) = 0;
+   virtual void fft_many(T* data, long_t howmany, long_t stride, long_t dist) = 0;
    virtual ~AbstractFFT_inp() {}
 };
 
@@ -54,6 +71,7 @@ template<typename T>
 class AbstractFFT_oop {
 public:
    virtual void fft(const T*, T*) = 0;
+   virtual void fft_many(const T* src, T* dst, long_t howmany, long_t stride, long_t dist) = 0;
    virtual ~AbstractFFT_oop() {}
 };
 
@@ -136,6 +154,134 @@ struct COMPLEX_FLOAT {
    static const char* name() { return "std::complex<float>"; }
 };
 
+/*! \brief Double precision complex numbers in split format
+\ingroup gr_params
+
+The array of N complex numbers contains N real parts followed by N imaginary parts.
+Only the one-dimensional complex-valued transforms DFT and IDFT are defined
+for this type (see SplitComplexDFT). InterleavedType is the value type
+of the short kernels, which SplitComplexDFT reuses for the larger radices.
+*/
+struct SPLIT_DOUBLE {
+   static const id_t ID = 4;
+   typedef double base_type;
+   typedef double ValueType;
+   typedef long double TempType;
+   typedef DOUBLE InterleavedType;
+#ifdef __x86_64
+   static const int Accuracy = 2;
+#else  
+   static const int Accuracy = 4;
+#endif
+   static const char* name() { return "split double"; }
+};
+
+/*! \brief Single precision complex numbers in split format
+\ingroup gr_params
+\sa SPLIT_DOUBLE
+*/
+struct SPLIT_FLOAT {
+   static const id_t ID = 5;
+   typedef float base_type;
+   typedef float ValueType;
+   typedef double TempType;
+   typedef FLOAT InterleavedType;
+#ifdef __x86_64
+   static const int Accuracy = 1;
+#else
+   static const int Accuracy = 2;
+#endif
+   static const char* name() { return "split float"; }
+};
+
+template<>
+struct IsSplitComplex<SPLIT_DOUBLE> {
+   static const bool value = true;
+};
+
+template<>
+struct IsSplitComplex<SPLIT_FLOAT> {
+   static const bool value = true;
+};
+
+
+/*! \brief Decimation-in-time algorithm (InTime, InTimeOOP)
+\ingroup gr_params
+*/
+struct INTIME {
+   static const id_t ID = 0;
+   static const char* name() { return "in-time"; }
+};
+
+/*! \brief Split-radix decimation-in-time algorithm (SplitRadix, SplitRadixOOP)
+\ingroup gr_params
+
+Used for the serial transforms of the length of power of two.
+Other transforms fall back to INTIME.
+*/
+struct SPLITRADIX {
+   static const id_t ID = 1;
+   static const char* name() { return "split-radix"; }
+};
+
+/*! \brief Decimation-in-frequency algorithm (InFreq, InFreqOOP)
+\ingroup gr_params
+
+The in-place transforms are computed by InFreq for the powers of primes only,
+the other lengths fall back to the algorithm of INTIME.
+The out-of-place transforms accept any length.
+*/
+struct INFREQ {
+   static const id_t ID = 2;
+   static const char* name() { return "in-frequency"; }
+};
+
+/*! \brief Forward and inverse transforms in digit-reversed order
+\ingroup gr_params
+
+The forward in-place DFT is computed by InFreq and leaves the result in digit-reversed
+order, the inverse in-place DFT is computed by InTime and takes its input in this order.
+Both skip the reordering pass, which is not needed, if the spectrum is only multiplied
+pointwise, e.g. for the convolution:
+\code
+typedef Transform<SIntID<4096>, DOUBLE, DFT, SIntID<1>, Serial, IN_PLACE, SCRAMBLED> Fwd;
+typedef Transform<SIntID<4096>, DOUBLE, IDFT, SIntID<1>, Serial, IN_PLACE, SCRAMBLED> Inv;
+\endcode
+The out-of-place transforms, the transforms of mixed radix and of other types
+than DFT and IDFT are computed in natural order like INTIME.
+*/
+struct SCRAMBLED {
+   static const id_t ID = 3;
+   static const char* name() { return "scrambled"; }
+};
+
+/*! \brief Stockham autosort algorithm (Stockham)
+\ingroup gr_params
+
+Used for the serial out-of-place transforms, whose factors do not exceed 16.
+Other transforms fall back to INTIME. INTIME itself switches to it for the lengths,
+where it is faster (see PreferStockham).
+*/
+struct STOCKHAM {
+   static const id_t ID = 4;
+   static const char* name() { return "stockham"; }
+};
+
+/*! \brief Prime-factor (Good-Thomas) algorithm (PrimeFactor)
+\ingroup gr_params
+
+Used for the serial transforms, whose length has at least two different prime factors.
+The coprime factors need no twiddle factors between them, only the index maps.
+Other transforms fall back to INTIME. The in-place transforms of such lengths
+use it for INTIME, SPLITRADIX and STOCKHAM as well, since InTime computes
+the powers of primes only in place.
+*/
+struct PRIMEFACTOR {
+   static const id_t ID = 5;
+   static const char* name() { return "prime-factor"; }
+};
+
+struct Serial;
 
 /*! \brief In-place algorithm 
 \ingroup gr_params
@@ -149,26 +295,69 @@ struct IN_PLACE {
    };
 
    template<long_t N, typename NFact, typename VType,
-            typename Parall, typename Direction>
+            typename Parall, typename Direction, typename Decimation = INTIME>
    class List {
       typedef typename VType::ValueType T;
-      typedef typename Parall::template ActualParall<N>::Result NewParall;
-      typedef typename NewParall::template Swap<NFact,T>::Result Swap;
+      // the prime factors, since the output of the threads factor is not in digit-reversed order
+      typedef typename Factorize<ulong_<N> >::Result NFactPrime;
+      // the parallel digit reversal handles the powers of a single prime only,
+      // the other lengths are transformed serially, e.g. by PrimeFactor
+      static const bool isPrimePower = (Loki::TL::Length<NFactPrime>::value == 1);
+      typedef typename Loki::Select<isPrimePower,
+         typename Parall::template ActualParall<N>::Result, Serial>::Result NewParall;
+      typedef typename Loki::Select<(NewParall::NParProc == 1),NFactPrime,NFact>::Result NFactList;
+      typedef typename NewParall::template Swap<NFactList,T>::Result Swap;
       typedef typename GetFirstRoot<N,Direction::Sign,VType::Accuracy>::Result W1;
-      typedef InTime_omp<NewParall::NParProc,N,NFact,VType,Direction::Sign,W1> InT;
+      typedef InTime_omp<NewParall::NParProc,N,NFactList,VType,Direction::Sign,W1,1,typename NewParall::Team> InT;
+      typedef TYPELIST_3(Swap,InT,Direction) InTList;
+      static const bool isSplitRadix = (Decimation::ID == SPLITRADIX::ID)
+                                    && IsPowerOf2<NFactList>::value && (NewParall::NParProc == 1);
+      typedef SplitRadix<N,VType,Direction::Sign> SR;
+      typedef TYPELIST_3(Swap,SR,Direction) SRList;
+      typedef InFreq_omp<NewParall::NParProc,N,NFactPrime,VType,Direction::Sign,typename NewParall::Team> InF;
+      typedef TYPELIST_3(InF,Swap,Direction) InFList;
+      // both algorithms without Swap for the digit-reversed spectrum
+      typedef TYPELIST_2(InF,Direction) InFScrList;
+      typedef TYPELIST_2(InT,Direction) InTScrList;
+      typedef typename Loki::Select<(Direction::Sign == 1),InFScrList,InTScrList>::Result ScrList;
+      // the digit reversal after InFreq and the digit-reversed order of InTime 
+      // are defined for the powers of a single prime only
+      static const bool isInFreq = (Decimation::ID == INFREQ::ID) && isPrimePower;
+      static const bool isScrambled = (Decimation::ID == SCRAMBLED::ID) && isPrimePower;
+      // InTime is restricted to the powers of primes, so the coprime factors
+      // are transformed by PrimeFactor, unless the decimation has its own algorithm
+      static const bool isPrimeFactor = !isScrambled && !isInFreq
+         && IsCoprimeFactorization<NFactPrime>::value && (NewParall::NParProc == 1);
+      typedef PrimeFactor<N,NFactPrime,VType,Direction::Sign> PF;
+      typedef TYPELIST_2(PF,Direction) PFList;
+      typedef typename Loki::Select<isScrambled,ScrList,
+         typename Loki::Select<isInFreq,InFList,
+         typename Loki::Select<isPrimeFactor,PFList,
+         typename Loki::Select<isSplitRadix,SRList,InTList>::Result>::Result>::Result>::Result DecList;
+      typedef Loki::Typelist<SplitComplexDFT<N,NFact,VType,Direction::Sign>,Loki::NullType> SplitList;
    public:
-      typedef TYPELIST_3(Swap,InT,Direction) Result;
+      typedef typename Loki::Select<IsSplitComplex<VType>::value,SplitList,DecList>::Result Result;
    };
    
-   template<typename FuncList, typename T>
+   template<typename FuncList, typename T, long_t NIn = 1, long_t NOut = NIn, ulong_t NThreads = 1>
    struct Function : public Interface<T>::Result
    {
       FuncList m_run;
+      const int m_nthreads;   // threads of the batches (NThreads = 0: RuntimeThreads)
+
+      Function() : m_nthreads(RuntimeThreads::count(NThreads)) { }
+
     //   in-place transform
       void fft(T* data) 
       { 
         m_run.apply(data);
       }
+    // batch of in-place transforms
+      void fft_many(T* data, long_t howmany, long_t stride, long_t dist)
+      {
+        static const int C = Loki::TypeTraits<T>::isStdFundamental ? 2 : 1;
+        BatchLoop<C>::apply(m_run, data, NIn, NOut, howmany, stride, dist, m_nthreads);
+      }
    };
    
    static const char* name() { return "in-place"; }
@@ -191,33 +380,94 @@ struct OUT_OF_PLACE {
 //    };
 
    template<long_t N, typename NFact, typename VType,
-            typename Parall, typename Direction>
+            typename Parall, typename Direction, typename Decimation = INTIME>
    class List {
       typedef typename Parall::template ActualParall<N>::Result NewParall;
       typedef typename GetFirstRoot<N,Direction::Sign,VType::Accuracy>::Result W1;
-      typedef InTimeOOP_omp<NewParall::NParProc,N,NFact,VType,Direction::Sign,W1> InT;
+      // the first factor of the multithreaded transform is kept for the threads
+      typedef typename Loki::Select<(NewParall::NParProc > 1),
+         Loki::Typelist<typename NFact::Head, typename GroupRadix<typename NFact::Tail>::Result>,
+         typename GroupRadix<NFact>::Result>::Result NFactGrouped;
+      typedef InTimeOOP_omp<NewParall::NParProc,N,NFactGrouped,VType,Direction::Sign,W1,1,
+                            typename NewParall::Team> InT;
+      typedef TYPELIST_2(InT,Direction) InTList;
+      static const bool isSplitRadix = (Decimation::ID == SPLITRADIX::ID)
+                                    && IsPowerOf2<NFact>::value && (NewParall::NParProc == 1);
+      typedef SplitRadixOOP<N,VType,Direction::Sign> SR;
+      typedef TYPELIST_2(SR,Direction) SRList;
+      // the threads share the steps of InFreq_omp, so no factor is kept for them
+      typedef typename GroupRadix<typename Factorize<ulong_<N> >::Result>::Result NFactFreq;
+      typedef InFreqOOP_omp<NewParall::NParProc,N,NFactFreq,VType,Direction::Sign,
+                            typename NewParall::Team> InF;
+      typedef TYPELIST_2(InF,Direction) InFList;
+      static const bool isStockham = (NewParall::NParProc == 1) && (MaxFactor<NFact>::value <= 16)
+         && ((Decimation::ID == STOCKHAM::ID)
+          || (Decimation::ID == INTIME::ID && PreferStockham<N,NFact>::value));
+      typedef Stockham<N,NFactFreq,VType,Direction::Sign> SH;
+      typedef TYPELIST_2(SH,Direction) SHList;
+      typedef typename Factorize<ulong_<N> >::Result NFactPrime;
+      static const bool isPrimeFactor = (Decimation::ID == PRIMEFACTOR::ID)
+         && IsCoprimeFactorization<NFactPrime>::value && (NewParall::NParProc == 1);
+      typedef PrimeFactor<N,NFactPrime,VType,Direction::Sign> PF;
+      typedef TYPELIST_2(PF,Direction) PFList;
+      typedef typename Loki::Select<isStockham,SHList,
+         typename Loki::Select<(Decimation::ID == INFREQ::ID),InFList,
+         typename Loki::Select<isPrimeFactor,PFList,
+         typename Loki::Select<isSplitRadix,SRList,InTList>::Result>::Result>::Result>::Result DecList;
+      typedef Loki::Typelist<SplitComplexDFT<N,NFact,VType,Direction::Sign>,Loki::NullType> SplitList;
    public:
-       typedef TYPELIST_2(InT,Direction) Result;
+      typedef typename Loki::Select<IsSplitComplex<VType>::value,SplitList,DecList>::Result Result;
    };
 
-   template<typename FuncList, typename T>
+   template<typename FuncList, typename T, long_t NIn = 1, long_t NOut = NIn, ulong_t NThreads = 1>
    struct Function : public Interface<T>::Result
    {
       FuncList m_run;
+      const int m_nthreads;   // threads of the batches (NThreads = 0: RuntimeThreads)
+
+      Function() : m_nthreads(RuntimeThreads::count(NThreads)) { }
+
     // out-of-place transform
       void fft(const T* src, T* dst) 
       { 
 	m_run.apply(src, dst); 
       }
+    // batch of out-of-place transforms
+      void fft_many(const T* src, T* dst, long_t howmany, long_t stride, long_t dist)
+      {
+        static const int C = Loki::TypeTraits<T>::isStdFundamental ? 2 : 1;
+        BatchLoop<C>::apply(m_run, src, dst, NIn, NOut, howmany, stride, dist, m_nthreads);
+      }
    };
 
    static const char* name() { return "out-of-place"; }
 };
 
+/// Place policy, which builds the List of the given decimation
+/*!
+\tparam Place IN_PLACE or OUT_OF_PLACE
+\tparam Decimation INTIME, SPLITRADIX, INFREQ, SCRAMBLED, STOCKHAM or PRIMEFACTOR
+
+Transform passes this class instead of Place to the algorithms of the transform types,
+so that the decimation reaches Place::List without the extra template parameter
+in every transform type.
+*/
+template<class Place, class Decimation>
+struct DecimationPlace : public Place {
+   template<long_t N, typename NFact, typename VType,
+            typename Parall, typename Direction>
+   class List {
+   public:
+      typedef typename Place::template List<N,NFact,VType,Parall,Direction,Decimation>::Result Result;
+   };
+};
+
 struct IDFT;
 struct IRDFT;
 struct IDCT1;
 struct IDCT2;
+struct IDCT4;
+struct IMDCT;
 
 /*! \brief Forward compex-valued discrete Fourier transform
 \ingroup gr_params
@@ -291,79 +541,208 @@ struct IRDFT {
       typedef Backward<N,T> Direction;
       typedef Separate<N,VType,Direction::Sign> Separator;
       typedef typename Place::template List<N,NFact,VType,Parall,Direction>::Result TList;
+      static const bool isOOP = (Place::ID == OUT_OF_PLACE::ID);
+      typedef Loki::Typelist<SeparateInput<N,VType,TList>,Loki::NullType> OOPList;
    public:
-      typedef Loki::Typelist<Separator,TList> Result;
+      typedef typename Loki::Select<isOOP,OOPList,Loki::Typelist<Separator,TList> >::Result Result;
    };
 };
 
 /*! \brief Forward discrete cosine transform, type 1
 \ingroup gr_params
+
+Transform of 2N+1 real numbers based on RDFT of the length N (see DCT1_impl)
 */
 struct DCT1 {
    static const id_t ID = 4;
    typedef IDCT1 Inverse;
 
-   template<unsigned long N, typename T>
-   struct Direction : public Forward<N,T> {};
-
    template<long_t N, typename NFact, typename VType,
             class Parall, class Place>
-   struct Algorithm {
-//      typedef TList Result;
+   class Algorithm {
+      typedef typename RDFT::template Algorithm<N,NFact,VType,Parall,Place>::Result RList;
+   public:
+      typedef Loki::Typelist<DCT1_impl<N,VType,RList,1>,Loki::NullType> Result;
    };
 };
 
 /*! \brief Inverse discrete cosine transform, type 1
 \ingroup gr_params
+
+DCT1 scaled by 1/(4N)
 */
 struct IDCT1 {
    static const id_t ID = 5;
    typedef DCT1 Inverse;
 
-   template<unsigned long N, typename T>
-   struct Direction : public Backward<N,T> {};
-
    template<long_t N, typename NFact, typename VType,
             class Parall, class Place>
-   struct Algorithm {
-//      typedef TList Result;
+   class Algorithm {
+      typedef typename RDFT::template Algorithm<N,NFact,VType,Parall,Place>::Result RList;
+   public:
+      typedef Loki::Typelist<DCT1_impl<N,VType,RList,-1>,Loki::NullType> Result;
    };
 };
 
 /*! \brief Forward discrete cosine transform, type 2
 \ingroup gr_params
+
+Transform of 2N real numbers based on RDFT of the length N (see DCT2_impl)
 */
 struct DCT2 {
    static const id_t ID = 6;
    typedef IDCT2 Inverse;
 
-   template<unsigned long N, typename T>
-   struct Direction : public Forward<N,T> {};
-
    template<long_t N, typename NFact, typename VType,
             class Parall, class Place>
-   struct Algorithm {
-      //typedef TList Result;
+   class Algorithm {
+      typedef typename RDFT::template Algorithm<N,NFact,VType,Parall,Place>::Result RList;
+   public:
+      typedef Loki::Typelist<DCT2_impl<N,VType,RList>,Loki::NullType> Result;
    };
 };
 
 /*! \brief Inverse discrete cosine transform, type 2
 \ingroup gr_params
+
+Scaled discrete cosine transform of type 3 (see IDCT2_impl)
 */
 struct IDCT2 {
    static const id_t ID = 7;
    typedef DCT2 Inverse;
 
-   template<unsigned long N, typename T>
-   struct Direction : public Backward<N,T> {};
+   template<long_t N, typename NFact, typename VType,
+            class Parall, class Place>
+   class Algorithm {
+      typedef typename IRDFT::template Algorithm<N,NFact,VType,Parall,Place>::Result RList;
+   public:
+      typedef Loki::Typelist<IDCT2_impl<N,VType,RList>,Loki::NullType> Result;
+   };
+};
+
+/*! \brief Forward discrete cosine transform, type 4
+\ingroup gr_params
+
+Transform of 2N real numbers based on the complex DFT of the length N (see DCT4_core)
+*/
+struct DCT4 {
+   static const id_t ID = 8;
+   typedef IDCT4 Inverse;
+
+   template<long_t N, typename NFact, typename VType,
+            class Parall, class Place>
+   class Algorithm {
+      typedef typename DFT::template Algorithm<N,NFact,VType,Parall,OUT_OF_PLACE>::Result DList;
+   public:
+      typedef Loki::Typelist<DCT4_impl<N,VType,DList,1>,Loki::NullType> Result;
+   };
+};
+
+/*! \brief Inverse discrete cosine transform, type 4
+\ingroup gr_params
+
+DCT4 scaled by 1/N
+*/
+struct IDCT4 {
+   static const id_t ID = 9;
+   typedef DCT4 Inverse;
+
+   template<long_t N, typename NFact, typename VType,
+            class Parall, class Place>
+   class Algorithm {
+      typedef typename DFT::template Algorithm<N,NFact,VType,Parall,OUT_OF_PLACE>::Result DList;
+   public:
+      typedef Loki::Typelist<DCT4_impl<N,VType,DList,-1>,Loki::NullType> Result;
+   };
+};
+
+/*! \brief Modified discrete cosine transform
+\ingroup gr_params
+
+Transform of 4N real numbers into 2N coefficients 
+based on the complex DFT of the length N (see MDCT_impl)
+*/
+struct MDCT {
+   static const id_t ID = 10;
+   typedef IMDCT Inverse;
 
    template<long_t N, typename NFact, typename VType,
             class Parall, class Place>
-   struct Algorithm {
-      //typedef TList Result;
+   class Algorithm {
+      typedef typename DFT::template Algorithm<N,NFact,VType,Parall,OUT_OF_PLACE>::Result DList;
+   public:
+      typedef Loki::Typelist<MDCT_impl<N,VType,DList>,Loki::NullType> Result;
    };
 };
 
+/*! \brief Inverse modified discrete cosine transform
+\ingroup gr_params
+
+Transform of 2N coefficients into 4N real numbers (see IMDCT_impl)
+*/
+struct IMDCT {
+   static const id_t ID = 11;
+   typedef MDCT Inverse;
+
+   template<long_t N, typename NFact, typename VType,
+            class Parall, class Place>
+   class Algorithm {
+      typedef typename DFT::template Algorithm<N,NFact,VType,Parall,OUT_OF_PLACE>::Result DList;
+   public:
+      typedef Loki::Typelist<IMDCT_impl<N,VType,DList>,Loki::NullType> Result;
+   };
+};
+
+/// Numbers of the real values in the input and output of a transform
+/*!
+\tparam Type type of transform
+\tparam N length of the transform
+
+Only these numbers are gathered and scattered by the batches of strided
+transforms (see BatchLoop), so that e.g. DCT1 of 2N+1 real numbers
+does not touch the imaginary part of its last complex element.
+*/
+template<class Type, long_t N>
+struct TransformLength {
+   static const long_t In = 2*N;
+   static const long_t Out = 2*N;
+};
+
+template<long_t N>
+struct TransformLength<DCT1,N> {
+   static const long_t In = 2*N+1;
+   static const long_t Out = 2*N+1;
+};
+
+template<long_t N>
+struct TransformLength<IDCT1,N> : public TransformLength<DCT1,N> {};
+
+template<long_t N>
+struct TransformLength<MDCT,N> {
+   static const long_t In = 4*N;
+   static const long_t Out = 2*N;
+};
+
+template<long_t N>
+struct TransformLength<IMDCT,N> {
+   static const long_t In = 2*N;
+   static const long_t Out = 4*N;
+};
+
+/// In-place digit reversal of the multithreaded transforms
+/*!
+The first factor of NFact is the number of the blocks of the threads (see OpenMP::Factor).
+The digits are the powers of the next factor, and the first factor adds one more digit,
+if it is its multiple. The permutation itself is split among NT threads of Team (see CobraSwap).
+*/
+template<typename NFact, typename T, ulong_t NT, class Team>
+struct ParallSwap {
+   static const ulong_t M = NFact::Tail::Head::first::value;
+   static const ulong_t P = IsMultipleOf<NFact::Head::first::value,M>::value
+                          + NFact::Tail::Head::second::value;
+   typedef typename SwapSelect<M,P,T,NT,Team>::Result Result;
+};
+
 /*! \brief %Serial (single-core) implementation of transform
 \sa OpenMP
 \ingroup gr_params
@@ -371,6 +750,7 @@ struct IDCT2 {
 struct Serial {
    static const id_t ID = 0;
    static const ulong_t NParProc = 1;
+   typedef SerialTeam Team;
 
    template<long_t N>
    struct ActualParall {
@@ -382,7 +762,7 @@ struct Serial {
    struct Swap {
       static const ulong_t M = NFact::Head::first::value;
       static const ulong_t P = NFact::Head::second::value;
-      typedef GFFTswap2<M,P,T> Result;
+      typedef typename SwapSelect<M,P,T,1,SerialTeam>::Result Result;
    };
 
    template<typename N>
@@ -402,8 +782,10 @@ struct Serial {
 */
 template<unsigned int NT>
 struct OpenMP {
+   static_assert(NT <= 100, "The IDs from 100 belong to the other parallelization policies");
    static const id_t ID = NT-1;
    static const ulong_t NParProc = NT;
+   typedef OMPTeam Team;
 
    template<long_t N>
    struct ActualParall {
@@ -413,13 +795,7 @@ struct OpenMP {
    
    // used for in-place transforms only
    template<typename NFact, typename T>
-   struct Swap {
-      static const ulong_t M = NFact::Tail::Head::first::value;
-      static const ulong_t P = IsMultipleOf<NFact::Head::first::value,M>::value
-                            + NFact::Tail::Head::second::value;
-      typedef GFFTswap2<M,P,T> Result;
-//       typedef GFFTswap2OMP<NT,M,P,T> Result;
-   };
+   struct Swap : public ParallSwap<NFact,T,NT,OMPTeam> {};
 
    template<typename N>
    struct Factor {
@@ -452,6 +828,195 @@ struct OpenMP<0>:public Serial { };
 template<>
 struct OpenMP<1>:public Serial { };
 
+
+/*! \brief %Transform is parallelized using the persistent pool of threads
+\tparam NT number of parallel threads including the calling one
+\sa OpenMP, WorkerPool
+\ingroup gr_params
+
+The same decomposition as OpenMP<NT>, but the parallel loops of the stages
+are the jobs of WorkerPool instead of the new %OpenMP parallel regions.
+The workers are started once and spin between the stages, so the overhead
+of a stage is a few hundred nanoseconds and the transforms from
+the length SwitchToPool run in parallel.
+The IDs from 100 distinguish the policy from OpenMP<NT>.
+*/
+template<unsigned int NT>
+struct ThreadPool {
+   static_assert(NT <= 100, "The IDs from 200 belong to the other parallelization policies");
+   static const id_t ID = 99+NT;
+   static const ulong_t NParProc = NT;
+   typedef PoolTeam<NT> Team;
+
+   template<long_t N>
+   struct ActualParall {
+      static const bool C = ((N > NT*NT) && (N >= SwitchToPool));
+      typedef typename Loki::Select<C,ThreadPool<NT>,Serial>::Result Result;
+   };
+
+   // used for in-place transforms only
+   template<typename NFact, typename T>
+   struct Swap : public ParallSwap<NFact,T,NT,PoolTeam<NT> > {};
+
+   template<typename N>
+   struct Factor {
+      static const long_t G = GCD<long_<N::value>, long_<NT> >::Result::value;
+      typedef typename Factorize<ulong_<N::value/G> >::Result NFact1;
+      typedef ExtractFactor<NT/G, NFact1> EF;
+      typedef pair_<ulong_<G*EF::value>,ulong_<1> > NParall;
+      typedef Loki::Typelist<NParall,typename EF::Result> Multithreaded;
+      typedef typename Factorize<N>::Result Singlethreaded;
+      static const bool C = ((N::value > NT*NT) && (N::value >= SwitchToPool));
+      typedef typename Loki::Select<C,Multithreaded,Singlethreaded>::Result Result;
+   };
+
+   template<typename T>
+   void apply(T*) { }
+
+   template<typename T>
+   void apply(const T*, T*) { }
+};
+
+template<>
+struct ThreadPool<0>:public Serial { };
+
+template<>
+struct ThreadPool<1>:public Serial { };
+
+/*! \brief %Transform is parallelized using %OpenMP with the number of threads chosen at run-time
+\tparam NTMax the largest number of threads
+\sa OpenMP, RuntimeThreads
+\ingroup gr_params
+
+The transform is split at compile-time like by OpenMP<NB>, i.e. into at least NB blocks,
+where NB = NTMax for the lengths above NTMax*NTMax. The shorter lengths from SwitchToOMP
+are split into fewer blocks, NB is halved until NB*NB < N (see BlockCount).
+The blocks and the butterflies of the parallel steps are distributed
+among RuntimeThreads::get() threads (at most NTMax), which the transform object 
+takes in its constructor. So the same code runs on a host of any number of cores
+or under any CPU quota. With K blocks the load is balanced within the ratio (ceil(K/nt)*nt)/K.
+
+The limits of the compile-time split: the lengths below SwitchToOMP run serially
+for any number of threads, and at most K threads take part in the first parallel step.
+The odd lengths are split as well, their first factor is the product of the prime factors
+of at least NB, e.g. \f$ 3^4 \f$ blocks of \f$ 3^7 \f$ for NB = 32.
+Like for OpenMP<NT>, the in-place transforms run in parallel only for the powers of a prime
+(see IN_PLACE), the other lengths are transformed serially by PrimeFactor.
+The number of parallel processes NParProc is zero, i.e. chosen at run-time
+for the batches (fft_many) and the multidimensional transforms as well.
+The IDs from 200 to 299 distinguish the policy from OpenMP<NT>, so NTMax is at most 100.
+*/
+template<unsigned int NTMax = 32>
+struct OpenMPRuntime {
+   static_assert(NTMax >= 1 && NTMax <= 100, "NTMax is from 1 to 100, the IDs from 300 belong to OpenMPTasks");
+   static const id_t ID = 199+NTMax;
+   static const ulong_t NParProc = 0;
+   typedef RuntimeOMPTeam Team;
+
+   /// Policy of the split transforms
+   struct Blocks : public OpenMP<NTMax> {
+      typedef RuntimeOMPTeam Team;
+
+      template<typename NFact, typename T>
+      struct Swap : public ParallSwap<NFact,T,NTMax,RuntimeOMPTeam> {};
+   };
+
+   /// Number of the blocks NB of the length N
+   template<long_t N, long_t NB = NTMax, bool C = (NB > 2 && NB*NB >= N)>
+   struct BlockCount {
+      static const long_t value = NB;
+   };
+
+   template<long_t N, long_t NB>
+   struct BlockCount<N,NB,true> : public BlockCount<N,NB/2> {};
+
+   template<long_t N>
+   struct ActualParall {
+      static const long_t NB = BlockCount<N>::value;
+      static const bool C = ((N > NB*NB) && (N >= SwitchToOMP));
+      typedef typename Loki::Select<C,Blocks,Serial>::Result Result;
+   };
+
+   template<typename N>
+   struct Factor : public OpenMP<BlockCount<N::value>::value>::template Factor<N> {};
+
+   template<typename T>
+   void apply(T*) { }
+
+   template<typename T>
+   void apply(const T*, T*) { }
+};
+
+/*! \brief %Transform is parallelized by the recursive %OpenMP tasks
+\tparam NT number of parallel threads
+\sa OpenMP, InTimeTask
+\ingroup gr_params
+
+OpenMP<NT> splits the transform into a factor for the threads, which is a multiple of NT
+or a divisor of N, and runs serially, if N has no such factor or N <= NT*NT.
+Here the transform is factorized like by Serial, and every step of the decimation in time
+spawns its sub-transforms and the chunks of its twiddle pass as %OpenMP tasks
+down to the length TaskCutoff. The runtime balances the tasks among the NT threads
+by work stealing, so any length from SwitchToTasks runs in parallel for any NT,
+e.g. \f$ 3^{10} \f$ on 4 threads or \f$ 2^{16} \f$ on 6 threads.
+The other algorithms and the reordering run on the %OpenMP threads like OpenMP<NT>.
+The IDs from 300 distinguish the policy from OpenMP<NT>.
+*/
+template<unsigned int NT>
+struct OpenMPTasks {
+   static const id_t ID = 299+NT;
+   static const ulong_t NParProc = NT;
+   typedef OMPTaskTeam Team;
+
+   template<long_t N>
+   struct ActualParall {
+      static const bool C = (N >= SwitchToTasks);
+      typedef typename Loki::Select<C,OpenMPTasks<NT>,Serial>::Result Result;
+   };
+
+   // used for in-place transforms only
+   template<typename NFact, typename T>
+   struct Swap {
+      static const ulong_t M = NFact::Head::first::value;
+      static const ulong_t P = NFact::Head::second::value;
+      typedef typename SwapSelect<M,P,T,NT,OMPTeam>::Result Result;
+   };
+
+   template<typename N>
+   struct Factor : public Factorize<N> {};
+
+   template<typename T>
+   void apply(T*) { }
+
+   template<typename T>
+   void apply(const T*, T*) { }
+};
+
+template<>
+struct OpenMPTasks<0>:public Serial { };
+
+template<>
+struct OpenMPTasks<1>:public Serial { };
+
+/// Number of threads of the parallelization policy with the given ID
+/*!
+The run-time plans (see RuntimeTransform) are created from the ID only,
+so the ID ranges of the policies are mapped back to their numbers of threads:
+Serial and OpenMP<NT> below 100, ThreadPool<NT> from 100, OpenMPRuntime<NTMax>
+from 200 and OpenMPTasks<NT> from 300. OpenMPRuntime takes RuntimeThreads::get()
+threads, but at most NTMax.
+*/
+inline int ParallThreads(const ulong_t parall_id)
+{
+   if (parall_id < 100)
+     return static_cast<int>(parall_id + 1);
+   if (parall_id < 200)
+     return static_cast<int>(parall_id - 99);
+   if (parall_id < 300)
+     return std::min(static_cast<int>(parall_id - 199), RuntimeThreads::get());
+   return static_cast<int>(parall_id - 299);
+}
+
   
 }  //namespace GFFT
 
@@ -0,0 +1,202 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Vladimir Mirnyy                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ ***************************************************************************/
+
+#ifndef __gfftpool_h
+#define __gfftpool_h
+
+/** \file
+    \brief Persistent pool of the worker threads for the policy ThreadPool
+*/
+
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+#include <algorithm>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace GFFT {
+
+/// Number of the idle iterations of a worker, before it falls asleep
+static const int PoolSpinCount = (1<<14);
+
+/// Hint to the processor inside of a spin-wait loop
+/*! Gives up the time slice after PoolSpinCount iterations, since the awaited thread
+    may wait for a free core.
+*/
+inline void spinPause(const int spin)
+{
+   if (spin < PoolSpinCount) {
+#if defined(__SSE2__)
+      _mm_pause();
+#endif
+   }
+   else
+      std::this_thread::yield();
+}
+
+/// Persistent pool of worker threads
+/*!
+\tparam NW number of the worker threads
+
+The workers are started by the first call of Instance() and live until the program exits.
+They wait for the next job spinning, so that a job starts within a fraction
+of a microsecond instead of the fork of a new %OpenMP team. After PoolSpinCount
+idle iterations they sleep on a condition variable to release the cores.
+The calling thread takes part in the job as the thread 0, and run() returns,
+when all the threads are done. This is the only barrier of the job.
+
+At most std::thread::hardware_concurrency() threads take part in a job.
+The job is run by the calling thread alone, if the pool is busy
+(a job started from another thread) or if it is called from inside of a job.
+*/
+template<int NW>
+class WorkerPool
+{
+   typedef void (*Task)(void*, int, int);
+
+   // The job word holds the job counter and the number of threads in the lowest byte.
+   // Zero threads stop the workers.
+   std::atomic<unsigned long> m_job;
+   std::atomic<int> m_pending;
+   Task m_task;
+   void* m_arg;
+
+   std::mutex m_mutex;
+   std::condition_variable m_wake;
+   std::mutex m_busy;
+   std::vector<std::thread> m_workers;
+   int m_maxthreads;
+
+   template<class F>
+   static void call(void* f, int tid, int nt)
+   {
+      (*static_cast<F*>(f))(tid, nt);
+   }
+
+   // true within a job, so that the nested jobs run serially
+   static bool& inside()
+   {
+      static thread_local bool flag = false;
+      return flag;
+   }
+
+   unsigned long wait(const unsigned long last)
+   {
+      unsigned long job;
+      for (int spin = 0; (job = m_job.load(std::memory_order_acquire)) == last; ++spin) {
+        if (spin < PoolSpinCount)
+          spinPause(spin);
+        else {
+          std::unique_lock<std::mutex> lock(m_mutex);
+          m_wake.wait(lock, [&]{ return m_job.load(std::memory_order_acquire) != last; });
+        }
+      }
+      return job;
+   }
+
+   void work(const int tid)
+   {
+      inside() = true;
+      unsigned long job = 0;
+      for (;;) {
+        job = wait(job);
+        const int nt = static_cast<int>(job & 0xFF);
+        if (nt == 0) return;
+        if (tid < nt) {
+          m_task(m_arg, tid, nt);
+          m_pending.fetch_sub(1, std::memory_order_acq_rel);
+        }
+      }
+   }
+
+   void publish(const int nt)
+   {
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const unsigned long count = (m_job.load(std::memory_order_relaxed) >> 8) + 1;
+        m_job.store((count << 8) | nt, std::memory_order_release);
+      }
+      m_wake.notify_all();
+   }
+
+   WorkerPool() : m_job(0), m_pending(0), m_task(0), m_arg(0),
+                  m_maxthreads(std::min<int>(NW+1, std::max(1u, std::thread::hardware_concurrency())))
+   {
+      for (int i = 1; i < m_maxthreads; ++i)
+        m_workers.push_back(std::thread(&WorkerPool::work, this, i));
+   }
+
+   WorkerPool(const WorkerPool&);
+   WorkerPool& operator=(const WorkerPool&);
+
+public:
+   ~WorkerPool()
+   {
+      publish(0);
+      for (size_t i = 0; i < m_workers.size(); ++i)
+        m_workers[i].join();
+   }
+
+   static WorkerPool& Instance()
+   {
+      static WorkerPool pool;
+      return pool;
+   }
+
+   /// Calls f(tid, nt) for tid = 0,...,nt-1 in parallel, nt <= min(nthreads, NW+1)
+   template<class F>
+   void run(const int nthreads, F& f)
+   {
+      const int nt = std::min(nthreads, m_maxthreads);
+      if (nt < 2 || inside() || !m_busy.try_lock()) {
+        f(0, 1);
+        return;
+      }
+      m_task = &call<F>;
+      m_arg = &f;
+      m_pending.store(nt-1, std::memory_order_relaxed);
+      inside() = true;
+      publish(nt);
+
+      f(0, nt);
+      for (int spin = 0; m_pending.load(std::memory_order_acquire) > 0; ++spin)
+        spinPause(spin);
+
+      inside() = false;
+      m_busy.unlock();
+   }
+};
+
+/// Team of the persistent pool for the parallelization policy ThreadPool<NT>
+/*! \sa OMPTeam, SerialTeam */
+template<unsigned int NT>
+struct PoolTeam
+{
+   static int threads(const int nthreads) { return nthreads; }
+
+   template<class F>
+   static void run(const int nthreads, F& f)
+   {
+      WorkerPool<NT-1>::Instance().run(nthreads, f);
+   }
+};
+
+}  //namespace GFFT
+
+#endif /*__gfftpool_h*/
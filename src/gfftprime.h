@@ -0,0 +1,482 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Vladimir Mirnyy                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ ***************************************************************************/
+
+#ifndef __gfftprime_h
+#define __gfftprime_h
+
+/** \file
+    \brief DFT algorithms for medium and large prime lengths
+*/
+
+#include <vector>
+#include <cmath>
+
+#include "gfftalg.h"
+#include "gfftstdalg.h"
+
+namespace GFFT {
+
+/// Power of two P, such that 2^P >= N
+template<long_t N, long_t P = 0, bool C = ((1L<<P) >= N)>
+struct CeilLog2 {
+   static const long_t value = CeilLog2<N,(P+1)>::value;
+};
+
+template<long_t N, long_t P>
+struct CeilLog2<N,P,true> {
+   static const long_t value = P;
+};
+
+
+/// Cyclic convolution with the precomputed Bluestein's chirp
+/*!
+\tparam N length of the DFT
+\tparam VType type of data element
+\tparam S sign of the transform: 1 - forward, -1 - backward
+
+The DFT of length N is expressed as the cyclic convolution of length L,
+which is the next power of two not less than 2N-1:
+\f$ X_k = c_k \sum_j (x_j c_j) \bar c_{k-j}\f$, where \f$ c_j = \exp(-\pi i S j^2/N) \f$.
+Two compile-time transforms InTimeOOP of length L are used for the convolution.
+The chirp and its spectrum scaled by 1/L are computed once and shared by all the instances.
+*/
+template<long_t N, typename VType, int S>
+class BluesteinCore
+{
+   typedef typename VType::ValueType T;
+   typedef typename VType::base_type BT;
+   static const int C = Loki::TypeTraits<T>::isStdFundamental ? 2 : 1;
+
+   static const long_t P = CeilLog2<2*N-1>::value;
+   typedef typename Factorize<PowerHolder<2,P> >::Result LFact;
+   typedef typename GetFirstRoot<(1L<<P),1,VType::Accuracy>::Result WF;
+   typedef typename GetFirstRoot<(1L<<P),-1,VType::Accuracy>::Result WB;
+
+   InTimeOOP<(1L<<P),LFact,VType,1,WF> m_forward;
+   InTimeOOP<(1L<<P),LFact,VType,-1,WB> m_backward;
+
+public:
+   /// Length of the convolution
+   static const long_t L = (1L<<P);
+
+private:
+   struct Tables {
+      std::vector<BT> chirp;
+      std::vector<T> spectrum;
+
+      Tables() : chirp(2*N), spectrum(C*L)
+      {
+         InTimeOOP<(1L<<P),LFact,VType,1,WF> forward;
+         std::vector<T> b(C*L);
+         BT* pb = reinterpret_cast<BT*>(&b[0]);
+         for (long_t j = 0; j < N; ++j) {
+            // j^2 mod 2N keeps the argument small
+            const long double a = M_PIl*((j*j) % (2*N))/N;
+            const BT cr = static_cast<BT>(std::cos(a));
+            const BT ci = static_cast<BT>(S*std::sin(a));
+            chirp[2*j]   = cr;
+            chirp[2*j+1] = -ci;
+            pb[2*j]   = cr/L;
+            pb[2*j+1] = ci/L;
+            if (j > 0) {
+               pb[2*(L-j)]   = cr/L;
+               pb[2*(L-j)+1] = ci/L;
+            }
+         }
+         forward.apply(&b[0], &spectrum[0]);
+      }
+   };
+
+   const BT* m_chirp;
+   const T* m_spectrum;
+
+public:
+   BluesteinCore()
+   : m_chirp(&SharedTable<Tables>::Instance().chirp[0]),
+     m_spectrum(&SharedTable<Tables>::Instance().spectrum[0]) { }
+
+   /// Chirp \f$ c_j \f$ as pair of real and imaginary parts
+   const BT* chirp() const { return m_chirp; }
+
+   /// Convolution of the array a of length L with the chirp
+   /*! \param a input data and result
+       \param buf work array of length L
+   */
+   void convolve(T* a, T* buf)
+   {
+      m_forward.apply(a, buf);
+      BT* pb = reinterpret_cast<BT*>(buf);
+      const BT* ps = reinterpret_cast<const BT*>(m_spectrum);
+      for (long_t i = 0; i < 2*L; i += 2) {
+         const BT re = pb[i]*ps[i] - pb[i+1]*ps[i+1];
+         pb[i+1] = pb[i]*ps[i+1] + pb[i+1]*ps[i];
+         pb[i] = re;
+      }
+      m_backward.apply(buf, a);
+   }
+};
+
+
+/// Out-of-place DFT of a large prime length using Bluestein's algorithm
+/*!
+\tparam N length of the data
+\tparam SI step in the source data
+\tparam DI step in the result data
+\tparam VType type of data element
+\tparam S sign of the transform (-1 for inverse)
+
+Replaces DFTk, if N exceeds BluesteinThreshold (see PrimeDFTk).
+The work array is taken from ThreadScratch to keep the class thread-safe.
+*/
+template<long_t N, long_t SI, long_t DI, typename VType, int S>
+class BluesteinDFTk
+{
+   typedef typename VType::ValueType T;
+   typedef typename VType::base_type BT;
+   static const int C = Loki::TypeTraits<T>::isStdFundamental ? 2 : 1;
+   static const long_t SI2 = SI*2/C;
+   static const long_t DI2 = DI*2/C;
+
+   typedef BluesteinCore<N,VType,S> Core;
+   static const long_t L = Core::L;
+   Core m_core;
+
+public:
+   void apply(const T* src, T* dst)
+   {
+      T* work = ThreadScratch<Core,T>::get(2*C*L);
+      BT* a = reinterpret_cast<BT*>(work);
+      const BT* s = reinterpret_cast<const BT*>(src);
+      const BT* c = m_core.chirp();
+      for (long_t j = 0; j < N; ++j) {
+         a[2*j]   = s[j*SI2]*c[2*j] - s[j*SI2+1]*c[2*j+1];
+         a[2*j+1] = s[j*SI2]*c[2*j+1] + s[j*SI2+1]*c[2*j];
+      }
+      // the padding is overwritten by the previous call
+      for (BT* p = a + 2*N; p < a + 2*L; ++p) *p = 0;
+
+      m_core.convolve(work, work + C*L);
+
+      BT* d = reinterpret_cast<BT*>(dst);
+      for (long_t k = 0; k < N; ++k) {
+         d[k*DI2]   = a[2*k]*c[2*k] - a[2*k+1]*c[2*k+1];
+         d[k*DI2+1] = a[2*k]*c[2*k+1] + a[2*k+1]*c[2*k];
+      }
+   }
+};
+
+/// In-place DFT of a large prime length using Bluestein's algorithm
+/*!
+\tparam N length of the data
+\tparam M step in the data
+\tparam VType type of data element
+\tparam S sign of the transform (-1 for inverse)
+
+Replaces DFTk_inp, if N exceeds BluesteinThreshold (see PrimeDFTk_inp).
+The twiddle factors are applied, while the input is multiplied by the chirp.
+*/
+template<long_t N, long_t M, typename VType, int S>
+class BluesteinDFTk_inp
+{
+   typedef typename VType::ValueType T;
+   typedef typename VType::base_type BT;
+   static const int C = Loki::TypeTraits<T>::isStdFundamental ? 2 : 1;
+   static const long_t M2 = M*2/C;
+
+   typedef BluesteinCore<N,VType,S> Core;
+   static const long_t L = Core::L;
+   Core m_core;
+
+   template<class LT>
+   void _apply(T* data, const LT* wr, const LT* wi, const int ws)
+   {
+      T* work = ThreadScratch<Core,T>::get(2*C*L);
+      BT* a = reinterpret_cast<BT*>(work);
+      BT* d = reinterpret_cast<BT*>(data);
+      const BT* c = m_core.chirp();
+      a[0] = d[0]*c[0] - d[1]*c[1];
+      a[1] = d[0]*c[1] + d[1]*c[0];
+      for (long_t j = 1; j < N; ++j) {
+         BT re = d[j*M2];
+         BT im = d[j*M2+1];
+         if (wr) {
+            const BT t = re*wr[(j-1)*ws] - im*wi[(j-1)*ws];
+            im = re*wi[(j-1)*ws] + im*wr[(j-1)*ws];
+            re = t;
+         }
+         a[2*j]   = re*c[2*j] - im*c[2*j+1];
+         a[2*j+1] = re*c[2*j+1] + im*c[2*j];
+      }
+      // the padding is overwritten by the previous call
+      for (BT* p = a + 2*N; p < a + 2*L; ++p) *p = 0;
+
+      m_core.convolve(work, work + C*L);
+
+      for (long_t k = 0; k < N; ++k) {
+         d[k*M2]   = a[2*k]*c[2*k] - a[2*k+1]*c[2*k+1];
+         d[k*M2+1] = a[2*k]*c[2*k+1] + a[2*k+1]*c[2*k];
+      }
+   }
+
+public:
+   void apply(T* data)
+   {
+      _apply(data, static_cast<const BT*>(0), static_cast<const BT*>(0), 1);
+   }
+
+   // twiddle factors as arrays of real and imaginary parts
+   template<class LT>
+   void apply(T* data, const LT* wr, const LT* wi)
+   {
+      _apply(data, wr, wi, 1);
+   }
+
+   // twiddle factors as array of std::complex
+   void apply(T* data, const T* w)
+   {
+      const BT* pw = reinterpret_cast<const BT*>(w);
+      _apply(data, pw, pw+1, 2);
+   }
+};
+
+/// Cyclic convolution of Rader's algorithm
+/*!
+\tparam N prime length of the DFT
+\tparam VType type of data element
+\tparam S sign of the transform: 1 - forward, -1 - backward
+
+For a primitive root g modulo N, the DFT of length N is reduced to
+the cyclic convolution of length N-1:
+\f$ X_{g^{-q}} = x_0 + \sum_r x_{g^r} w^{g^{r-q}} \f$, \f$ X_0 = \sum_j x_j \f$.
+The convolution is computed by a pair of compile-time transforms InTimeOOP.
+The generator permutations and the scaled spectrum of the roots 
+\f$ w^{g^{-r}} \f$ are computed once and shared by all the instances.
+*/
+template<long_t N, typename VType, int S>
+class RaderCore
+{
+   typedef typename VType::ValueType T;
+   typedef typename VType::base_type BT;
+   static const int C = Loki::TypeTraits<T>::isStdFundamental ? 2 : 1;
+   static const long_t L = N-1;
+
+   typedef typename Factorize<ulong_<L> >::Result LFact;
+   typedef typename GetFirstRoot<L,1,VType::Accuracy>::Result WF;
+   typedef typename GetFirstRoot<L,-1,VType::Accuracy>::Result WB;
+
+   InTimeOOP<L,LFact,VType,1,WF> m_forward;
+   InTimeOOP<L,LFact,VType,-1,WB> m_backward;
+
+   static long_t generator()
+   {
+      for (long_t g = 2; g < N; ++g) {
+         long_t k = 1, a = g;
+         while (a != 1) {
+            a = (a*g) % N;
+            ++k;
+         }
+         if (k == L) return g;
+      }
+      return 1;
+   }
+
+   struct Tables {
+      long_t in[L], out[L];
+      T spectrum[C*L];
+
+      Tables()
+      {
+         InTimeOOP<L,LFact,VType,1,WF> forward;
+         const long_t g = generator();
+         // g^(N-2) = g^(-1)
+         long_t ginv = 1;
+         for (long_t i = 0; i < N-2; ++i) ginv = (ginv*g) % N;
+
+         T b[C*L];
+         BT* pb = reinterpret_cast<BT*>(b);
+         long_t a = 1, ai = 1;
+         for (long_t r = 0; r < L; ++r) {
+            in[r] = a;
+            out[r] = ai;
+            const long double w = 2.L*M_PIl*ai/N;
+            pb[2*r]   = static_cast<BT>(std::cos(w)/L);
+            pb[2*r+1] = static_cast<BT>(-S*std::sin(w)/L);
+            a = (a*g) % N;
+            ai = (ai*ginv) % N;
+         }
+         forward.apply(b, spectrum);
+      }
+   };
+
+   const long_t *m_in, *m_out;
+   const T* m_spectrum;
+
+public:
+   RaderCore()
+   : m_in(SharedTable<Tables>::Instance().in),
+     m_out(SharedTable<Tables>::Instance().out),
+     m_spectrum(SharedTable<Tables>::Instance().spectrum) { }
+
+   /// Input index \f$ g^r \f$
+   long_t in(const long_t r) const { return m_in[r]; }
+   /// Output index \f$ g^{-q} \f$
+   long_t out(const long_t q) const { return m_out[q]; }
+
+   /// Convolution of the array a of length N-1 with the roots
+   /*! \param a input data and result
+       \param buf work array of length N-1
+       \param sum sum of a (real and imaginary part)
+   */
+   void convolve(T* a, T* buf, BT* sum)
+   {
+      m_forward.apply(a, buf);
+      BT* pb = reinterpret_cast<BT*>(buf);
+      sum[0] = pb[0];
+      sum[1] = pb[1];
+      const BT* ps = reinterpret_cast<const BT*>(m_spectrum);
+      for (long_t i = 0; i < 2*L; i += 2) {
+         const BT re = pb[i]*ps[i] - pb[i+1]*ps[i+1];
+         pb[i+1] = pb[i]*ps[i+1] + pb[i+1]*ps[i];
+         pb[i] = re;
+      }
+      m_backward.apply(buf, a);
+   }
+};
+
+
+/// Out-of-place DFT of a prime length using Rader's algorithm
+/*!
+\tparam N prime length of the data
+\tparam SI step in the source data
+\tparam DI step in the result data
+\tparam VType type of data element
+\tparam S sign of the transform (-1 for inverse)
+
+Replaces DFTk for RaderThreshold < N <= BluesteinThreshold (see PrimeDFTk).
+*/
+template<long_t N, long_t SI, long_t DI, typename VType, int S>
+class RaderDFTk
+{
+   typedef typename VType::ValueType T;
+   typedef typename VType::base_type BT;
+   static const int C = Loki::TypeTraits<T>::isStdFundamental ? 2 : 1;
+   static const long_t SI2 = SI*2/C;
+   static const long_t DI2 = DI*2/C;
+   static const long_t L = N-1;
+
+   RaderCore<N,VType,S> m_core;
+
+public:
+   void apply(const T* src, T* dst)
+   {
+      T work[2*C*L];
+      BT* a = reinterpret_cast<BT*>(work);
+      const BT* s = reinterpret_cast<const BT*>(src);
+      for (long_t r = 0; r < L; ++r) {
+         const long_t j = m_core.in(r)*SI2;
+         a[2*r]   = s[j];
+         a[2*r+1] = s[j+1];
+      }
+
+      BT sum[2];
+      m_core.convolve(work, work + C*L, sum);
+
+      BT* d = reinterpret_cast<BT*>(dst);
+      const BT x0r = s[0], x0i = s[1];
+      d[0] = x0r + sum[0];
+      d[1] = x0i + sum[1];
+      for (long_t q = 0; q < L; ++q) {
+         const long_t k = m_core.out(q)*DI2;
+         d[k]   = x0r + a[2*q];
+         d[k+1] = x0i + a[2*q+1];
+      }
+   }
+};
+
+/// In-place DFT of a prime length using Rader's algorithm
+/*!
+\tparam N prime length of the data
+\tparam M step in the data
+\tparam VType type of data element
+\tparam S sign of the transform (-1 for inverse)
+
+Replaces DFTk_inp for RaderThreshold < N <= BluesteinThreshold (see PrimeDFTk_inp).
+*/
+template<long_t N, long_t M, typename VType, int S>
+class RaderDFTk_inp
+{
+   typedef typename VType::ValueType T;
+   typedef typename VType::base_type BT;
+   static const int C = Loki::TypeTraits<T>::isStdFundamental ? 2 : 1;
+   static const long_t M2 = M*2/C;
+   static const long_t L = N-1;
+
+   RaderCore<N,VType,S> m_core;
+
+   template<class LT>
+   void _apply(T* data, const LT* wr, const LT* wi, const int ws)
+   {
+      T work[2*C*L];
+      BT* a = reinterpret_cast<BT*>(work);
+      BT* d = reinterpret_cast<BT*>(data);
+      for (long_t r = 0; r < L; ++r) {
+         const long_t j = m_core.in(r);
+         BT re = d[j*M2];
+         BT im = d[j*M2+1];
+         if (wr) {
+            const BT t = re*wr[(j-1)*ws] - im*wi[(j-1)*ws];
+            im = re*wi[(j-1)*ws] + im*wr[(j-1)*ws];
+            re = t;
+         }
+         a[2*r]   = re;
+         a[2*r+1] = im;
+      }
+
+      BT sum[2];
+      m_core.convolve(work, work + C*L, sum);
+
+      const BT x0r = d[0], x0i = d[1];
+      d[0] = x0r + sum[0];
+      d[1] = x0i + sum[1];
+      for (long_t q = 0; q < L; ++q) {
+         const long_t k = m_core.out(q)*M2;
+         d[k]   = x0r + a[2*q];
+         d[k+1] = x0i + a[2*q+1];
+      }
+   }
+
+public:
+   void apply(T* data)
+   {
+      _apply(data, static_cast<const BT*>(0), static_cast<const BT*>(0), 1);
+   }
+
+   // twiddle factors as arrays of real and imaginary parts
+   template<class LT>
+   void apply(T* data, const LT* wr, const LT* wi)
+   {
+      _apply(data, wr, wi, 1);
+   }
+
+   // twiddle factors as array of std::complex
+   void apply(T* data, const T* w)
+   {
+      const BT* pw = reinterpret_cast<const BT*>(w);
+      _apply(data, pw, pw+1, 2);
+   }
+};
+
+}  //namespace GFFT
+
+#endif /*__gfftprime_h*/
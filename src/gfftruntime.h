@@ -0,0 +1,728 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Vladimir Mirnyy                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ ***************************************************************************/
+
+#ifndef __gfftruntime_h
+#define __gfftruntime_h
+
+/** \file
+    \brief Run-time planned transforms for the lengths not generated at compile-time
+*/
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#include "gfftpolicy.h"
+#include "gfftspec_inp.h"
+#include "gfftstdspec.h"
+
+namespace GFFT {
+
+/// Abstract butterfly of a run-time planned transform
+/*!
+\tparam VType type of data element
+
+The twiddle factors of one stage are stored consecutively for every
+index j=1,...,m-1 of the butterfly: K-1 real parts followed by K-1
+imaginary parts for the arrays of real numbers and K-1 complex numbers
+for std::complex. The index j=0 has trivial twiddle factors.
+*/
+template<typename VType>
+class RuntimeRadix {
+   typedef typename VType::ValueType T;
+public:
+   virtual ~RuntimeRadix() {}
+
+   /// K-point DFTs of the \a blocks consecutive groups of K elements
+   virtual void leaf(T* data, const long_t blocks) = 0;
+
+   /// Combines K transforms of length m in each of the \a blocks groups of K*m elements
+   virtual void twiddle(T* data, const long_t blocks, const long_t m, const T* tw) = 0;
+};
+
+/// Butterfly of a compile-time radix K
+/*!
+\tparam K radix
+\tparam VType type of data element
+\tparam S sign of the transform: 1 - forward, -1 - backward
+
+The short-radix kernel DFTk_inp is reused here. Since its step is
+a compile-time constant, the strided elements of the butterfly are
+gathered into a local buffer of K elements.
+*/
+template<long_t K, typename VType, int S,
+bool isStd = Loki::TypeTraits<typename VType::ValueType>::isStdFundamental>
+class RuntimeRadixK;
+
+template<long_t K, typename VType, int S>
+class RuntimeRadixK<K,VType,S,true> : public RuntimeRadix<VType>
+{
+   typedef typename VType::ValueType T;
+   static const long_t K2 = 2*K;
+   static const long_t W2 = 2*(K-1);
+
+   DFTk_inp<K,2,VType,S> spec;
+
+public:
+   void leaf(T* data, const long_t blocks)
+   {
+      for (T* p = data; p < data + blocks*K2; p += K2)
+         spec.apply(p);
+   }
+
+   void twiddle(T* data, const long_t blocks, const long_t m, const T* tw)
+   {
+      const long_t m2 = 2*m;
+      const long_t step = K*m2;
+      T buf[K2];
+      for (T* p = data; p < data + blocks*step; p += step) {
+         for (long_t j = 0; j < m2; j += 2) {
+            for (long_t k = 0; k < K; ++k) {
+               buf[2*k]   = p[j + k*m2];
+               buf[2*k+1] = p[j + k*m2 + 1];
+            }
+            if (j == 0)
+               spec.apply(buf);
+            else {
+               const T* w = tw + (j/2-1)*W2;
+               spec.apply(buf, w, w + K-1);
+            }
+            for (long_t k = 0; k < K; ++k) {
+               p[j + k*m2]     = buf[2*k];
+               p[j + k*m2 + 1] = buf[2*k+1];
+            }
+         }
+      }
+   }
+};
+
+template<long_t K, typename VType, int S>
+class RuntimeRadixK<K,VType,S,false> : public RuntimeRadix<VType>
+{
+   typedef typename VType::ValueType CT;
+
+   DFTk_inp<K,1,VType,S> spec;
+
+public:
+   void leaf(CT* data, const long_t blocks)
+   {
+      for (CT* p = data; p < data + blocks*K; p += K)
+         spec.apply(p);
+   }
+
+   void twiddle(CT* data, const long_t blocks, const long_t m, const CT* tw)
+   {
+      const long_t step = K*m;
+      CT buf[K];
+      for (CT* p = data; p < data + blocks*step; p += step) {
+         for (long_t j = 0; j < m; ++j) {
+            for (long_t k = 0; k < K; ++k)
+               buf[k] = p[j + k*m];
+            if (j == 0)
+               spec.apply(buf);
+            else
+               spec.apply(buf, tw + (j-1)*(K-1));
+            for (long_t k = 0; k < K; ++k)
+               p[j + k*m] = buf[k];
+         }
+      }
+   }
+};
+
+/// Butterfly of a large prime radix known at run-time only
+/*!
+\tparam VType type of data element
+
+Gathers the strided elements of each butterfly and applies the twiddle
+factors, while the DFT of the prime length itself is computed
+by the derived class as a cyclic convolution.
+\sa RuntimeRadixRader, RuntimeRadixBluestein
+*/
+template<typename VType>
+class RuntimeRadixLarge : public RuntimeRadix<VType>
+{
+   typedef typename VType::ValueType T;
+   typedef typename VType::base_type BT;
+   static const bool isStd = Loki::TypeTraits<T>::isStdFundamental;
+
+protected:
+   const long_t m_k;
+
+   /// DFT of m_k elements of the step m2 (in real numbers) multiplied by the twiddle factors
+   virtual void transform(BT* data, const long_t m2, const BT* wr, const BT* wi, const long_t ws) = 0;
+
+public:
+   RuntimeRadixLarge(const long_t k) : m_k(k) { }
+
+   void leaf(T* data, const long_t blocks)
+   {
+      BT* d = reinterpret_cast<BT*>(data);
+      for (long_t b = 0; b < blocks; ++b)
+         transform(d + 2*b*m_k, 2, 0, 0, 0);
+   }
+
+   void twiddle(T* data, const long_t blocks, const long_t m, const T* tw)
+   {
+      BT* d = reinterpret_cast<BT*>(data);
+      const BT* w = reinterpret_cast<const BT*>(tw);
+      const long_t m2 = 2*m;
+      const long_t step = m_k*m2;
+      // layout of the twiddles, see RuntimeRadix
+      const long_t ws = isStd ? 1 : 2;
+      const long_t wi = isStd ? m_k-1 : 1;
+      for (BT* p = d; p < d + blocks*step; p += step) {
+         transform(p, m2, 0, 0, 0);
+         for (long_t j = 1; j < m; ++j) {
+            const BT* wj = w + (j-1)*2*(m_k-1);
+            transform(p + 2*j, m2, wj, wj + wi, ws);
+         }
+      }
+   }
+};
+
+template<typename VType, int S>
+class RuntimeRadixRader;
+
+template<typename VType, int S>
+class RuntimeRadixBluestein;
+
+
+/// Abstract run-time planned complex-valued DFT
+template<typename VType>
+class RuntimeEngine {
+   typedef typename VType::ValueType T;
+public:
+   virtual void apply(const T* src, T* dst) = 0;
+   virtual ~RuntimeEngine() {}
+};
+
+/// Mixed-radix decimation-in-time FFT planned at run-time
+/*!
+\tparam VType type of data element
+\tparam S sign of the transform: 1 - forward, -1 - backward
+
+The length is factorized in the constructor. The order of factors
+is the same as in the compile-time algorithm InTimeOOP: the smallest factor
+is the outermost one, the largest factor is the last one (the leaf DFT).
+The input permutation and twiddle factors of every stage are precomputed
+as well, so that the transform consists of the permutation
+and one call of the butterfly per stage. The prime factors up to 13
+have compile-time kernels, the larger ones are transformed by Rader's
+algorithm, if p-1 factorizes into those, otherwise by Bluestein's algorithm.
+*/
+template<typename VType, int S>
+class RuntimeDIT : public RuntimeEngine<VType>
+{
+   typedef typename VType::ValueType T;
+   typedef typename VType::base_type BT;
+   static const int C = Loki::TypeTraits<T>::isStdFundamental ? 2 : 1;
+
+   const long_t m_n;
+   std::vector<long_t> m_factor;
+   std::vector<RuntimeRadix<VType>*> m_radix;
+   std::vector<std::vector<T> > m_tw;
+   std::vector<long_t> m_perm;
+
+   RuntimeDIT(const RuntimeDIT&);
+   RuntimeDIT& operator=(const RuntimeDIT&);
+
+   static RuntimeRadix<VType>* createRadix(const long_t k)
+   {
+      switch (k) {
+         case 2: return new RuntimeRadixK<2,VType,S>();
+         case 3: return new RuntimeRadixK<3,VType,S>();
+         case 5: return new RuntimeRadixK<5,VType,S>();
+         case 7: return new RuntimeRadixK<7,VType,S>();
+         case 11: return new RuntimeRadixK<11,VType,S>();
+         case 13: return new RuntimeRadixK<13,VType,S>();
+      }
+      if (k <= BluesteinThreshold && isSmooth(k-1))
+         return new RuntimeRadixRader<VType,S>(k);
+      return new RuntimeRadixBluestein<VType,S>(k);
+   }
+
+public:
+   /// Whether all prime factors of n have the compile-time kernels in createRadix
+   static bool isSmooth(long_t n)
+   {
+      static const long_t p[] = { 2, 3, 5, 7, 11, 13 };
+      for (int i = 0; i < 6; ++i)
+         while (n%p[i] == 0) n /= p[i];
+      return n == 1;
+   }
+
+private:
+   // simulates the recursion of InTimeOOP
+   void permutation(const std::size_t st, const long_t n, const long_t src,
+                    const long_t dst, const long_t lastk)
+   {
+      const long_t k = m_factor[st];
+      const long_t m = n/k;
+      if (m == 1)
+         for (long_t i = 0; i < k; ++i)
+            m_perm[dst + i] = src + i*lastk;
+      else
+         for (long_t i = 0; i < k; ++i)
+            permutation(st+1, m, src + i*lastk, dst + i*m, lastk*k);
+   }
+
+   void twiddles(std::vector<T>& tw, const long_t k, const long_t m)
+   {
+      const long double pi2 = 2.L*M_PIl/(k*m);
+      tw.resize((m-1)*(k-1)*C);
+      BT* w = reinterpret_cast<BT*>(tw.empty() ? 0 : &tw[0]);
+      for (long_t j = 1; j < m; ++j, w += 2*(k-1))
+         for (long_t i = 1; i < k; ++i) {
+            const BT wr = static_cast<BT>(std::cos(pi2*i*j));
+            const BT wi = static_cast<BT>(-S*std::sin(pi2*i*j));
+            if (C == 2) {
+               w[i-1] = wr;
+               w[k-1+i-1] = wi;
+            }
+            else {
+               w[2*(i-1)] = wr;
+               w[2*(i-1)+1] = wi;
+            }
+         }
+   }
+
+public:
+   RuntimeDIT(const long_t n) : m_n(n), m_perm(n)
+   {
+      long_t r = n;
+      for (long_t p = 2; p*p <= r; ++p)
+         while (r%p == 0) {
+            m_factor.push_back(p);
+            r /= p;
+         }
+      if (r > 1 || m_factor.empty())
+         m_factor.push_back(r);
+
+      permutation(0, n, 0, 0, 1);
+
+      long_t m = 1;
+      m_tw.resize(m_factor.size());
+      for (std::size_t i = m_factor.size(); i > 0; --i) {
+         m_radix.push_back(createRadix(m_factor[i-1]));
+         twiddles(m_tw[i-1], m_factor[i-1], m);
+         m *= m_factor[i-1];
+      }
+   }
+
+   ~RuntimeDIT()
+   {
+      for (std::size_t i = 0; i < m_radix.size(); ++i)
+         delete m_radix[i];
+   }
+
+   long_t size() const { return m_n; }
+
+   void apply(const T* src, T* dst)
+   {
+      for (long_t i = 0; i < m_n; ++i)
+         for (int c = 0; c < C; ++c)
+            dst[i*C + c] = src[m_perm[i]*C + c];
+
+      if (m_n == 1) return;
+
+      // m_radix is stored in the order of stages, starting from the leaf
+      const std::size_t ns = m_factor.size();
+      long_t m = m_factor[ns-1];
+      m_radix[0]->leaf(dst, m_n/m);
+      for (std::size_t i = 1; i < ns; ++i) {
+         const long_t k = m_factor[ns-1-i];
+         const T* tw = m_tw[ns-1-i].empty() ? 0 : &m_tw[ns-1-i][0];
+         m_radix[i]->twiddle(dst, m_n/(k*m), m, tw);
+         m *= k;
+      }
+   }
+};
+
+
+/// Butterfly of a prime radix by Rader's algorithm
+/*!
+\tparam VType type of data element
+\tparam S sign of the transform: 1 - forward, -1 - backward
+
+Run-time version of RaderCore. The cyclic convolution of the length p-1
+is computed by a pair of RuntimeDIT, which have the compile-time kernels only.
+*/
+template<typename VType, int S>
+class RuntimeRadixRader : public RuntimeRadixLarge<VType>
+{
+   typedef typename VType::ValueType T;
+   typedef typename VType::base_type BT;
+   static const int C = Loki::TypeTraits<T>::isStdFundamental ? 2 : 1;
+   using RuntimeRadixLarge<VType>::m_k;
+
+   const long_t m_l;
+   std::vector<long_t> m_in, m_out;
+   std::vector<T> m_spectrum;
+   RuntimeDIT<VType,1> m_forward;
+   RuntimeDIT<VType,-1> m_backward;
+
+   static long_t generator(const long_t n)
+   {
+      for (long_t g = 2; g < n; ++g) {
+         long_t k = 1, a = g;
+         while (a != 1) {
+            a = (a*g) % n;
+            ++k;
+         }
+         if (k == n-1) return g;
+      }
+      return 1;
+   }
+
+   void transform(BT* data, const long_t m2, const BT* wr, const BT* wi, const long_t ws)
+   {
+      T* work = ThreadScratch<RuntimeRadixLarge<VType>,T>::get(2*C*m_l);
+      BT* a = reinterpret_cast<BT*>(work);
+      for (long_t r = 0; r < m_l; ++r) {
+         const long_t j = m_in[r];
+         BT re = data[j*m2];
+         BT im = data[j*m2+1];
+         if (wr) {
+            const BT t = re*wr[(j-1)*ws] - im*wi[(j-1)*ws];
+            im = re*wi[(j-1)*ws] + im*wr[(j-1)*ws];
+            re = t;
+         }
+         a[2*r]   = re;
+         a[2*r+1] = im;
+      }
+
+      m_forward.apply(work, work + C*m_l);
+      BT* pb = reinterpret_cast<BT*>(work + C*m_l);
+      const BT sr = pb[0], si = pb[1];
+      const BT* ps = reinterpret_cast<const BT*>(&m_spectrum[0]);
+      for (long_t i = 0; i < 2*m_l; i += 2) {
+         const BT re = pb[i]*ps[i] - pb[i+1]*ps[i+1];
+         pb[i+1] = pb[i]*ps[i+1] + pb[i+1]*ps[i];
+         pb[i] = re;
+      }
+      m_backward.apply(work + C*m_l, work);
+
+      const BT x0r = data[0], x0i = data[1];
+      data[0] = x0r + sr;
+      data[1] = x0i + si;
+      for (long_t q = 0; q < m_l; ++q) {
+         const long_t k = m_out[q]*m2;
+         data[k]   = x0r + a[2*q];
+         data[k+1] = x0i + a[2*q+1];
+      }
+   }
+
+public:
+   RuntimeRadixRader(const long_t k)
+   : RuntimeRadixLarge<VType>(k), m_l(k-1), m_in(k-1), m_out(k-1),
+     m_spectrum(C*(k-1)), m_forward(k-1), m_backward(k-1)
+   {
+      const long_t g = generator(k);
+      // g^(k-2) = g^(-1)
+      long_t ginv = 1;
+      for (long_t i = 0; i < k-2; ++i) ginv = (ginv*g) % k;
+
+      std::vector<T> b(C*m_l);
+      BT* pb = reinterpret_cast<BT*>(&b[0]);
+      long_t a = 1, ai = 1;
+      for (long_t r = 0; r < m_l; ++r) {
+         m_in[r] = a;
+         m_out[r] = ai;
+         const long double w = 2.L*M_PIl*ai/k;
+         pb[2*r]   = static_cast<BT>(std::cos(w)/m_l);
+         pb[2*r+1] = static_cast<BT>(-S*std::sin(w)/m_l);
+         a = (a*g) % k;
+         ai = (ai*ginv) % k;
+      }
+      m_forward.apply(&b[0], &m_spectrum[0]);
+   }
+};
+
+/// Butterfly of a prime radix by Bluestein's algorithm
+/*!
+\tparam VType type of data element
+\tparam S sign of the transform: 1 - forward, -1 - backward
+
+Run-time version of BluesteinCore. The cyclic convolution of the length L,
+which is the next power of two not less than 2p-1, is computed
+by a pair of RuntimeDIT.
+*/
+template<typename VType, int S>
+class RuntimeRadixBluestein : public RuntimeRadixLarge<VType>
+{
+   typedef typename VType::ValueType T;
+   typedef typename VType::base_type BT;
+   static const int C = Loki::TypeTraits<T>::isStdFundamental ? 2 : 1;
+   using RuntimeRadixLarge<VType>::m_k;
+
+   static long_t length(const long_t k)
+   {
+      long_t l = 1;
+      while (l < 2*k-1) l *= 2;
+      return l;
+   }
+
+   const long_t m_l;
+   std::vector<BT> m_chirp;
+   std::vector<T> m_spectrum;
+   RuntimeDIT<VType,1> m_forward;
+   RuntimeDIT<VType,-1> m_backward;
+
+   void transform(BT* data, const long_t m2, const BT* wr, const BT* wi, const long_t ws)
+   {
+      T* work = ThreadScratch<RuntimeRadixLarge<VType>,T>::get(2*C*m_l);
+      BT* a = reinterpret_cast<BT*>(work);
+      const BT* c = &m_chirp[0];
+      a[0] = data[0]*c[0] - data[1]*c[1];
+      a[1] = data[0]*c[1] + data[1]*c[0];
+      for (long_t j = 1; j < m_k; ++j) {
+         BT re = data[j*m2];
+         BT im = data[j*m2+1];
+         if (wr) {
+            const BT t = re*wr[(j-1)*ws] - im*wi[(j-1)*ws];
+            im = re*wi[(j-1)*ws] + im*wr[(j-1)*ws];
+            re = t;
+         }
+         a[2*j]   = re*c[2*j] - im*c[2*j+1];
+         a[2*j+1] = re*c[2*j+1] + im*c[2*j];
+      }
+      // the work array is reused by the other butterflies
+      for (BT* p = a + 2*m_k; p < a + 2*m_l; ++p) *p = 0;
+
+      m_forward.apply(work, work + C*m_l);
+      BT* pb = reinterpret_cast<BT*>(work + C*m_l);
+      const BT* ps = reinterpret_cast<const BT*>(&m_spectrum[0]);
+      for (long_t i = 0; i < 2*m_l; i += 2) {
+         const BT re = pb[i]*ps[i] - pb[i+1]*ps[i+1];
+         pb[i+1] = pb[i]*ps[i+1] + pb[i+1]*ps[i];
+         pb[i] = re;
+      }
+      m_backward.apply(work + C*m_l, work);
+
+      for (long_t k = 0; k < m_k; ++k) {
+         data[k*m2]   = a[2*k]*c[2*k] - a[2*k+1]*c[2*k+1];
+         data[k*m2+1] = a[2*k]*c[2*k+1] + a[2*k+1]*c[2*k];
+      }
+   }
+
+public:
+   RuntimeRadixBluestein(const long_t k)
+   : RuntimeRadixLarge<VType>(k), m_l(length(k)), m_chirp(2*k),
+     m_spectrum(C*m_l), m_forward(m_l), m_backward(m_l)
+   {
+      std::vector<T> b(C*m_l);
+      BT* pb = reinterpret_cast<BT*>(&b[0]);
+      for (long_t j = 0; j < k; ++j) {
+         // j^2 mod 2k keeps the argument small
+         const long double a = M_PIl*((j*j) % (2*k))/k;
+         const BT cr = static_cast<BT>(std::cos(a));
+         const BT ci = static_cast<BT>(S*std::sin(a));
+         m_chirp[2*j]   = cr;
+         m_chirp[2*j+1] = -ci;
+         pb[2*j]   = cr/m_l;
+         pb[2*j+1] = ci/m_l;
+         if (j > 0) {
+            pb[2*(m_l-j)]   = cr/m_l;
+            pb[2*(m_l-j)+1] = ci/m_l;
+         }
+      }
+      m_forward.apply(&b[0], &m_spectrum[0]);
+   }
+};
+
+
+/// Run-time version of the class Separate
+/*!
+\tparam VType type of data element
+
+Reordering of data for real-valued transforms of the run-time length n.
+The data are accessed as the array of 2n real numbers.
+*/
+template<typename VType>
+class RuntimeSeparate {
+   typedef typename VType::ValueType T;
+   typedef typename VType::base_type BT;
+public:
+   static void apply(T* d, const long_t n, const int s)
+   {
+      BT* data = reinterpret_cast<BT*>(d);
+      long_t i,i1,i2,i3,i4;
+      long double wtemp,wr,wi,wpr,wpi;
+      long double h1r,h1i,h2r,h2i,h3r,h3i;
+      const int m = (s==1) ? 2 : 1;
+      wtemp = std::sin(M_PIl/(2*n));
+      wpr = -2.*wtemp*wtemp;
+      wpi = -s*std::sin(M_PIl/n);
+      wr = 1.+wpr;
+      wi = wpi;
+      for (i=1; i<(n+1)/2; ++i) {
+        i1 = i+i;
+        i2 = i1+1;
+        i3 = 2*n-i1;
+        i4 = i3+1;
+        h1r = 0.5*(data[i1]+data[i3]);
+        h1i = 0.5*(data[i2]-data[i4]);
+        h2r = s*0.5*(data[i2]+data[i4]);
+        h2i =-s*0.5*(data[i1]-data[i3]);
+        h3r = wr*h2r - wi*h2i;
+        h3i = wr*h2i + wi*h2r;
+        data[i1] = h1r + h3r;
+        data[i2] = h1i + h3i;
+        data[i3] = h1r - h3r;
+        data[i4] =-h1i + h3i;
+
+        wtemp = wr;
+        wr += wr*wpr - wi*wpi;
+        wi += wi*wpr + wtemp*wpi;
+      }
+      h1r = data[0];
+      data[0] = m*0.5*(h1r + data[1]);
+      data[1] = m*0.5*(h1r - data[1]);
+
+      if (n%2 == 0) data[n+1] = -data[n+1];
+   }
+};
+
+
+/// Transform of the length n planned at run-time
+/*!
+\tparam VType type of data element
+
+Implements DFT, IDFT, RDFT and IRDFT with the same conventions
+as the compile-time transforms. The work arrays are taken from ThreadScratch,
+so that one plan serves several threads without allocations in apply.
+*/
+template<typename VType>
+class RuntimePlan {
+   typedef typename VType::ValueType T;
+   typedef typename VType::base_type BT;
+   static const int C = Loki::TypeTraits<T>::isStdFundamental ? 2 : 1;
+
+   const long_t m_n;
+   const id_t m_type;
+   RuntimeEngine<VType>* m_engine;
+
+   RuntimePlan(const RuntimePlan&);
+   RuntimePlan& operator=(const RuntimePlan&);
+
+   void scale(T* data) const
+   {
+      BT* d = reinterpret_cast<BT*>(data);
+      const BT f = static_cast<BT>(1)/m_n;
+      for (BT* i = d; i < d + 2*m_n; ++i) *i *= f;
+   }
+
+public:
+   /// Whether transform type \a type_id can be planned at run-time
+   static bool supports(const id_t type_id)
+   {
+      return !IsSplitComplex<VType>::value
+          && (type_id == DFT::ID || type_id == IDFT::ID
+          || type_id == RDFT::ID || type_id == IRDFT::ID);
+   }
+
+   RuntimePlan(const long_t n, const id_t type_id)
+   : m_n(n), m_type(type_id), m_engine(0)
+   {
+      if (m_type == DFT::ID || m_type == RDFT::ID)
+         m_engine = new RuntimeDIT<VType,1>(n);
+      else
+         m_engine = new RuntimeDIT<VType,-1>(n);
+   }
+
+   ~RuntimePlan() { delete m_engine; }
+
+   void apply(const T* src, T* dst)
+   {
+      if (m_type == IRDFT::ID) {
+         T* buf = ThreadScratch<RuntimePlan,T,1>::get(C*m_n);
+         std::copy(src, src + C*m_n, buf);
+         RuntimeSeparate<VType>::apply(buf, m_n, -1);
+         m_engine->apply(buf, dst);
+      }
+      else
+         m_engine->apply(src, dst);
+
+      if (m_type == RDFT::ID)
+         RuntimeSeparate<VType>::apply(dst, m_n, 1);
+      else if (m_type == IDFT::ID || m_type == IRDFT::ID)
+         scale(dst);
+   }
+
+   void apply(T* data)
+   {
+      T* buf = ThreadScratch<RuntimePlan,T>::get(C*m_n);
+      std::copy(data, data + C*m_n, buf);
+      apply(buf, data);
+   }
+};
+
+/// Object returned by the object factory, if the transform was not generated
+/*!
+\tparam VType type of data element
+\tparam Place IN_PLACE or OUT_OF_PLACE
+
+The batches of transforms run in parallel with the number of threads
+given to the constructor.
+
+\sa GenerateTransform::CreateTransformObject
+*/
+template<class VType, class Place>
+class RuntimeTransform;
+
+template<class VType>
+class RuntimeTransform<VType,IN_PLACE>
+: public IN_PLACE::Interface<typename VType::ValueType>::Result
+{
+   typedef typename VType::ValueType T;
+   static const int C = Loki::TypeTraits<T>::isStdFundamental ? 2 : 1;
+   const long_t m_n;
+   const int m_nthreads;
+   RuntimePlan<VType> m_plan;
+public:
+   RuntimeTransform(const long_t n, const id_t type_id, const int nthreads = 1)
+   : m_n(n), m_nthreads(nthreads), m_plan(n, type_id) { }
+
+   void fft(T* data) { m_plan.apply(data); }
+
+   void fft_many(T* data, long_t howmany, long_t stride, long_t dist)
+   {
+      BatchLoop<C>::apply(m_plan, data, 2*m_n, 2*m_n, howmany, stride, dist, m_nthreads);
+   }
+};
+
+template<class VType>
+class RuntimeTransform<VType,OUT_OF_PLACE>
+: public OUT_OF_PLACE::Interface<typename VType::ValueType>::Result
+{
+   typedef typename VType::ValueType T;
+   static const int C = Loki::TypeTraits<T>::isStdFundamental ? 2 : 1;
+   const long_t m_n;
+   const int m_nthreads;
+   RuntimePlan<VType> m_plan;
+public:
+   RuntimeTransform(const long_t n, const id_t type_id, const int nthreads = 1)
+   : m_n(n), m_nthreads(nthreads), m_plan(n, type_id) { }
+
+   void fft(const T* src, T* dst) { m_plan.apply(src, dst); }
+
+   void fft_many(const T* src, T* dst, long_t howmany, long_t stride, long_t dist)
+   {
+      BatchLoop<C>::apply(m_plan, src, dst, 2*m_n, 2*m_n, howmany, stride, dist, m_nthreads);
+   }
+};
+
+}  //namespace GFFT
+
+#endif /*__gfftruntime_h*/
@@ -0,0 +1,340 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Vladimir Mirnyy                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ ***************************************************************************/
+
+#ifndef __gfftsimd_h
+#define __gfftsimd_h
+
+/** \file
+    \brief AVX and AVX-512 kernels of the radix-2 and radix-3 butterflies
+           and vector operations for the codelets of the length 4, 8, 16
+
+The kernels are compiled, if the compiler targets AVX (__AVX__) or AVX-512 (__AVX512F__),
+e.g. with -march=native. Define GFFT_NO_SIMD to use the scalar code only.
+*/
+
+#include <vector>
+#include <cmath>
+
+#include "sint.h"
+#include "twiddles.h"
+
+#if !defined(GFFT_NO_SIMD) && (defined(__AVX__) || defined(__AVX512F__))
+#include <immintrin.h>
+#endif
+
+namespace GFFT {
+
+/// Vector operations on interleaved complex numbers
+/*!
+\tparam T floating-point type of the real and imaginary parts
+
+Width is the number of complex numbers in one register.
+It is one, if there are no vector instructions for T, and the scalar code is used then.
+*/
+template<typename T>
+struct SIMDTraits {
+   static const long_t Width = 1;
+};
+
+#if !defined(GFFT_NO_SIMD) && defined(__AVX512F__)
+
+template<>
+struct SIMDTraits<double> {
+   typedef __m512d V;
+   static const long_t Width = 4;
+
+   static V load(const double* p) { return _mm512_loadu_pd(p); }
+   static void store(double* p, const V a) { _mm512_storeu_pd(p, a); }
+   static V set1(const double a) { return _mm512_set1_pd(a); }
+   static V add(const V a, const V b) { return _mm512_add_pd(a, b); }
+   static V sub(const V a, const V b) { return _mm512_sub_pd(a, b); }
+   static V mul(const V a, const V b) { return _mm512_mul_pd(a, b); }
+   // (re, im) -> (im, re)
+   static V swap(const V a) { return _mm512_permute_pd(a, 0x55); }
+   // (a.re - b.re, a.im + b.im)
+   static V addsub(const V a, const V b) { return _mm512_fmaddsub_pd(a, set1(1), b); }
+   // complex product a*w
+   static V cmul(const V a, const V w)
+   {
+      return _mm512_fmaddsub_pd(a, _mm512_movedup_pd(w),
+                                _mm512_mul_pd(swap(a), _mm512_permute_pd(w, 0xFF)));
+   }
+   // complex product a*conj(w)
+   static V cmulc(const V a, const V w)
+   {
+      return _mm512_fmsubadd_pd(a, _mm512_movedup_pd(w),
+                                _mm512_mul_pd(swap(a), _mm512_permute_pd(w, 0xFF)));
+   }
+};
+
+template<>
+struct SIMDTraits<float> {
+   typedef __m512 V;
+   static const long_t Width = 8;
+
+   static V load(const float* p) { return _mm512_loadu_ps(p); }
+   static void store(float* p, const V a) { _mm512_storeu_ps(p, a); }
+   static V set1(const float a) { return _mm512_set1_ps(a); }
+   static V add(const V a, const V b) { return _mm512_add_ps(a, b); }
+   static V sub(const V a, const V b) { return _mm512_sub_ps(a, b); }
+   static V mul(const V a, const V b) { return _mm512_mul_ps(a, b); }
+   static V swap(const V a) { return _mm512_permute_ps(a, 0xB1); }
+   static V addsub(const V a, const V b) { return _mm512_fmaddsub_ps(a, set1(1), b); }
+   static V cmul(const V a, const V w)
+   {
+      return _mm512_fmaddsub_ps(a, _mm512_moveldup_ps(w),
+                                _mm512_mul_ps(swap(a), _mm512_movehdup_ps(w)));
+   }
+   static V cmulc(const V a, const V w)
+   {
+      return _mm512_fmsubadd_ps(a, _mm512_moveldup_ps(w),
+                                _mm512_mul_ps(swap(a), _mm512_movehdup_ps(w)));
+   }
+};
+
+#elif !defined(GFFT_NO_SIMD) && defined(__AVX__)
+
+template<>
+struct SIMDTraits<double> {
+   typedef __m256d V;
+   static const long_t Width = 2;
+
+   static V load(const double* p) { return _mm256_loadu_pd(p); }
+   static void store(double* p, const V a) { _mm256_storeu_pd(p, a); }
+   static V set1(const double a) { return _mm256_set1_pd(a); }
+   static V add(const V a, const V b) { return _mm256_add_pd(a, b); }
+   static V sub(const V a, const V b) { return _mm256_sub_pd(a, b); }
+   static V mul(const V a, const V b) { return _mm256_mul_pd(a, b); }
+   static V swap(const V a) { return _mm256_permute_pd(a, 0x5); }
+   static V addsub(const V a, const V b) { return _mm256_addsub_pd(a, b); }
+   static V cmul(const V a, const V w)
+   {
+      return _mm256_addsub_pd(_mm256_mul_pd(a, _mm256_movedup_pd(w)),
+                              _mm256_mul_pd(swap(a), _mm256_permute_pd(w, 0xF)));
+   }
+   // (p.re + q.re, p.im - q.im) obtained by addsub of the swapped operands
+   static V cmulc(const V a, const V w)
+   {
+      return swap(_mm256_addsub_pd(swap(_mm256_mul_pd(a, _mm256_movedup_pd(w))),
+                                   _mm256_mul_pd(a, _mm256_permute_pd(w, 0xF))));
+   }
+};
+
+template<>
+struct SIMDTraits<float> {
+   typedef __m256 V;
+   static const long_t Width = 4;
+
+   static V load(const float* p) { return _mm256_loadu_ps(p); }
+   static void store(float* p, const V a) { _mm256_storeu_ps(p, a); }
+   static V set1(const float a) { return _mm256_set1_ps(a); }
+   static V add(const V a, const V b) { return _mm256_add_ps(a, b); }
+   static V sub(const V a, const V b) { return _mm256_sub_ps(a, b); }
+   static V mul(const V a, const V b) { return _mm256_mul_ps(a, b); }
+   static V swap(const V a) { return _mm256_permute_ps(a, 0xB1); }
+   static V addsub(const V a, const V b) { return _mm256_addsub_ps(a, b); }
+   static V cmul(const V a, const V w)
+   {
+      return _mm256_addsub_ps(_mm256_mul_ps(a, _mm256_moveldup_ps(w)),
+                              _mm256_mul_ps(swap(a), _mm256_movehdup_ps(w)));
+   }
+   static V cmulc(const V a, const V w)
+   {
+      return swap(_mm256_addsub_ps(swap(_mm256_mul_ps(a, _mm256_moveldup_ps(w))),
+                                   _mm256_mul_ps(a, _mm256_movehdup_ps(w))));
+   }
+};
+
+#endif
+
+
+/// Operations on SIMDTraits<T>::Width interleaved complex numbers for ShortDFTPow2
+/*!
+\tparam T floating-point type
+\sa ScalarComplexOps
+*/
+template<typename T>
+struct SIMDComplexOps
+{
+   typedef SIMDTraits<T> VT;
+   typedef typename VT::V V;
+   typedef T Scalar;
+   typedef typename VT::V Real;
+   static const long_t Width = VT::Width;
+
+   static V load(const T* p) { return VT::load(p); }
+   static void store(T* p, const V a) { VT::store(p, a); }
+   static V set(const T re, const T im)
+   {
+      T c[2*Width];
+      for (long_t i = 0; i < Width; ++i) {
+        c[2*i]   = re;
+        c[2*i+1] = im;
+      }
+      return VT::load(c);
+   }
+   static Real real(const T a) { return VT::set1(a); }
+   static V add(const V a, const V b) { return VT::add(a, b); }
+   static V sub(const V a, const V b) { return VT::sub(a, b); }
+   static V scale(const V a, const Real h) { return VT::mul(h, a); }
+   static V cmul(const V a, const V w) { return VT::cmul(a, w); }
+   static V cmulc(const V a, const V w) { return VT::cmulc(a, w); }
+   // multiplication by i*S: (re, im) -> (-S*im, S*re)
+   template<int S>
+   static V imul(const V a)
+   {
+      return (S == 1) ? VT::addsub(VT::set1(0), VT::swap(a))
+                      : VT::swap(VT::addsub(VT::set1(0), a));
+   }
+};
+
+
+/// Vectorized radix-K butterflies with twiddle factors
+/*!
+\tparam K radix (2 or 3)
+\tparam T floating-point type
+\tparam S sign of the transform: 1 - forward, -1 - backward
+
+The data contain K sequences of M interleaved complex numbers.
+The array w contains K-1 sequences of the twiddle factors \f$ w^{km} \f$.
+SIMDTraits<T>::Width butterflies are processed at once, the remaining ones one by one.
+*/
+template<long_t K, typename T, int S>
+struct SIMDRadix;
+
+template<typename T, int S>
+struct SIMDRadix<2,T,S>
+{
+   static void apply(T* data, const T* w, const long_t M)
+   {
+      typedef SIMDTraits<T> VT;
+      typedef typename VT::V V;
+      static const long_t L = 2*VT::Width;
+      const long_t MV = 2*M - (2*M)%L;
+      T* data1 = data + 2*M;
+      long_t i = 0;
+      for (; i < MV; i += L) {
+        const V a = VT::load(data + i);
+        const V t = VT::cmul(VT::load(data1 + i), VT::load(w + i));
+        VT::store(data + i, VT::add(a, t));
+        VT::store(data1 + i, VT::sub(a, t));
+      }
+      // remaining butterflies
+      for (; i < 2*M; i += 2) {
+        const T tr = data1[i]*w[i] - data1[i+1]*w[i+1];
+        const T ti = data1[i]*w[i+1] + data1[i+1]*w[i];
+        data1[i]   = data[i] - tr;
+        data1[i+1] = data[i+1] - ti;
+        data[i]   += tr;
+        data[i+1] += ti;
+      }
+   }
+};
+
+template<typename T, int S>
+struct SIMDRadix<3,T,S>
+{
+   static void apply(T* data, const T* w, const long_t M)
+   {
+      typedef SIMDTraits<T> VT;
+      typedef typename VT::V V;
+      static const long_t L = 2*VT::Width;
+      const V coef = VT::set1(static_cast<T>(S*std::sqrt(3.L)/2));
+      const V half = VT::set1(static_cast<T>(0.5));
+      const V zero = VT::set1(0);
+      const long_t MV = 2*M - (2*M)%L;
+      T* data1 = data + 2*M;
+      T* data2 = data + 4*M;
+      const T* w2 = w + 2*M;
+      long_t i = 0;
+      for (; i < MV; i += L) {
+        const V a = VT::load(data + i);
+        const V t1 = VT::cmul(VT::load(data1 + i), VT::load(w + i));
+        const V t2 = VT::cmul(VT::load(data2 + i), VT::load(w2 + i));
+        const V sum = VT::add(t1, t2);
+        const V dif = VT::swap(VT::mul(coef, VT::sub(t1, t2)));
+        const V t = VT::sub(a, VT::mul(half, sum));
+        VT::store(data + i, VT::add(a, sum));
+        VT::store(data1 + i, VT::addsub(t, VT::sub(zero, dif)));
+        VT::store(data2 + i, VT::addsub(t, dif));
+      }
+      // remaining butterflies
+      const T c = static_cast<T>(S*std::sqrt(3.L)/2);
+      for (; i < 2*M; i += 2) {
+        const T tr1 = data1[i]*w[i] - data1[i+1]*w[i+1];
+        const T ti1 = data1[i]*w[i+1] + data1[i+1]*w[i];
+        const T tr2 = data2[i]*w2[i] - data2[i+1]*w2[i+1];
+        const T ti2 = data2[i]*w2[i+1] + data2[i+1]*w2[i];
+        const T sum_r = tr1 + tr2;
+        const T sum_i = ti1 + ti2;
+        const T dif_r = c*(tr1 - tr2);
+        const T dif_i = c*(ti1 - ti2);
+        const T tr = data[i] - sum_r/2;
+        const T ti = data[i+1] - sum_i/2;
+        data[i]   += sum_r;
+        data[i+1] += sum_i;
+        data1[i]   = tr + dif_i;
+        data1[i+1] = ti - dif_r;
+        data2[i]   = tr - dif_i;
+        data2[i+1] = ti + dif_r;
+      }
+   }
+};
+
+
+/// Vectorized DFTk_x_Im_T for radix 2 and 3
+/*!
+\tparam K radix
+\tparam M number of the butterflies
+\tparam Step step between the butterflies
+\tparam VType type of data element
+\tparam S sign of the transform: 1 - forward, -1 - backward
+
+The member isAvailable is true, if there is a vector kernel for the given parameters:
+K is 2 or 3, the value type is double or float, M is not less than the vector width
+and Step is one. The remaining M modulo width butterflies are computed by the scalar code. The twiddle factors are taken from the shared StepRootsTable
+and loaded as vectors instead of the scalar recurrence in DFTk_x_Im_T.
+*/
+template<long_t K, long_t M, long_t Step, typename VType, int S,
+bool Enabled = ((K == 2 || K == 3) && Step == 1
+                && SIMDTraits<typename VType::ValueType>::Width > 1
+                && M >= SIMDTraits<typename VType::ValueType>::Width)>
+class SIMDDFTk_x_Im_T
+{
+   typedef typename VType::ValueType T;
+public:
+   static const bool isAvailable = false;
+   void apply(T*) { }
+};
+
+template<long_t K, long_t M, long_t Step, typename VType, int S>
+class SIMDDFTk_x_Im_T<K,M,Step,VType,S,true>
+{
+   typedef typename VType::ValueType T;
+   const T* m_w;
+
+public:
+   static const bool isAvailable = true;
+
+   SIMDDFTk_x_Im_T() : m_w(StepRootsTable<K,M,T,S>::Instance().getData()) { }
+
+   void apply(T* data)
+   {
+      SIMDRadix<K,T,S>::apply(data, m_w, M);
+   }
+};
+
+}  //namespace GFFT
+
+#endif /*__gfftsimd_h*/
@@ -21,87 +21,480 @@
 
 #include "twiddles.h"
 #include "Singleton.h"
+#include "gfftcodelets.h"
+
+#include <cmath>
 
 namespace GFFT {
 
-/// Out-of-place DFT
+/// Operations on a single complex number for ShortDFTPow2
+/*!
+\tparam T floating-point type
+
+The complex numbers are loaded from and stored into the interleaved arrays.
+Scalar is the floating-point type, Real is the type of the real factors in scale().
+SIMDComplexOps provides the same operations on SIMDTraits<T>::Width numbers at once.
+*/
+template<typename T>
+struct ScalarComplexOps
+{
+  struct V { T re, im; };
+  typedef T Scalar;
+  typedef T Real;
+  static const long_t Width = 1;
+
+  static V load(const T* p) { const V a = { p[0], p[1] }; return a; }
+  static void store(T* p, const V a) { p[0] = a.re; p[1] = a.im; }
+  static V set(const T re, const T im) { const V a = { re, im }; return a; }
+  static Real real(const T a) { return a; }
+  static V add(const V a, const V b) { const V c = { a.re + b.re, a.im + b.im }; return c; }
+  static V sub(const V a, const V b) { const V c = { a.re - b.re, a.im - b.im }; return c; }
+  static V scale(const V a, const Real h) { const V c = { h*a.re, h*a.im }; return c; }
+  static V cmul(const V a, const V w)
+  {
+    const V c = { a.re*w.re - a.im*w.im, a.re*w.im + a.im*w.re };
+    return c;
+  }
+  // multiplication by the complex conjugate of w
+  static V cmulc(const V a, const V w)
+  {
+    const V c = { a.re*w.re + a.im*w.im, a.im*w.re - a.re*w.im };
+    return c;
+  }
+  // multiplication by i*S
+  template<int S>
+  static V imul(const V a) { const V c = { -S*a.im, S*a.re }; return c; }
+};
+
+/// DFT of the length 2, 4, 8 and 16 with the trivial twiddle factors folded in
+/*!
+\tparam S sign of the transform (-1 for inverse)
+\tparam Ops operations on complex numbers (ScalarComplexOps or SIMDComplexOps)
+
+The member apply() takes the complex numbers from the array x with the step SX 
+and writes the result into the array y with the step SY.
+The length 16 is computed as 4x4, the length 8 as 4x2 with the radix-4 butterflies.
+The twiddle factors \f$ \pm 1, \pm i, (\pm 1 \pm i)/\sqrt 2 \f$ need no multiplication
+or one multiplication by \f$ \sqrt 2/2 \f$.
+\sa DFTkPow2, DFTkPow2_inp
+*/
+template<int S, class Ops>
+class ShortDFTPow2
+{
+  typedef typename Ops::V V;
+  typedef typename Ops::Real Real;
+
+  const V m_w1, m_w3, m_w9;  // w^1, w^3, w^9; w = exp(-2*pi*i*S/16)
+  const Real m_h;            // sqrt(2)/2
+
+  // multiplication by w^E
+  V rot(const V a, Loki::Int2Type<1>) const { return Ops::cmul(a, m_w1); }
+  V rot(const V a, Loki::Int2Type<2>) const { return Ops::scale(Ops::add(a, Ops::template imul<-S>(a)), m_h); }
+  V rot(const V a, Loki::Int2Type<3>) const { return Ops::cmul(a, m_w3); }
+  V rot(const V a, Loki::Int2Type<4>) const { return Ops::template imul<-S>(a); }
+  V rot(const V a, Loki::Int2Type<6>) const { return Ops::scale(Ops::sub(Ops::template imul<-S>(a), a), m_h); }
+  V rot(const V a, Loki::Int2Type<9>) const { return Ops::cmul(a, m_w9); }
+
+  template<long_t SX, long_t SY>
+  static void apply4(const V* x, V* y)
+  {
+    const V t0 = Ops::add(x[0], x[2*SX]);
+    const V t1 = Ops::sub(x[0], x[2*SX]);
+    const V t2 = Ops::add(x[SX], x[3*SX]);
+    const V t3 = Ops::template imul<-S>(Ops::sub(x[SX], x[3*SX]));
+    y[0]    = Ops::add(t0, t2);
+    y[2*SY] = Ops::sub(t0, t2);
+    y[SY]   = Ops::add(t1, t3);
+    y[3*SY] = Ops::sub(t1, t3);
+  }
+
+  template<long_t SX, long_t SY>
+  void apply(const V* x, V* y, Loki::Int2Type<2>) const
+  {
+    const V t = Ops::sub(x[0], x[SX]);
+    y[0]  = Ops::add(x[0], x[SX]);
+    y[SY] = t;
+  }
+
+  template<long_t SX, long_t SY>
+  void apply(const V* x, V* y, Loki::Int2Type<4>) const
+  {
+    apply4<SX,SY>(x, y);
+  }
+
+  template<long_t SX, long_t SY>
+  void apply(const V* x, V* y, Loki::Int2Type<8>) const
+  {
+    V a[8];
+    apply4<2*SX,1>(x, a);
+    apply4<2*SX,1>(x + SX, a + 4);
+    a[5] = rot(a[5], Loki::Int2Type<2>());
+    a[6] = rot(a[6], Loki::Int2Type<4>());
+    a[7] = rot(a[7], Loki::Int2Type<6>());
+    for (long_t k = 0; k < 4; ++k) {
+      y[k*SY]     = Ops::add(a[k], a[4+k]);
+      y[(k+4)*SY] = Ops::sub(a[k], a[4+k]);
+    }
+  }
+
+  template<long_t SX, long_t SY>
+  void apply(const V* x, V* y, Loki::Int2Type<16>) const
+  {
+    V a[16];
+    for (long_t j = 0; j < 4; ++j)
+      apply4<4*SX,1>(x + j*SX, a + 4*j);
+    a[5]  = rot(a[5],  Loki::Int2Type<1>());
+    a[6]  = rot(a[6],  Loki::Int2Type<2>());
+    a[7]  = rot(a[7],  Loki::Int2Type<3>());
+    a[9]  = rot(a[9],  Loki::Int2Type<2>());
+    a[10] = rot(a[10], Loki::Int2Type<4>());
+    a[11] = rot(a[11], Loki::Int2Type<6>());
+    a[13] = rot(a[13], Loki::Int2Type<3>());
+    a[14] = rot(a[14], Loki::Int2Type<6>());
+    a[15] = rot(a[15], Loki::Int2Type<9>());
+    for (long_t k = 0; k < 4; ++k)
+      apply4<4,4*SY>(a + k, y + k*SY);
+  }
+
+public:
+  ShortDFTPow2()
+  : m_w1(Ops::set(static_cast<typename Ops::Scalar>(std::cos(M_PIl/8)),
+                  static_cast<typename Ops::Scalar>(-S*std::sin(M_PIl/8)))),
+    m_w3(Ops::set(static_cast<typename Ops::Scalar>(std::sin(M_PIl/8)),
+                  static_cast<typename Ops::Scalar>(-S*std::cos(M_PIl/8)))),
+    m_w9(Ops::set(static_cast<typename Ops::Scalar>(-std::cos(M_PIl/8)),
+                  static_cast<typename Ops::Scalar>(S*std::sin(M_PIl/8)))),
+    m_h(Ops::real(static_cast<typename Ops::Scalar>(std::sqrt(2.L)/2))) { }
+
+  template<long_t N, long_t SX, long_t SY>
+  void apply(const V* x, V* y) const
+  {
+    apply<SX,SY>(x, y, Loki::Int2Type<N>());
+  }
+};
+
+/// DFT of the odd length N with the real factors
+/*!
+\tparam N transform length, odd
+\tparam S sign of the transform (-1 for inverse)
+\tparam Ops operations on complex numbers (ScalarComplexOps or SIMDComplexOps)
+
+The member apply() transforms N complex numbers from the array x into the array y.
+With the sums \f$ s_j = x_j + x_{N-j} \f$ and the differences \f$ d_j = x_j - x_{N-j} \f$,
+j = 1,...,K, K = (N-1)/2, the result is
+\f[ X_k = A_k - iB_k,\quad X_{N-k} = A_k + iB_k, \f]
+\f[ A_k = x_0 + \sum_j s_j\cos(2\pi jk/N),\quad B_k = \sum_j d_j S\sin(2\pi jk/N). \f]
+The general form computes these sums completely unrolled with 2K^2 real factors.
+The specializations for N = 3, 5, 7 are Winograd's algorithms: after Rader's permutation
+of the indices the sums become cyclic convolutions, which need 2, 5 and 8 real factors.
+The lengths with HasCodelet<N>::value are computed by the generated CodeletDFT.
+\sa ShortDFTPow2, DFTkOdd, gfftcodelets.h
+*/
+template<long_t N, int S, class Ops, bool isGen = HasCodelet<N>::value>
+class ShortDFTOdd
+{
+  typedef typename Ops::V V;
+  typedef typename Ops::Scalar T;
+  static const long_t K = (N-1)/2;
+
+  // cos(2*pi*j/N), S*sin(2*pi*j/N), j = 1,...,K
+  typedef ConstRoots<N,S> W;
+  static typename Ops::Real cosine(const long_t i) { return Ops::real(static_cast<T>(W::re[i])); }
+  static typename Ops::Real sine(const long_t i) { return Ops::real(static_cast<T>(W::im[i])); }
+
+  // adds the terms j = 1,...,J to the sums A_k and B_k
+  template<long_t k, int J>
+  static void sum(const V* s, const V* d, V& a, V& b, Loki::Int2Type<J>)
+  {
+    static const long_t R = (J*k) % N;
+    static const long_t I = (R > K) ? N-R-1 : (R > 0) ? R-1 : 0;
+    sum<k>(s, d, a, b, Loki::Int2Type<J-1>());
+    if (R == 0) {   // cos = 1, sin = 0, if N is not prime
+      a = Ops::add(a, s[J-1]);
+      return;
+    }
+    a = Ops::add(a, Ops::scale(s[J-1], cosine(I)));
+    const V t = Ops::scale(d[J-1], sine(I));
+    b = (R > K) ? Ops::sub(b, t) : Ops::add(b, t);
+  }
+
+  template<long_t k>
+  static void sum(const V* s, const V* d, V& a, V& b, Loki::Int2Type<1>)
+  {
+    a = Ops::add(a, Ops::scale(s[0], cosine(k-1)));
+    b = Ops::scale(d[0], sine(k-1));
+  }
+
+  // outputs k and N-k, k = 1,...,KK
+  template<int KK>
+  static void outputs(const V* s, const V* d, const V x0, V* y, Loki::Int2Type<KK>)
+  {
+    outputs(s, d, x0, y, Loki::Int2Type<KK-1>());
+    V a = x0, b;
+    sum<KK>(s, d, a, b, Loki::Int2Type<K>());
+    b = Ops::template imul<-1>(b);
+    y[KK]   = Ops::add(a, b);
+    y[N-KK] = Ops::sub(a, b);
+  }
+
+  static void outputs(const V*, const V*, const V, V*, Loki::Int2Type<0>) { }
+
+public:
+  void apply(const V* x, V* y) const
+  {
+    V s[K], d[K];
+    for (long_t j = 1; j <= K; ++j) {
+      s[j-1] = Ops::add(x[j], x[N-j]);
+      d[j-1] = Ops::sub(x[j], x[N-j]);
+    }
+    outputs(s, d, x[0], y, Loki::Int2Type<K>());
+    V t = x[0];
+    for (long_t j = 0; j < K; ++j)
+      t = Ops::add(t, s[j]);
+    y[0] = t;
+  }
+};
+
+template<int S, class Ops>
+class ShortDFTOdd<3,S,Ops,false>
+{
+  typedef typename Ops::V V;
+  typedef typename Ops::Scalar T;
+
+  // cos(2*pi/3) - 1, S*sin(2*pi/3)
+  static constexpr long double m_c = -1.5L;
+  static constexpr long double m_s = ConstRoots<3,S>::im[0];
+
+public:
+  void apply(const V* x, V* y) const
+  {
+    const V s = Ops::add(x[1], x[2]);
+    const V d = Ops::template imul<-1>(Ops::scale(Ops::sub(x[1], x[2]), Ops::real(static_cast<T>(m_s))));
+    const V y0 = Ops::add(x[0], s);
+    const V a = Ops::add(y0, Ops::scale(s, Ops::real(static_cast<T>(m_c))));
+    y[0] = y0;
+    y[1] = Ops::add(a, d);
+    y[2] = Ops::sub(a, d);
+  }
+};
+
+template<int S, class Ops>
+constexpr long double ShortDFTOdd<3,S,Ops,false>::m_c;
+
+template<int S, class Ops>
+constexpr long double ShortDFTOdd<3,S,Ops,false>::m_s;
+
+template<int S, class Ops>
+class ShortDFTOdd<5,S,Ops,false>
+{
+  typedef typename Ops::V V;
+  typedef typename Ops::Scalar T;
+
+  // (c1 + c2)/2 - 1, (c1 - c2)/2, s2, s1 - s2, s1 + s2;
+  // c_j = cos(2*pi*j/5), s_j = S*sin(2*pi*j/5)
+  typedef ConstRoots<5,S> W;
+  static constexpr long double m_k[5] = {
+    (W::re[0] + W::re[1])/2 - 1, (W::re[0] - W::re[1])/2,
+    W::im[1], W::im[0] - W::im[1], W::im[0] + W::im[1] };
+
+  static V mul(const V a, const int i) { return Ops::scale(a, Ops::real(static_cast<T>(m_k[i]))); }
+
+public:
+
+  void apply(const V* x, V* y) const
+  {
+    const V s1 = Ops::add(x[1], x[4]);
+    const V s2 = Ops::add(x[2], x[3]);
+    const V d1 = Ops::sub(x[1], x[4]);
+    const V d2 = Ops::sub(x[2], x[3]);
+    const V t = Ops::add(s1, s2);
+    const V y0 = Ops::add(x[0], t);
+
+    // A_1 = u + v, A_2 = u - v
+    const V u = Ops::add(y0, mul(t, 0));
+    const V v = mul(Ops::sub(s1, s2), 1);
+
+    // B_1 = s1*d1 + s2*d2, B_2 = s2*d1 - s1*d2
+    const V p = mul(Ops::add(d1, d2), 2);
+    const V b1 = Ops::template imul<-1>(Ops::add(p, mul(d1, 3)));
+    const V b2 = Ops::template imul<-1>(Ops::sub(p, mul(d2, 4)));
+
+    const V a1 = Ops::add(u, v);
+    const V a2 = Ops::sub(u, v);
+    y[0] = y0;
+    y[1] = Ops::add(a1, b1);
+    y[4] = Ops::sub(a1, b1);
+    y[2] = Ops::add(a2, b2);
+    y[3] = Ops::sub(a2, b2);
+  }
+};
+
+template<int S, class Ops>
+constexpr long double ShortDFTOdd<5,S,Ops,false>::m_k[5];
+
+template<int S, class Ops>
+class ShortDFTOdd<7,S,Ops,false>
+{
+  typedef typename Ops::V V;
+  typedef typename Ops::Scalar T;
+
+  // Rader's permutation with the generator 3 orders the indices j = 1,...,3 as 1, 3, 2.
+  // The cosines C_m = cos(2*pi*3^m/7) form a cyclic convolution of the length 3,
+  // the sines E_m = S*sin(2*pi*3^m/7) a negacyclic one, which becomes cyclic
+  // with the factors (E_0, -E_1, E_2) and the alternating signs of the inputs and outputs.
+  // Every convolution is split into the mean value mu and the deviations D_m = C_m - mu
+  // with 4 real factors: mu - 1 (mu for the sines), D_0 - D_1, D_1, D_0 + 2*D_1
+  typedef ConstRoots<7,S> W;
+  static constexpr long double m_c[4] = {
+    (W::re[0] + W::re[2] + W::re[1])/3 - 1,
+    W::re[0] - W::re[2],
+    W::re[2] - (W::re[0] + W::re[2] + W::re[1])/3,
+    W::re[0] + 2*W::re[2] - (W::re[0] + W::re[2] + W::re[1]) };
+  static constexpr long double m_s[4] = {
+    (W::im[0] - W::im[2] + W::im[1])/3,
+    W::im[0] + W::im[2],
+    -W::im[2] - (W::im[0] - W::im[2] + W::im[1])/3,
+    W::im[0] - 2*W::im[2] - (W::im[0] - W::im[2] + W::im[1]) };
+
+  static V mulc(const V a, const int i) { return Ops::scale(a, Ops::real(static_cast<T>(m_c[i]))); }
+  static V muls(const V a, const int i) { return Ops::scale(a, Ops::real(static_cast<T>(m_s[i]))); }
+
+public:
+
+  void apply(const V* x, V* y) const
+  {
+    // sums and differences in the order of the indices 1, 3, 2
+    const V s0 = Ops::add(x[1], x[6]);
+    const V s1 = Ops::add(x[3], x[4]);
+    const V s2 = Ops::add(x[2], x[5]);
+    const V d0 = Ops::sub(x[1], x[6]);
+    const V d1 = Ops::sub(x[4], x[3]);   // with the alternating sign
+    const V d2 = Ops::sub(x[2], x[5]);
+
+    const V t = Ops::add(Ops::add(s0, s1), s2);
+    const V y0 = Ops::add(x[0], t);
+    const V u = Ops::add(y0, mulc(t, 0));
+    const V e0 = Ops::sub(s0, s2);
+    const V e1 = Ops::sub(s1, s2);
+    const V m = mulc(Ops::add(e0, e1), 2);
+    const V c0 = Ops::add(mulc(e0, 1), m);
+    const V c1 = Ops::sub(m, mulc(e1, 3));
+    const V a1 = Ops::add(u, c0);
+    const V a3 = Ops::add(u, c1);
+    const V a2 = Ops::sub(Ops::sub(u, c0), c1);
+
+    const V tb = muls(Ops::add(Ops::add(d0, d1), d2), 0);
+    const V f0 = Ops::sub(d0, d2);
+    const V f1 = Ops::sub(d1, d2);
+    const V n = muls(Ops::add(f0, f1), 2);
+    const V g0 = Ops::add(muls(f0, 1), n);
+    const V g1 = Ops::sub(n, muls(f1, 3));
+    const V b1 = Ops::template imul<-1>(Ops::add(tb, g0));
+    const V b3 = Ops::template imul<1>(Ops::add(tb, g1));
+    const V b2 = Ops::template imul<-1>(Ops::sub(Ops::sub(tb, g0), g1));
+
+    y[0] = y0;
+    y[1] = Ops::add(a1, b1);
+    y[6] = Ops::sub(a1, b1);
+    y[2] = Ops::add(a2, b2);
+    y[5] = Ops::sub(a2, b2);
+    y[3] = Ops::add(a3, b3);
+    y[4] = Ops::sub(a3, b3);
+  }
+};
+
+template<int S, class Ops>
+constexpr long double ShortDFTOdd<7,S,Ops,false>::m_c[4];
+
+template<int S, class Ops>
+constexpr long double ShortDFTOdd<7,S,Ops,false>::m_s[4];
+
+// the generated straight-line codelets (see gfftcodelets.h)
+template<long_t N, int S, class Ops>
+class ShortDFTOdd<N,S,Ops,true> : public CodeletDFT<N,S,Ops> {};
+
+/// Out-of-place DFT of the length N = 4, 8, 16
 /*!
 \tparam N length of the data
 \tparam SI step in the source data
 \tparam DI step in the result data
-\tparam T value type
+\tparam VType type of data element
 \tparam S sign of the transform (-1 for inverse)
-
-Non-recursive out-of-place DFT for a general (odd) length with 
-short-radix specializations for N=2,3
+\sa ShortDFTPow2
 */
 template<long_t N, long_t SI, long_t DI, typename VType, int S,
 bool isStd = Loki::TypeTraits<typename VType::ValueType>::isStdFundamental>
-class DFTk;
+class DFTkPow2;
 
 template<long_t N, long_t SI, long_t DI, typename VType, int S>
-class DFTk<N,SI,DI,VType,S,true>
+class DFTkPow2<N,SI,DI,VType,S,true>
 {
-  // N is assumed odd, otherwise compiler would not come here
-  
-  typedef typename VType::ValueType T;
-  typedef typename VType::TempType LocalVType;
-  static const long_t K = (N-1)/2;
-  static const long_t NSI = N*SI;
-  static const long_t NDI = N*DI;
-   
-//   typedef Loki::SingletonHolder<ComputeTwiddlesHolder<LocalVType, N, S, K> > Twiddles;
-//   LocalVType *m_c, *m_s;
-  LocalVType m_c[K], m_s[K];
-  
+  typedef typename VType::base_type T;
+  typedef ScalarComplexOps<T> Ops;
+  typedef typename Ops::V V;
+  ShortDFTPow2<S,Ops> m_dft;
 public:
-  DFTk() 
-  { 
-//     m_c = Twiddles::Instance().getCos();
-//     m_s = Twiddles::Instance().getSin();
-    ComputeTwiddles<LocalVType, N, S, K>::apply(m_c, m_s);
+  void apply(const T* src, T* dst)
+  {
+    V x[N], y[N];
+    for (long_t j = 0; j < N; ++j)
+      x[j] = Ops::load(src + j*SI);
+    m_dft.template apply<N,1,1>(x, y);
+    for (long_t k = 0; k < N; ++k)
+      Ops::store(dst + k*DI, y[k]);
   }
-  
-  void apply(const T* src, T* dst) 
-  { 
-    T sr[K], si[K], dr[K], di[K];
-    for (long_t i=0; i<K; ++i) {
-      const long_t k = (i+1)*SI;
-      sr[i] = src[k]   + src[NSI-k];
-      si[i] = src[k+1] + src[NSI-k+1];
-      dr[i] = src[k]   - src[NSI-k];
-      di[i] = src[k+1] - src[NSI-k+1];
-    }
-    
-    for (long_t i=1; i<K+1; ++i) {
-      T re1(0), re2(0), im1(0), im2(0);
-      for (long_t j=0; j<K; ++j) {
-        const bool sign_change = (i*(j+1) % N) > K;
-        const long_t kk = (i+j*i)%N;
-        const long_t k = (kk>K) ? N-kk-1 : kk-1;
-        const T s1 = m_s[k]*di[j];
-        const T s2 = m_s[k]*dr[j];
-        re1 += m_c[k]*sr[j];
-        im1 += m_c[k]*si[j];
-        re2 += sign_change ? -s1 : s1;
-        im2 -= sign_change ? -s2 : s2;
-      }
-      const long_t k = i*DI;
-      dst[k] = src[0] + re1 + re2;
-      dst[k+1] = src[1] + im1 + im2;
-      dst[NDI-k] = src[0] + re1 - re2;
-      dst[NDI-k+1] = src[1] + im1 - im2;
-    }
+};
 
-    dst[0] = src[0];
-    dst[1] = src[1];
-    for (long_t i=0; i<K; ++i) {
-      dst[0] += sr[i];
-      dst[1] += si[i];
-    }
+/// Out-of-place DFT of the odd length N
+/*!
+\tparam N length of the data
+\tparam SI step in the source data
+\tparam DI step in the result data
+\tparam VType type of data element
+\tparam S sign of the transform (-1 for inverse)
+\sa ShortDFTOdd
+*/
+template<long_t N, long_t SI, long_t DI, typename VType, int S,
+bool isStd = Loki::TypeTraits<typename VType::ValueType>::isStdFundamental>
+class DFTkOdd;
+
+template<long_t N, long_t SI, long_t DI, typename VType, int S>
+class DFTkOdd<N,SI,DI,VType,S,true>
+{
+  typedef typename VType::base_type T;
+  typedef ScalarComplexOps<T> Ops;
+  typedef typename Ops::V V;
+  ShortDFTOdd<N,S,Ops> m_dft;
+public:
+  void apply(const T* src, T* dst)
+  {
+    V x[N], y[N];
+    for (long_t j = 0; j < N; ++j)
+      x[j] = Ops::load(src + j*SI);
+    m_dft.apply(x, y);
+    for (long_t k = 0; k < N; ++k)
+      Ops::store(dst + k*DI, y[k]);
   }
 };
 
+/// Out-of-place DFT
+/*!
+\tparam N length of the data
+\tparam SI step in the source data
+\tparam DI step in the result data
+\tparam T value type
+\tparam S sign of the transform (-1 for inverse)
+
+Non-recursive out-of-place DFT for a general (odd) length by DFTkOdd with 
+short-radix specializations for N=2,3,4,8,16
+*/
+template<long_t N, long_t SI, long_t DI, typename VType, int S,
+bool isStd = Loki::TypeTraits<typename VType::ValueType>::isStdFundamental>
+class DFTk;
+
+template<long_t N, long_t SI, long_t DI, typename VType, int S>
+class DFTk<N,SI,DI,VType,S,true> : public DFTkOdd<N,SI,DI,VType,S> {};
+
 template<long_t SI, long_t DI, typename VType, int S>
 class DFTk<3,SI,DI,VType,S,true> 
 {
@@ -187,6 +580,41 @@ public:
   */
 };
 
+template<long_t SI, long_t DI, typename VType, int S>
+class DFTk<4,SI,DI,VType,S,true> : public DFTkPow2<4,SI,DI,VType,S> {};
+
+template<long_t SI, long_t DI, typename VType, int S>
+class DFTk<8,SI,DI,VType,S,true> : public DFTkPow2<8,SI,DI,VType,S> {};
+
+template<long_t SI, long_t DI, typename VType, int S>
+class DFTk<16,SI,DI,VType,S,true> : public DFTkPow2<16,SI,DI,VType,S> {};
+
+/// Prime factors above this length are transformed by Rader's algorithm
+static const long_t RaderThreshold = 13;
+/// Prime factors above this length are transformed by Bluestein's algorithm
+static const long_t BluesteinThreshold = 128;
+
+template<long_t N, long_t SI, long_t DI, typename VType, int S>
+class RaderDFTk;
+
+template<long_t N, long_t SI, long_t DI, typename VType, int S>
+class BluesteinDFTk;
+
+/// Selects out-of-place kernel for a prime length N
+/*!
+The quadratic kernel DFTk is used up to RaderThreshold,
+RaderDFTk up to BluesteinThreshold and BluesteinDFTk otherwise.
+The lengths 4, 8 and 16 (see GroupRadix) always use the codelets DFTk.
+*/
+template<long_t N, long_t SI, long_t DI, typename VType, int S>
+struct PrimeDFTk {
+   static const bool isPow2 = (N == 4 || N == 8 || N == 16);
+   typedef typename Loki::Select<(N > BluesteinThreshold), BluesteinDFTk<N,SI,DI,VType,S>,
+      typename Loki::Select<(N > RaderThreshold && !isPow2), RaderDFTk<N,SI,DI,VType,S>,
+         DFTk<N,SI,DI,VType,S> >::Result>::Result Result;
+};
+
+
 /// Out-of-place specialization for complex-valued radix 2 FFT 
 /// \tparam T is value type
 /// \param data is the array of length 4, containing two complex numbers (real,imag,real,imag).
@@ -201,131 +629,6 @@ inline void _spec2(const T* src, T* dst)
 }
 
 
-
-/// Out-of-place DCT-2
-/*!
-\tparam N length of the data
-\tparam SI step in the source data
-\tparam DI step in the result data
-\tparam T value type
-\tparam S sign of the transform (-1 for inverse)
-
-Non-recursive out-of-place DFT for a general (odd) length with 
-short-radix specializations for N=2,3
-*/
-template<long_t N, long_t SI, long_t DI, typename VType, int S,
-bool isStd = Loki::TypeTraits<typename VType::ValueType>::isStdFundamental>
-class DCT2k;
-/*
-template<long_t N, long_t SI, long_t DI, typename VType, int S>
-class DCT2k<N,SI,DI,VType,S,true>
-{
-  // N is assumed odd, otherwise compiler would not come here
-  
-  typedef typename VType::ValueType T;
-  typedef typename VType::TempType LocalVType;
-  static const long_t K = (N-1)/2;
-  static const long_t NSI = N*SI;
-  static const long_t NDI = N*DI;
-   
-  LocalVType m_c[K], m_s[K];
-  
-public:
-  DCT2k() 
-  { 
-    ComputeTwiddles<LocalVType, N, S, K>::apply(m_c, m_s);
-  }
-
-  void apply(const T* src, T* dst) 
-  { 
-    T sr[K], si[K], dr[K], di[K];
-    for (long_t i=0; i<K; ++i) {
-      const long_t k = (i+1)*SI;
-      sr[i] = src[k]   + src[NSI-k];
-      si[i] = src[k+1] + src[NSI-k+1];
-      dr[i] = src[k]   - src[NSI-k];
-      di[i] = src[k+1] - src[NSI-k+1];
-    }
-    
-    for (long_t i=1; i<K+1; ++i) {
-      T re1(0), re2(0), im1(0), im2(0);
-      for (long_t j=0; j<K; ++j) {
-	const bool sign_change = (i*(j+1) % N) > K;
-    const long_t kk = (i+j*i)%N;
-    const long_t k = (kk>K) ? N-kk-1 : kk-1;
-	const T s1 = m_s[k]*di[j];
-	const T s2 = m_s[k]*dr[j];
-	re1 += m_c[k]*sr[j];
-	im1 += m_c[k]*si[j];
-	re2 += sign_change ? -s1 : s1;
-	im2 -= sign_change ? -s2 : s2;
-      }
-      const long_t k = i*DI;
-      dst[k] = src[0] + re1 + re2;
-      dst[k+1] = src[1] + im1 + im2;
-      dst[NDI-k] = src[0] + re1 - re2;
-      dst[NDI-k+1] = src[1] + im1 - im2;
-    }
-
-    dst[0] = src[0];
-    dst[1] = src[1];
-    for (long_t i=0; i<K; ++i) {
-      dst[0] += sr[i];
-      dst[1] += si[i];
-    }
-  }
-};
-
-template<long_t SI, long_t DI, typename VType, int S>
-class DCT2k<3,SI,DI,VType,S,true> 
-{
-  typedef typename VType::ValueType T;
-  static const long_t SI2 = SI+SI;
-  static const long_t DI2 = DI+DI;
-  T m_coef;
-  
-public:
-  DCT2k() : m_coef(S * Sqrt<3, T>::value() * 0.5) { } // sqrt(3)/2 = sin(2pi/3)
-  
-  void apply(const T* src, T* dst) 
-  { 
-    // 4 mult, 12 add
-      const T sr = src[SI] + src[SI2];
-      const T dr = m_coef * (src[SI] - src[SI2]);
-      const T si = src[SI+1] + src[SI2+1];
-      const T di = m_coef * (src[SI+1] - src[SI2+1]);
-      const T tr = src[0] - 0.5*sr;
-      const T ti = src[1] - 0.5*si;
-      dst[0]     = src[0] + sr;
-      dst[1]     = src[1] + si;
-      dst[DI]    = tr + di;
-      dst[DI+1]  = ti - dr;
-      dst[DI2]   = tr - di;
-      dst[DI2+1] = ti + dr;     
-  }
-};
-*/
-template<long_t SI, long_t DI, typename VType, int S>
-class DCT2k<2,SI,DI,VType,S,true> 
-{
-  typedef typename VType::ValueType T;
-  static const int Acc = VType::Accuracy;
-  typedef Compute<typename MF::SqrtDecAcc<long_<2>,Acc>::Result,Acc,T> CSqrt2;
-
-  T m_coef;
-public:
-  DCT2k() : m_coef(S * CSqrt2::value() * 0.5) {} // sqrt(2)/2 = cos(pi/4)
-  
-  void apply(const T* src, T* dst) 
-  { 
-    // the temporary dif is necessary, because may happen src == dst
-        const T dif = src[0] - src[SI];
-        dst[0] = src[0] + src[SI];
-        dst[DI] = m_coef*dif;
-  }
-};
-  
-  
 }  //namespace DFT
 
 #endif /*__gfftspec_h*/
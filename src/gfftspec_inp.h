@@ -19,6 +19,7 @@
     \brief Short-radix in-place FFT specifications 
 */
 
+#include "gfftspec.h"
 #include "twiddles.h"
 #include "Singleton.h"
 
@@ -31,150 +32,13 @@ namespace GFFT {
 \tparam T value type
 \tparam S sign of the transform (-1 for inverse)
 
-Non-recursive in-place DFT for a general (odd) length with 
-short-radix specializations for N=2,3
+Non-recursive in-place DFT for a general (odd) length by DFTkOdd_inp with 
+short-radix specializations for N=2,3,4,8,16
 */
 template<long_t N, long_t M, typename VType, int S,
 bool isStd = Loki::TypeTraits<typename VType::ValueType>::isStdFundamental>
 class DFTk_inp;
 
-template<long_t N, long_t M, typename VType, int S>
-class DFTk_inp<N,M,VType,S,true>
-{
-  // N is assumed odd, otherwise compiler would not come here
-  
-  typedef typename VType::ValueType T;
-  typedef typename VType::TempType LocalVType;
-  static const long_t K = (N-1)/2;
-  static const long_t NM = N*M;
-   
-//   typedef Loki::SingletonHolder<ComputeTwiddlesHolder<LocalVType, N, S, K> > Twiddles;
-//   LocalVType *m_c, *m_s;
-  LocalVType m_c[K], m_s[K];
-  
-  void _transform(T* data, T* sr, T* si, T* dr, T* di)
-  {
-    for (long_t i=1; i<K+1; ++i) {
-      T re1(0), re2(0), im1(0), im2(0);
-      for (long_t j=0; j<K; ++j) {
-        const bool sign_change = (i*(j+1) % N) > K;
-        const long_t kk = (i+j*i)%N;
-        const long_t k = (kk>K) ? N-kk-1 : kk-1;
-        const T s1 = m_s[k]*di[j];
-        const T s2 = m_s[k]*dr[j];
-        re1 += m_c[k]*sr[j];
-        im1 += m_c[k]*si[j];
-        re2 += sign_change ? -s1 : s1;
-        im2 -= sign_change ? -s2 : s2;
-      }
-      const long_t k = i*M;
-      data[k] = data[0] + re1 + re2;
-      data[k+1] = data[1] + im1 + im2;
-      data[NM-k] = data[0] + re1 - re2;
-      data[NM-k+1] = data[1] + im1 - im2;
-    }
-    
-    for (long_t i=0; i<K; ++i) {
-      data[0] += sr[i];
-      data[1] += si[i];
-    }
-  }
-  
-public:
-
-  DFTk_inp() 
-  { 
-//     m_c = Twiddles::Instance().getCos();
-//     m_s = Twiddles::Instance().getSin();
-    ComputeTwiddles<LocalVType, N, S, K>::apply(m_c, m_s);
-  }
-  
-  void apply(T* data) 
-  { 
-    // These data must be local for multithreaded usage!!! (can not be defined as class members)
-    T sr[K], si[K], dr[K], di[K];
-    for (long_t i=0; i<K; ++i) {
-      const long_t k = (i+1)*M;
-      sr[i] = data[k]   + data[NM-k];
-      si[i] = data[k+1] + data[NM-k+1];
-      dr[i] = data[k]   - data[NM-k];
-      di[i] = data[k+1] - data[NM-k+1];
-    }
-    _transform(data,sr,si,dr,di);
-  }
-
-  template<class LT>
-  void apply(T* data, const LT* wr, const LT* wi) 
-  { 
-    T sr[K], si[K], dr[K], di[K];
-    for (long_t i=0; i<K; ++i) {
-      const long_t k = (i+1)*M;
-      const T tr1 = data[k]*wr[i] - data[k+1]*wi[i];
-      const T ti1 = data[k]*wi[i] + data[k+1]*wr[i];
-      const T tr2 = data[NM-k]*wr[N-i-2] - data[NM-k+1]*wi[N-i-2];
-      const T ti2 = data[NM-k]*wi[N-i-2] + data[NM-k+1]*wr[N-i-2];
-      sr[i] = tr1 + tr2;
-      si[i] = ti1 + ti2;
-      dr[i] = tr1 - tr2;
-      di[i] = ti1 - ti2;
-    }
-    _transform(data,sr,si,dr,di);
-  }
-  
-  template<class LT>
-  void apply_m(T* data, const LT* wr, const LT* wi) 
-  { 
-    const T t = data[0];
-    data[0] = t*wr[0] - data[1]*wi[0];
-    data[1] = t*wi[0] + data[1]*wr[0];
-    
-    apply(data, wr+1, wi+1);
-  }
-
-  // For decimation-in-frequency (obsolete)
-//   template<class LT>
-//   void apply(const LT* wr, const LT* wi, T* data) 
-//   { 
-//     T sr[K], si[K], dr[K], di[K];
-//     for (long_t i=0; i<K; ++i) {
-//       const long_t k = (i+1)*M;
-//       sr[i] = data[k]   + data[NM-k];
-//       si[i] = data[k+1] + data[NM-k+1];
-//       dr[i] = data[k]   - data[NM-k];
-//       di[i] = data[k+1] - data[NM-k+1];
-//     }
-//     
-//     for (long_t i=1; i<K+1; ++i) {
-//       T re1(0), re2(0), im1(0), im2(0);
-//       for (long_t j=0; j<K; ++j) {
-// 	const bool sign_change = (i*(j+1) % N) > K;
-// 	const long_t kk = (i+j*i)%N;
-// 	const long_t k = (kk>K) ? N-kk-1 : kk-1;
-// 	const T s1 = m_s[k]*di[j];
-// 	const T s2 = m_s[k]*dr[j];
-// 	re1 += m_c[k]*sr[j];
-// 	im1 += m_c[k]*si[j];
-// 	re2 += sign_change ? -s1 : s1;
-// 	im2 -= sign_change ? -s2 : s2;
-//       }
-//       const long_t k = i*M;
-//       const T tr1 = data[0] + re1 + re2;
-//       const T ti1 = data[1] + im1 + im2;
-//       const T tr2 = data[0] + re1 - re2;
-//       const T ti2 = data[1] + im1 - im2;
-//       data[k] = tr1*wr[i-1] - ti1*wi[i-1];
-//       data[k+1] = tr1*wi[i-1] + ti1*wr[i-1];
-//       data[NM-k] = tr2*wr[K-i+1] - ti2*wi[K-i+1];
-//       data[NM-k+1] = tr2*wi[K-i+1] + ti2*wr[K-i+1];
-//     }
-//     
-//     for (long_t i=0; i<K; ++i) {
-//       data[0] += sr[i];
-//       data[1] += si[i];
-//     }
-//   }
-};
-
 // Specialization for N=3
 template<long_t M, typename VType, int S>
 class DFTk_inp<3,M,VType,S,true> 
@@ -343,6 +207,145 @@ class DFTk_inp<1,M,VType,S,true>
 {
 };
 
+/// In-place DFT of the length N = 4, 8, 16
+/*!
+\tparam N length of the data
+\tparam M step in the data
+\tparam VType type of data element
+\tparam S sign of the transform (-1 for inverse)
+\sa ShortDFTPow2
+*/
+template<long_t N, long_t M, typename VType, int S,
+bool isStd = Loki::TypeTraits<typename VType::ValueType>::isStdFundamental>
+class DFTkPow2_inp;
+
+template<long_t N, long_t M, typename VType, int S>
+class DFTkPow2_inp<N,M,VType,S,true>
+{
+  typedef typename VType::base_type T;
+  typedef ScalarComplexOps<T> Ops;
+  typedef typename Ops::V V;
+  ShortDFTPow2<S,Ops> m_dft;
+
+  void transform(T* data, const V* x)
+  {
+    V y[N];
+    m_dft.template apply<N,1,1>(x, y);
+    for (long_t k = 0; k < N; ++k)
+      Ops::store(data + k*M, y[k]);
+  }
+
+public:
+  void apply(T* data)
+  {
+    V x[N];
+    for (long_t j = 0; j < N; ++j)
+      x[j] = Ops::load(data + j*M);
+    transform(data, x);
+  }
+
+  // For decimation-in-time
+  template<class LT>
+  void apply(T* data, const LT* wr, const LT* wi)
+  {
+    V x[N];
+    x[0] = Ops::load(data);
+    for (long_t j = 1; j < N; ++j)
+      x[j] = Ops::cmul(Ops::load(data + j*M), Ops::set(wr[j-1], wi[j-1]));
+    transform(data, x);
+  }
+};
+
+template<long_t M, typename VType, int S>
+class DFTk_inp<4,M,VType,S,true> : public DFTkPow2_inp<4,M,VType,S> {};
+
+template<long_t M, typename VType, int S>
+class DFTk_inp<8,M,VType,S,true> : public DFTkPow2_inp<8,M,VType,S> {};
+
+template<long_t M, typename VType, int S>
+class DFTk_inp<16,M,VType,S,true> : public DFTkPow2_inp<16,M,VType,S> {};
+
+/// In-place DFT of the odd length N
+/*!
+\tparam N length of the data
+\tparam M step in the data
+\tparam VType type of data element
+\tparam S sign of the transform (-1 for inverse)
+\sa ShortDFTOdd
+*/
+template<long_t N, long_t M, typename VType, int S,
+bool isStd = Loki::TypeTraits<typename VType::ValueType>::isStdFundamental>
+class DFTkOdd_inp;
+
+template<long_t N, long_t M, typename VType, int S>
+class DFTkOdd_inp<N,M,VType,S,true>
+{
+  typedef typename VType::base_type T;
+  typedef ScalarComplexOps<T> Ops;
+  typedef typename Ops::V V;
+  ShortDFTOdd<N,S,Ops> m_dft;
+
+  void transform(T* data, const V* x)
+  {
+    V y[N];
+    m_dft.apply(x, y);
+    for (long_t k = 0; k < N; ++k)
+      Ops::store(data + k*M, y[k]);
+  }
+
+public:
+  void apply(T* data)
+  {
+    V x[N];
+    for (long_t j = 0; j < N; ++j)
+      x[j] = Ops::load(data + j*M);
+    transform(data, x);
+  }
+
+  // For decimation-in-time
+  template<class LT>
+  void apply(T* data, const LT* wr, const LT* wi)
+  {
+    V x[N];
+    x[0] = Ops::load(data);
+    for (long_t j = 1; j < N; ++j)
+      x[j] = Ops::cmul(Ops::load(data + j*M), Ops::set(wr[j-1], wi[j-1]));
+    transform(data, x);
+  }
+
+  template<class LT>
+  void apply_m(T* data, const LT* wr, const LT* wi)
+  {
+    V x[N];
+    for (long_t j = 0; j < N; ++j)
+      x[j] = Ops::cmul(Ops::load(data + j*M), Ops::set(wr[j], wi[j]));
+    transform(data, x);
+  }
+};
+
+template<long_t N, long_t M, typename VType, int S>
+class DFTk_inp<N,M,VType,S,true> : public DFTkOdd_inp<N,M,VType,S> {};
+
+template<long_t N, long_t M, typename VType, int S>
+class RaderDFTk_inp;
+
+template<long_t N, long_t M, typename VType, int S>
+class BluesteinDFTk_inp;
+
+/// Selects in-place kernel for a prime length N
+/*!
+The quadratic kernel DFTk_inp is used up to RaderThreshold,
+RaderDFTk_inp up to BluesteinThreshold and BluesteinDFTk_inp otherwise.
+The lengths 4, 8 and 16 (see GroupRadix) always use the codelets DFTk_inp.
+*/
+template<long_t N, long_t M, typename VType, int S>
+struct PrimeDFTk_inp {
+   static const bool isPow2 = (N == 4 || N == 8 || N == 16);
+   typedef typename Loki::Select<(N > BluesteinThreshold), BluesteinDFTk_inp<N,M,VType,S>,
+      typename Loki::Select<(N > RaderThreshold && !isPow2), RaderDFTk_inp<N,M,VType,S>,
+         DFTk_inp<N,M,VType,S> >::Result>::Result Result;
+};
+
 /// In-place specialization for complex-valued radix 2 FFT 
 /// \tparam T is value type
 /// \param data is the array of length 4, containing two complex numbers (real,imag,real,imag).
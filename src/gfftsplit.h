@@ -0,0 +1,357 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Vladimir Mirnyy                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ ***************************************************************************/
+
+#ifndef __gfftsplit_h
+#define __gfftsplit_h
+
+/** \file
+    \brief Complex-valued FFT of the data in split format (separate real and imaginary parts)
+*/
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#include "Typelist.h"
+#include "twiddles.h"
+#include "gfftprime.h"
+
+namespace GFFT {
+
+/// Whether the value type stores the complex data in split format
+/** Specialized for SPLIT_DOUBLE and SPLIT_FLOAT */
+template<typename VType>
+struct IsSplitComplex {
+   static const bool value = false;
+};
+
+
+/// Twiddle factors of the split-complex step of the length K*M
+/*!
+The real and imaginary parts of \f$ w^{km} \f$, \f$ w = \exp(-2\pi iS/(KM)) \f$,
+k=1,...,K-1, m=0,...,M-1 are stored at the position (k-1)*M + m.
+The arrays are shared by all the instances through SharedTable.
+*/
+template<long_t K, long_t M, typename BT, int S>
+struct SplitRoots
+{
+   std::vector<BT> re, im;
+
+   SplitRoots() : re((K-1)*M), im((K-1)*M)
+   {
+      for (long_t k = 1; k < K; ++k)
+        for (long_t m = 0; m < M; ++m) {
+          const long double a = 2*M_PIl*k*m/(K*M);
+          re[(k-1)*M + m] = static_cast<BT>(std::cos(a));
+          im[(k-1)*M + m] = static_cast<BT>(-S*std::sin(a));
+        }
+   }
+};
+
+/// Radix-K butterflies of the split-complex data with the twiddle factors
+/*!
+\tparam K radix of the butterfly
+\tparam M number of the butterflies, the distance between their elements
+\tparam VType type of data element
+\tparam S sign of the transform: 1 - forward, -1 - backward
+
+The arrays re and im contain K sequences of the length M, which are the DFTs
+of the subsequences decimated in time. The element m of the sequence k
+is multiplied by \f$ w^{km} \f$, \f$ w = \exp(-2\pi iS/(KM)) \f$, and
+the K-point DFT is applied to the elements m of every sequence.
+The inner loop runs over m, so that the real and imaginary parts are loaded
+from the contiguous memory.
+
+The general radix K gathers the K twiddled elements into an interleaved
+work array and transforms them by the kernel PrimeDFTk of VType::InterleavedType,
+so that the larger primes are computed by Winograd's, Rader's or Bluestein's algorithm.
+*/
+template<long_t K, long_t M, typename VType, int S>
+class SplitDFTk_x_Im_T
+{
+   typedef typename VType::base_type BT;
+   typedef typename VType::InterleavedType IVType;
+
+   typedef SharedTable<SplitRoots<K,M,BT,S> > Roots;
+   const BT *m_wr, *m_wi;
+   typename PrimeDFTk<K,2,2,IVType,S>::Result m_dft;
+
+public:
+   SplitDFTk_x_Im_T() : m_wr(&Roots::Instance().re[0]), m_wi(&Roots::Instance().im[0]) { }
+
+   void apply(BT* re, BT* im)
+   {
+      BT* x = ThreadScratch<SplitDFTk_x_Im_T,BT>::get(4*K);
+      BT* y = x + 2*K;
+      for (long_t m = 0; m < M; ++m) {
+        x[0] = re[m];
+        x[1] = im[m];
+        for (long_t k = 1; k < K; ++k) {
+          const BT wr = m_wr[(k-1)*M + m];
+          const BT wi = m_wi[(k-1)*M + m];
+          x[2*k]   = re[k*M + m]*wr - im[k*M + m]*wi;
+          x[2*k+1] = re[k*M + m]*wi + im[k*M + m]*wr;
+        }
+        m_dft.apply(x, y);
+        for (long_t q = 0; q < K; ++q) {
+          re[q*M + m] = y[2*q];
+          im[q*M + m] = y[2*q+1];
+        }
+      }
+   }
+};
+
+template<long_t M, typename VType, int S>
+class SplitDFTk_x_Im_T<2,M,VType,S>
+{
+   typedef typename VType::base_type BT;
+
+   typedef SharedTable<SplitRoots<2,M,BT,S> > Roots;
+   const BT *m_wr, *m_wi;
+
+public:
+   SplitDFTk_x_Im_T() : m_wr(&Roots::Instance().re[0]), m_wi(&Roots::Instance().im[0]) { }
+
+   void apply(BT* re, BT* im)
+   {
+      BT* re1 = re + M;
+      BT* im1 = im + M;
+      for (long_t m = 0; m < M; ++m) {
+        const BT tr = re1[m]*m_wr[m] - im1[m]*m_wi[m];
+        const BT ti = re1[m]*m_wi[m] + im1[m]*m_wr[m];
+        re1[m] = re[m] - tr;
+        im1[m] = im[m] - ti;
+        re[m] += tr;
+        im[m] += ti;
+      }
+   }
+};
+
+template<long_t M, typename VType, int S>
+class SplitDFTk_x_Im_T<3,M,VType,S>
+{
+   typedef typename VType::base_type BT;
+
+   typedef SharedTable<SplitRoots<3,M,BT,S> > Roots;
+   const BT *m_wr, *m_wi;
+   const BT m_s;
+
+public:
+   SplitDFTk_x_Im_T() 
+   : m_wr(&Roots::Instance().re[0]), m_wi(&Roots::Instance().im[0]),
+     m_s(static_cast<BT>(-S*std::sqrt(3.L)/2)) { }
+
+   void apply(BT* re, BT* im)
+   {
+      BT* re1 = re + M;
+      BT* im1 = im + M;
+      BT* re2 = re + 2*M;
+      BT* im2 = im + 2*M;
+      const BT* wr2 = &m_wr[M];
+      const BT* wi2 = &m_wi[M];
+      for (long_t m = 0; m < M; ++m) {
+        const BT t1r = re1[m]*m_wr[m] - im1[m]*m_wi[m];
+        const BT t1i = re1[m]*m_wi[m] + im1[m]*m_wr[m];
+        const BT t2r = re2[m]*wr2[m] - im2[m]*wi2[m];
+        const BT t2i = re2[m]*wi2[m] + im2[m]*wr2[m];
+        const BT sr = t1r + t2r;
+        const BT si = t1i + t2i;
+        const BT dr = m_s*(t1r - t2r);
+        const BT di = m_s*(t1i - t2i);
+        const BT ar = re[m] - sr/2;
+        const BT ai = im[m] - si/2;
+        re[m] += sr;
+        im[m] += si;
+        re1[m] = ar - di;
+        im1[m] = ai + dr;
+        re2[m] = ar + di;
+        im2[m] = ai - dr;
+      }
+   }
+};
+
+
+/// Out-of-place K-point DFT of the split-complex data
+/*!
+\tparam K length of the transform
+\tparam SI stride of the input elements
+\tparam VType type of data element
+\tparam S sign of the transform: 1 - forward, -1 - backward
+
+The general length K is transformed in an interleaved work array
+by the kernel PrimeDFTk of VType::InterleavedType (see SplitDFTk_x_Im_T).
+*/
+template<long_t K, long_t SI, typename VType, int S>
+class SplitDFTk
+{
+   typedef typename VType::base_type BT;
+   typedef typename VType::InterleavedType IVType;
+
+   typename PrimeDFTk<K,2,2,IVType,S>::Result m_dft;
+
+public:
+   void apply(const BT* sre, const BT* sim, BT* dre, BT* dim)
+   {
+      BT* x = ThreadScratch<SplitDFTk,BT>::get(4*K);
+      BT* y = x + 2*K;
+      for (long_t k = 0; k < K; ++k) {
+        x[2*k]   = sre[k*SI];
+        x[2*k+1] = sim[k*SI];
+      }
+      m_dft.apply(x, y);
+      for (long_t q = 0; q < K; ++q) {
+        dre[q] = y[2*q];
+        dim[q] = y[2*q+1];
+      }
+   }
+};
+
+template<long_t SI, typename VType, int S>
+class SplitDFTk<2,SI,VType,S>
+{
+   typedef typename VType::base_type BT;
+public:
+   void apply(const BT* sre, const BT* sim, BT* dre, BT* dim)
+   {
+      dre[0] = sre[0] + sre[SI];
+      dim[0] = sim[0] + sim[SI];
+      dre[1] = sre[0] - sre[SI];
+      dim[1] = sim[0] - sim[SI];
+   }
+};
+
+template<long_t SI, typename VType, int S>
+class SplitDFTk<3,SI,VType,S>
+{
+   typedef typename VType::base_type BT;
+   const BT m_s;
+public:
+   SplitDFTk() : m_s(static_cast<BT>(-S*std::sqrt(3.L)/2)) { }
+
+   void apply(const BT* sre, const BT* sim, BT* dre, BT* dim)
+   {
+      const BT sr = sre[SI] + sre[2*SI];
+      const BT si = sim[SI] + sim[2*SI];
+      const BT dr = m_s*(sre[SI] - sre[2*SI]);
+      const BT di = m_s*(sim[SI] - sim[2*SI]);
+      const BT ar = sre[0] - sr/2;
+      const BT ai = sim[0] - si/2;
+      dre[0] = sre[0] + sr;
+      dim[0] = sim[0] + si;
+      dre[1] = ar - di;
+      dim[1] = ai + dr;
+      dre[2] = ar + di;
+      dim[2] = ai - dr;
+   }
+};
+
+
+/// Out-of-place decimation-in-time FFT of the split-complex data
+/*!
+\tparam N current transform length
+\tparam NFact factorization list
+\tparam VType type of data element
+\tparam S sign of the transform: 1 - forward, -1 - backward
+\tparam LastK stride of the input elements
+
+The recursion is the same as in InTimeOOP, but the real and imaginary parts
+are passed as separate arrays.
+\sa SplitDFTk_x_Im_T, SplitDFTk
+*/
+template<long_t N, typename NFact, typename VType, int S, long_t LastK = 1>
+class InTimeSplit;
+
+template<long_t N, typename Head, typename Tail, typename VType, int S, long_t LastK>
+class InTimeSplit<N, Loki::Typelist<Head,Tail>, VType, S, LastK>
+{
+   typedef typename VType::base_type BT;
+   static const long_t K = Head::first::value;
+   static const long_t M = N/K;
+
+   typedef Loki::Typelist<pair_<typename Head::first, ulong_<Head::second::value-1> >, Tail> NFactNext;
+   InTimeSplit<M,NFactNext,VType,S,K*LastK> dft_str;
+   SplitDFTk_x_Im_T<K,M,VType,S> dft_scaled;
+public:
+   void apply(const BT* sre, const BT* sim, BT* dre, BT* dim)
+   {
+      // run strided DFT recursively K times
+      for (long_t k = 0; k < K; ++k)
+        dft_str.apply(sre + k*LastK, sim + k*LastK, dre + k*M, dim + k*M);
+
+      dft_scaled.apply(dre, dim);
+   }
+};
+
+// Take the next factor from the list
+template<long_t N, long_t K, typename Tail, typename VType, int S, long_t LastK>
+class InTimeSplit<N, Loki::Typelist<pair_<ulong_<K>, ulong_<0> >,Tail>, VType, S, LastK>
+: public InTimeSplit<N, Tail, VType, S, LastK> {};
+
+// Specialization for prime N
+template<long_t N, typename VType, int S, long_t LastK>
+class InTimeSplit<N,Loki::Typelist<pair_<ulong_<N>, ulong_<1> >, Loki::NullType>,VType,S,LastK>
+: public SplitDFTk<N,LastK,VType,S> {};
+
+
+/// Complex-valued DFT of the data in split format
+/*!
+\tparam N length of the transform
+\tparam NFact factorization list
+\tparam VType type of data element (SPLIT_DOUBLE, SPLIT_FLOAT)
+\tparam S sign of the transform: 1 - forward, -1 - backward
+
+The data array of 2N real numbers contains N real parts followed by N imaginary parts.
+The function apply() with four pointers takes the real and imaginary parts
+from separate arrays. The backward transform is scaled by 1/N.
+*/
+template<long_t N, typename NFact, typename VType, int S>
+class SplitComplexDFT
+{
+   typedef typename VType::ValueType T;
+   typedef typename VType::base_type BT;
+
+   InTimeSplit<N,NFact,VType,S> m_fft;
+
+   static void scale(BT* re, BT* im)
+   {
+      if (S == -1)
+        for (long_t i = 0; i < N; ++i) {
+          re[i] /= N;
+          im[i] /= N;
+        }
+   }
+
+public:
+   void apply(const BT* sre, const BT* sim, BT* dre, BT* dim)
+   {
+      m_fft.apply(sre, sim, dre, dim);
+      scale(dre, dim);
+   }
+
+   void apply(const T* src, T* dst)
+   {
+      apply(src, src + N, dst, dst + N);
+   }
+
+   void apply(T* data)
+   {
+      BT* buf = ThreadScratch<SplitComplexDFT,BT>::get(2*N);
+      std::copy(data, data + 2*N, buf);
+      apply(buf, buf + N, data, data + N);
+   }
+};
+
+}  //namespace GFFT
+
+#endif /*__gfftsplit_h*/
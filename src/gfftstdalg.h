@@ -51,58 +51,91 @@ template<long_t K, long_t LastK, long_t M, long_t Step, typename VType, int S, c
 class DFTk_x_Im_T<K,LastK,M,Step,VType,S,W1,SimpleSpec,false>
 {
    typedef typename VType::ValueType CT;
+   typedef typename VType::base_type T;
    static const long_t N = K*M;
-   DFTk_inp<K,M,VType,S> spec_inp;
+   static const long_t NR = LastK*M/Step;
+   static const long_t RStep = LastK/K;
+   typename PrimeDFTk_inp<K,M,VType,S>::Result spec_inp;
+   const CT* m_roots;
 public:
+   DFTk_x_Im_T() 
+   : m_roots(reinterpret_cast<const CT*>(RootsTable<NR,T,S>::Instance().getData())) { }
+
    void apply(CT* data) 
    {
       spec_inp.apply(data);
 
-      ComputeRootsStd<K,VType,W1> roots;
-      
-      spec_inp.apply(data+Step, roots.get());
-      for (long_t i=Step+Step; i<M; i+=Step) {
-        roots.step();
-        spec_inp.apply(data+i, roots.get());
+      CT w[K-1];
+      long_t r = RStep;
+      for (long_t i=Step; i<M; i+=Step, r+=RStep) {
+        for (long_t k=0; k<K-1; ++k)
+          w[k] = m_roots[(k+1)*r];
+        spec_inp.apply(data+i, w);
       }
    }
   
 };
 
 
+// std::complex<T> is stored as two numbers T, so the version for T is reused
+template<long_t K, long_t M, long_t Step, typename VType, int S>
+class DFTkPow2_x_Im_T<K,M,Step,VType,S,false>
+: public DFTkPow2_x_Im_T<K,M,Step,VType,S,true>
+{
+   typedef typename VType::ValueType CT;
+   typedef typename VType::base_type T;
+   typedef DFTkPow2_x_Im_T<K,M,Step,VType,S,true> Base;
+public:
+   void apply(CT* data)
+   {
+      Base::apply(reinterpret_cast<T*>(data));
+   }
+
+   void apply(CT* data, const long_t b0, const long_t b1)
+   {
+      Base::apply(reinterpret_cast<T*>(data), b0, b1);
+   }
+};
+
+template<long_t LastK, long_t M, long_t Step, typename VType, int S, class W1, long_t SimpleSpec>
+class DFTk_x_Im_T<4,LastK,M,Step,VType,S,W1,SimpleSpec,false>
+: public DFTkPow2_x_Im_T<4,M,Step,VType,S> {};
+
+template<long_t LastK, long_t M, long_t Step, typename VType, int S, class W1, long_t SimpleSpec>
+class DFTk_x_Im_T<8,LastK,M,Step,VType,S,W1,SimpleSpec,false>
+: public DFTkPow2_x_Im_T<8,M,Step,VType,S> {};
+
+template<long_t LastK, long_t M, long_t Step, typename VType, int S, class W1, long_t SimpleSpec>
+class DFTk_x_Im_T<16,LastK,M,Step,VType,S,W1,SimpleSpec,false>
+: public DFTkPow2_x_Im_T<16,M,Step,VType,S> {};
+
 // Specialization for radix 2
 template<long_t M, long_t LastK, long_t Step, typename VType, int S, class W1, long_t SimpleSpec>
 class DFTk_x_Im_T<2,LastK,M,Step,VType,S,W1,SimpleSpec,false>
 {
    typedef typename VType::ValueType CT;
-//   typedef typename VType::ValueType T;
-   //static const long_t N = 2*M;
-   //static const long_t S2 = 2*Step;
-   //static const long_t NR = (4*PrecomputeRoots > LastK*M) ? LastK*M/4 : PrecomputeRoots;
-//   static const long_t NR = (PrecomputeRoots>=N) ? 2 : PrecomputeRoots/2;
-   //static const long_t K = N/PrecomputeRoots;
-//   static const long_t K2 = 2*K;
-   //typedef typename GetFirstRoot<N,S,VType::Accuracy>::Result W1;
-   typedef Compute<typename W1::Re,VType::Accuracy> WR;
-   typedef Compute<typename W1::Im,VType::Accuracy> WI;
+   typedef typename VType::base_type T;
+   static const long_t NR = LastK*M/Step;
+   static const long_t RStep = LastK/2;
    DFTk_inp<2,M,VType,S> spec_inp;
+   const CT* m_roots;
 public:
+   DFTk_x_Im_T() 
+   : m_roots(reinterpret_cast<const CT*>(RootsTable<NR,T,S>::Instance().getData())) { }
+
    void apply(CT* data)
    {
       spec_inp.apply(data);
-      if (M%2 == 0)
+      // the middle butterfly exists for an even number of the butterflies only
+      if ((M/Step)%2 == 0)
         spec_inp.apply_1(data + M/2);
 
-      const CT wp(WR::value(), WI::value());
-      CT t, w(wp);
-
-      spec_inp.apply(data+Step, &w);
-      t = CT(-w.real(), w.imag());
-      spec_inp.apply(data+M-Step, &t);
-      for (long_t i=Step+Step; i<M/2; i+=Step) {
-          w *= wp;
-          spec_inp.apply(data+i, &w);
-          t = CT(-w.real(), w.imag());
+      // w^(M-b) = -conj(w^b)
+      CT t;
+      long_t r = RStep;
+      for (long_t i=Step; i+i<M; i+=Step, r+=RStep) {
+          spec_inp.apply(data+i, m_roots+r);
+          t = CT(-m_roots[r].real(), m_roots[r].imag());
           spec_inp.apply(data+M-i, &t);
       }
    }
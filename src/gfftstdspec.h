@@ -26,89 +26,6 @@ namespace GFFT {
 using namespace MF;
 
 
-/// In-place DFT for "complex" types like std::complex
-/*!
-\tparam N length of the data
-\tparam M step in the data
-\tparam T value type
-\tparam S sign of the transform (-1 for inverse)
-
-Non-recursive in-place DFT for a general (odd) length with 
-short-radix specializations for N=2,3
-*/
-template<long_t N, long_t M, typename VType, int S>
-class DFTk_inp<N,M,VType,S,false>
-{
-  // N is assumed odd, otherwise compiler would not come here
-  
-  typedef typename VType::ValueType CT;
-  typedef typename VType::TempType LocalVType;
-  typedef typename CT::value_type T;
-  static const long_t K = (N-1)/2;
-  static const long_t NM = N*M;
-   
-  T m_c[K], m_s[K];
-  
-  void _transform(CT* data, const CT* s, const CT* d) 
-  {
-    for (long_t i=1; i<K+1; ++i) {
-      CT t1(0,0), t2(0,0);
-      for (long_t j=0; j<K; ++j) {
-        const bool sign_change = (i*(j+1) % N) > K;
-        const long_t kk = (i+j*i)%N;
-        const long_t k = (kk>K) ? N-kk-1 : kk-1;
-        const T s1 = m_s[k]*d[j].imag();
-        const T s2 = m_s[k]*d[j].real();
-        t1 += m_c[k]*s[j];
-        CT tt(sign_change ? -s1 : s1, sign_change ? s2 : -s2);
-        t2 += tt;
-      }
-      const long_t k = i*M;
-      data[k] = data[0] + t1 + t2;
-      data[NM-k] = data[0] + t1 - t2;
-    }
-    
-    for (long_t i=0; i<K; ++i)
-      data[0] += s[i];
-  }
-  
-public:
-  DFTk_inp() 
-  { 
-    ComputeTwiddles<T, N, S, K>::apply(m_c, m_s);
-  }
-  
-  void apply(CT* data) 
-  { 
-    CT s[K], d[K];
-    for (long_t i=0; i<K; ++i) {
-      const long_t k = (i+1)*M;
-      s[i] = data[k] + data[NM-k];
-      d[i] = data[k] - data[NM-k];
-    }
-    _transform(data, s, d);
-  }
-
-  void apply(CT* data, const CT* w) 
-  { 
-    CT s[K], d[K];
-    for (long_t i=0; i<K; ++i) {
-      const long_t k = (i+1)*M;
-      CT t1(data[k]*w[i]);
-      CT t2(data[NM-k]*w[N-i-2]);
-      s[i] = t1 + t2;
-      d[i] = t1 - t2;
-    }
-    _transform(data, s, d);
-  }
-
-  void apply_m(CT* data, const CT* w) 
-  { 
-    data[0] *= w[0];
-    apply(data, w+1);
-  }
-};
-
 template<long_t M, typename VType, int S>
 class DFTk_inp<3,M,VType,S,false> 
 {
@@ -195,70 +112,6 @@ public:
 //   }  
 };
 
-/// Out-of-place DFT for "complex" types like std::complex
-/*!
-\tparam N length of the data
-\tparam SI step in the source data
-\tparam DI step in the result data
-\tparam T value type
-\tparam S sign of the transform (-1 for inverse)
-
-Non-recursive out-of-place DFT for a general (odd) length with 
-short-radix specializations for N=2,3
-*/
-template<long_t N, long_t SI, long_t DI, typename VType, int S>
-class DFTk<N,SI,DI,VType,S,false>
-{
-  // N is assumed odd, otherwise compiler would not come here
-  
-  typedef typename VType::ValueType CT;
-  typedef typename VType::TempType LocalVType;
-  typedef typename CT::value_type T;
-
-  static const long_t K = (N-1)/2;
-  static const long_t NSI = N*SI;
-  static const long_t NDI = N*DI;
-   
-  T m_c[K], m_s[K];
-  
-public:
-  DFTk() 
-  { 
-    ComputeTwiddles<T, N, S, K>::apply(m_c, m_s);
-  }
-  
-  void apply(const CT* src, CT* dst) 
-  { 
-    CT s[K], d[K];
-    for (long_t i=0; i<K; ++i) {
-      const long_t k = (i+1)*SI;
-      s[i] = src[k] + src[NSI-k];
-      d[i] = src[k] - src[NSI-k];
-    }
-    
-    for (long_t i=1; i<K+1; ++i) {
-      CT t1(0,0), t2(0,0);
-      for (long_t j=0; j<K; ++j) {
-        const bool sign_change = (i*(j+1) % N) > K;
-        const long_t kk = (i+j*i)%N;
-        const long_t k = (kk>K) ? N-kk-1 : kk-1;
-        const T s1 = m_s[k]*d[j].imag();
-        const T s2 = m_s[k]*d[j].real();
-        t1 += m_c[k]*s[j];
-        CT tt(sign_change ? -s1 : s1, sign_change ? s2 : -s2);
-        t2 += tt;
-      }
-      const long_t k = i*DI;
-      dst[k] = src[0] + t1 + t2;
-      dst[NDI-k] = src[0] + t1 - t2;
-    }
-
-    dst[0] = src[0];
-    for (long_t i=0; i<K; ++i)
-      dst[0] += s[i];
-  }
-};
-
 template<long_t SI, long_t DI, typename VType, int S>
 class DFTk<3,SI,DI,VType,S,false> 
 {
@@ -300,6 +153,139 @@ public:
   }
 };
 
+// std::complex<T> is stored as two numbers T, so the codelet for T is reused
+template<long_t N, long_t SI, long_t DI, typename VType, int S>
+class DFTkPow2<N,SI,DI,VType,S,false> : public DFTkPow2<N,2*SI,2*DI,VType,S,true>
+{
+  typedef typename VType::ValueType CT;
+  typedef typename VType::base_type T;
+  typedef DFTkPow2<N,2*SI,2*DI,VType,S,true> Base;
+public:
+  void apply(const CT* src, CT* dst)
+  {
+    Base::apply(reinterpret_cast<const T*>(src), reinterpret_cast<T*>(dst));
+  }
+};
+
+template<long_t SI, long_t DI, typename VType, int S>
+class DFTk<4,SI,DI,VType,S,false> : public DFTkPow2<4,SI,DI,VType,S> {};
+
+template<long_t SI, long_t DI, typename VType, int S>
+class DFTk<8,SI,DI,VType,S,false> : public DFTkPow2<8,SI,DI,VType,S> {};
+
+template<long_t SI, long_t DI, typename VType, int S>
+class DFTk<16,SI,DI,VType,S,false> : public DFTkPow2<16,SI,DI,VType,S> {};
+
+template<long_t N, long_t M, typename VType, int S>
+class DFTkPow2_inp<N,M,VType,S,false> : public DFTkPow2_inp<N,2*M,VType,S,true>
+{
+  typedef typename VType::ValueType CT;
+  typedef typename VType::base_type T;
+  typedef DFTkPow2_inp<N,2*M,VType,S,true> Base;
+public:
+  void apply(CT* data)
+  {
+    Base::apply(reinterpret_cast<T*>(data));
+  }
+
+  // For decimation-in-time
+  void apply(CT* data, const CT* w)
+  {
+    T wr[N-1], wi[N-1];
+    for (long_t j = 0; j < N-1; ++j) {
+      wr[j] = w[j].real();
+      wi[j] = w[j].imag();
+    }
+    Base::apply(reinterpret_cast<T*>(data), wr, wi);
+  }
+};
+
+template<long_t M, typename VType, int S>
+class DFTk_inp<4,M,VType,S,false> : public DFTkPow2_inp<4,M,VType,S> {};
+
+template<long_t M, typename VType, int S>
+class DFTk_inp<8,M,VType,S,false> : public DFTkPow2_inp<8,M,VType,S> {};
+
+template<long_t M, typename VType, int S>
+class DFTk_inp<16,M,VType,S,false> : public DFTkPow2_inp<16,M,VType,S> {};
+
+template<long_t N, long_t SI, long_t DI, typename VType, int S>
+class DFTkOdd<N,SI,DI,VType,S,false> : public DFTkOdd<N,2*SI,2*DI,VType,S,true>
+{
+  typedef typename VType::ValueType CT;
+  typedef typename VType::base_type T;
+  typedef DFTkOdd<N,2*SI,2*DI,VType,S,true> Base;
+public:
+  void apply(const CT* src, CT* dst)
+  {
+    Base::apply(reinterpret_cast<const T*>(src), reinterpret_cast<T*>(dst));
+  }
+};
+
+/// Out-of-place DFT for "complex" types like std::complex
+/*!
+\tparam N length of the data
+\tparam SI step in the source data
+\tparam DI step in the result data
+\tparam T value type
+\tparam S sign of the transform (-1 for inverse)
+
+Non-recursive out-of-place DFT for a general (odd) length by DFTkOdd with 
+short-radix specializations for N=2,3,4,8,16
+*/
+template<long_t N, long_t SI, long_t DI, typename VType, int S>
+class DFTk<N,SI,DI,VType,S,false> : public DFTkOdd<N,SI,DI,VType,S> {};
+
+template<long_t N, long_t M, typename VType, int S>
+class DFTkOdd_inp<N,M,VType,S,false> : public DFTkOdd_inp<N,2*M,VType,S,true>
+{
+  typedef typename VType::ValueType CT;
+  typedef typename VType::base_type T;
+  typedef DFTkOdd_inp<N,2*M,VType,S,true> Base;
+
+  static void split(const CT* w, T* wr, T* wi, const long_t n)
+  {
+    for (long_t j = 0; j < n; ++j) {
+      wr[j] = w[j].real();
+      wi[j] = w[j].imag();
+    }
+  }
+
+public:
+  void apply(CT* data)
+  {
+    Base::apply(reinterpret_cast<T*>(data));
+  }
+
+  // For decimation-in-time
+  void apply(CT* data, const CT* w)
+  {
+    T wr[N-1], wi[N-1];
+    split(w, wr, wi, N-1);
+    Base::apply(reinterpret_cast<T*>(data), wr, wi);
+  }
+
+  void apply_m(CT* data, const CT* w)
+  {
+    T wr[N], wi[N];
+    split(w, wr, wi, N);
+    Base::apply_m(reinterpret_cast<T*>(data), wr, wi);
+  }
+};
+
+/// In-place DFT for "complex" types like std::complex
+/*!
+\tparam N length of the data
+\tparam M step in the data
+\tparam T value type
+\tparam S sign of the transform (-1 for inverse)
+
+Non-recursive in-place DFT for a general (odd) length by DFTkOdd_inp with 
+short-radix specializations for N=2,3,4,8,16
+*/
+template<long_t N, long_t M, typename VType, int S>
+class DFTk_inp<N,M,VType,S,false> : public DFTkOdd_inp<N,M,VType,S> {};
+
 /// Specialization for complex-valued radix 2 FFT in-place
 /// \tparam T is value type
 /// \tparam Complex<T> is a generic type representing complex numbers (like std::complex)
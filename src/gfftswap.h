@@ -19,6 +19,10 @@
     \brief Reordering of data for FFT
 */
 
+#include <vector>
+
+#include "gfftcaller.h"
+
 
 namespace GFFT {
 
@@ -69,7 +73,7 @@ where member function apply() is called twice recursively
 for the left and the right half-tree
 building the parameters n and r, which are the
 indexes of the exchanged data values.
-\sa SwapNR, GFFTswap2OMP
+\sa SwapNR, CobraSwap
 */
 template<ulong_t M, ulong_t P, typename T, ulong_t I=0>
 class GFFTswap2 {
@@ -226,11 +230,141 @@ public:
    }
 };
 
+/// Number of the digits Q of the blocks of CobraSwap: M^Q <= 16, at least one digit
+template<ulong_t M, ulong_t Q = 1, bool C = (IPow<M,Q+1>::value <= 16)>
+struct CobraDigits {
+   static const ulong_t value = CobraDigits<M,Q+1>::value;
+};
+
+template<ulong_t M, ulong_t Q>
+struct CobraDigits<M,Q,false> {
+   static const ulong_t value = Q;
+};
+
+/// Length, from which the in-place digit reversal is cache-blocked (see SwapSelect)
+static const long_t CobraThreshold = (1<<14);
+
+/// Cache-blocked digit reversal
+/*!
+\tparam M radix of the digits
+\tparam P number of the digits, the length of the data is N = M^P
+\tparam T value type
+\tparam NThreads number of threads
+\tparam Team threads running the loop (see OMPTeam)
+
+The index is split into Q upper digits a, P-2Q middle digits b and Q lower digits c,
+\f$ B = M^Q \f$ (see CobraDigits). The digit reversal maps (a,b,c) to (rev c, rev b, rev a).
+For every middle part b not greater than its reversal, the B rows of B contiguous elements
+(a,b,0...B-1) are loaded into a small buffer and then written transposed into the rows
+with the middle part rev b, and the same is done for rev b in the opposite direction.
+So every cache line of the data is loaded and stored once and used completely
+(COBRA by Carter and Gatlin, 1998), while the recursive GFFTswap2 touches
+a new line for almost every element of a large array.
+The middle parts are distributed among the threads of Team, every thread
+has its own pair of buffers on the stack.
+\sa GFFTswap2, SwapSelect
+*/
+template<ulong_t M, ulong_t P, typename T, long_t NThreads, class Team>
+class CobraSwap
+{
+   static const int C = Loki::TypeTraits<T>::isStdFundamental ? 2 : 1;
+   static const ulong_t Q = CobraDigits<M>::value;
+   static const long_t B = IPow<M,Q>::value;
+   static const long_t NMid = IPow<M,P-2*Q>::value;
+   static const long_t RowStep = IPow<M,P-Q>::value;
+
+   long_t m_rev[B];
+   const int m_nthreads;
+
+   static long_t reverse(long_t b, const ulong_t digits)
+   {
+      long_t r = 0;
+      for (ulong_t i = 0; i < digits; ++i) {
+        r = r*M + b%M;
+        b /= M;
+      }
+      return r;
+   }
+
+   static void load(const T* data, const long_t mid, T* buf)
+   {
+      for (long_t a = 0; a < B; ++a) {
+        const T* row = data + (a*RowStep + mid*B)*C;
+        for (long_t i = 0; i < B*C; ++i)
+          buf[a*B*C + i] = row[i];
+      }
+   }
+
+   // element (a,c) of the buffer goes to (rev c, mid, rev a)
+   void store(const T* buf, const long_t mid, T* data) const
+   {
+      for (long_t c = 0; c < B; ++c) {
+        T* row = data + (m_rev[c]*RowStep + mid*B)*C;
+        for (long_t a = 0; a < B; ++a)
+          for (int i = 0; i < C; ++i)
+            row[m_rev[a]*C + i] = buf[(a*B + c)*C + i];
+      }
+   }
+
+   struct Body {
+      const CobraSwap& m_swap;
+      T* m_data;
+      Body(const CobraSwap& swap, T* data) : m_swap(swap), m_data(data) { }
+      void operator()(const int tid, const int nt)
+      {
+        T buf1[B*B*C], buf2[B*B*C];
+        for (long_t b = tid; b < NMid; b += nt) {
+          const long_t br = reverse(b, P-2*Q);
+          if (br < b) continue;
+          load(m_data, b, buf1);
+          if (br == b)
+            m_swap.store(buf1, b, m_data);
+          else {
+            load(m_data, br, buf2);
+            m_swap.store(buf1, br, m_data);
+            m_swap.store(buf2, b, m_data);
+          }
+        }
+      }
+   };
+
+public:
+   CobraSwap() : m_nthreads(Team::threads(NThreads))
+   {
+      for (long_t i = 0; i < B; ++i)
+        m_rev[i] = reverse(i, Q);
+   }
+
+   void apply(T* data)
+   {
+      Body body(*this, data);
+      Team::run(m_nthreads, body);
+   }
+};
+
+/// In-place digit reversal of the length M^P
+/*!
+CobraSwap from the length CobraThreshold, if there are enough digits for the blocks,
+otherwise GFFTswap2, whose data fit into the cache anyway.
+*/
+template<ulong_t M, ulong_t P, typename T, long_t NThreads, class Team>
+struct SwapSelect
+{
+   static const bool C = (P >= 2*CobraDigits<M>::value) && (IPow<M,P>::value >= CobraThreshold);
+   typedef typename Loki::Select<C, CobraSwap<M,P,T,NThreads,Team>, GFFTswap2<M,P,T> >::Result Result;
+};
+
 /// Reordering of data for real-valued transforms
 /*!
 \tparam N length of the data
 \tparam T value type
 \tparam S sign of the transform: 1 - forward, -1 - backward
+
+The function separate(src,dst) reads from src and writes into dst,
+which may coincide with src. In the forward out-of-place transform
+the output of the preceding complex transform is already in dst,
+so apply(src,dst) post-processes dst in-place.
+\sa SeparateInput
 */
 template<long_t N, typename VType, int S,
 bool isStd = Loki::TypeTraits<typename VType::ValueType>::isStdFundamental>
@@ -243,7 +377,7 @@ class Separate<N,VType,S,true>
    typedef typename VType::TempType LocalVType;
    static const int M = (S==1) ? 2 : 1;
 public:
-   void apply(T* data) {
+   void separate(const T* src, T* dst) {
       long_t i,i1,i2,i3,i4;
       LocalVType wtemp,wr,wi,wpr,wpi;
       LocalVType h1r,h1i,h2r,h2i,h3r,h3i;
@@ -252,38 +386,40 @@ public:
       wpi = -S*Sin<N,1,LocalVType>::value();
       wr = 1.+wpr;
       wi = wpi;
-      for (i=1; i<N/2; ++i) {
+      for (i=1; i<(N+1)/2; ++i) {
         i1 = i+i;
         i2 = i1+1;
         i3 = 2*N-i1;
         i4 = i3+1;
-        h1r = 0.5*(data[i1]+data[i3]);
-        h1i = 0.5*(data[i2]-data[i4]);
-        h2r = S*0.5*(data[i2]+data[i4]);
-        h2i =-S*0.5*(data[i1]-data[i3]);
+        h1r = 0.5*(src[i1]+src[i3]);
+        h1i = 0.5*(src[i2]-src[i4]);
+        h2r = S*0.5*(src[i2]+src[i4]);
+        h2i =-S*0.5*(src[i1]-src[i3]);
         h3r = wr*h2r - wi*h2i;
         h3i = wr*h2i + wi*h2r;
-        data[i1] = h1r + h3r;
-        data[i2] = h1i + h3i;
-        data[i3] = h1r - h3r;
-        data[i4] =-h1i + h3i;
+        dst[i1] = h1r + h3r;
+        dst[i2] = h1i + h3i;
+        dst[i3] = h1r - h3r;
+        dst[i4] =-h1i + h3i;
 
         wtemp = wr;
         wr += wr*wpr - wi*wpi;
         wi += wi*wpr + wtemp*wpi;
       }
-      h1r = data[0];
-      data[0] = M*0.5*(h1r + data[1]);
-      data[1] = M*0.5*(h1r - data[1]);
-
-      if (N>1) data[N+1] = -data[N+1];
-   }
-   
-   void apply(const T*, T*) 
-   { 
-      std::cout << "Not implemented!" << std::endl;
-      exit(1);
+      h1r = src[0];
+      h1i = src[1];
+      dst[0] = M*0.5*(h1r + h1i);
+      dst[1] = M*0.5*(h1r - h1i);
+
+      if (N%2 == 0) {
+        dst[N] = src[N];
+        dst[N+1] = -src[N+1];
+      }
    }
+
+   void apply(T* data) { separate(data, data); }
+
+   void apply(const T*, T* dst) { separate(dst, dst); }
 };
 
 
@@ -302,36 +438,61 @@ class Separate<N,VType,S,false>
    typedef typename LocalComplex::value_type LocalVType;
    static const int M = (S==1) ? 2 : 1;
 public:
-   void apply(CT* data) {
+   void separate(const CT* src, CT* dst) {
       long_t i,i1;
       LocalComplex h1,h2,h3;
       LocalVType wtemp = Sin<2*N,1,LocalVType>::value();
       LocalComplex wp(-2.*wtemp*wtemp,-S*Sin<N,1,LocalVType>::value());
       LocalComplex w(1.+wp.real(),wp.imag());
 
-      for (i=1; i<N/2; ++i) {
+      for (i=1; i<(N+1)/2; ++i) {
         i1 = N-i;
-        h1 = LocalComplex(static_cast<LocalVType>(0.5*(data[i].real()+data[i1].real())),
-                          static_cast<LocalVType>(0.5*(data[i].imag()-data[i1].imag())));
-        h2 = LocalComplex(static_cast<LocalVType>( S*0.5*(data[i].imag()+data[i1].imag())),
-                          static_cast<LocalVType>(-S*0.5*(data[i].real()-data[i1].real())));
+        h1 = LocalComplex(static_cast<LocalVType>(0.5*(src[i].real()+src[i1].real())),
+                          static_cast<LocalVType>(0.5*(src[i].imag()-src[i1].imag())));
+        h2 = LocalComplex(static_cast<LocalVType>( S*0.5*(src[i].imag()+src[i1].imag())),
+                          static_cast<LocalVType>(-S*0.5*(src[i].real()-src[i1].real())));
         h3 = w*h2;
-        data[i] = h1 + h3;
-        data[i1]= h1 - h3;
-        data[i1] = CT(data[i1].real(), -data[i1].imag());
+        dst[i] = h1 + h3;
+        dst[i1]= h1 - h3;
+        dst[i1] = CT(dst[i1].real(), -dst[i1].imag());
 
         w += w*wp;
       }
-      wtemp = data[0].real();
-      data[0] = CT(M*0.5*(wtemp + data[0].imag()), M*0.5*(wtemp - data[0].imag()));
+      wtemp = src[0].real();
+      dst[0] = CT(M*0.5*(wtemp + src[0].imag()), M*0.5*(wtemp - src[0].imag()));
 
-      data[N/2] = CT(data[N/2].real(), -data[N/2].imag());
+      if (N%2 == 0)
+        dst[N/2] = CT(src[N/2].real(), -src[N/2].imag());
    }
 
-   void apply(const CT*, CT*) 
-   { 
-      std::cout << "Not implemented!" << std::endl;
-      exit(1);
+   void apply(CT* data) { separate(data, data); }
+
+   void apply(const CT*, CT* dst) { separate(dst, dst); }
+};
+
+/// Input reordering of the out-of-place backward real-valued transform
+/*!
+\tparam N length of the data
+\tparam VType type of data element
+\tparam TList Typelist of the out-of-place backward complex transform
+
+The input array must not be changed by an out-of-place transform,
+so the separated input is written into the work array, 
+which is then the source for the transform TList.
+*/
+template<long_t N, typename VType, class TList>
+class SeparateInput
+{
+   typedef typename VType::ValueType T;
+   static const int C = Loki::TypeTraits<T>::isStdFundamental ? 2 : 1;
+
+   Separate<N,VType,-1> m_sep;
+   Caller<TList> m_run;
+public:
+   void apply(const T* src, T* dst) {
+      std::vector<T> buf(N*C);
+      m_sep.separate(src, &buf[0]);
+      m_run.apply(&buf[0], dst);
    }
 };
 
@@ -253,6 +253,7 @@ struct Compute<SRational<Numer,Denom>,Accuracy,RetType> {
 
 template<long_t N, int Accuracy, class RetType>
 struct Compute<long_<N>,Accuracy,RetType> {
+  typedef long_<N> Value;
   typedef long_<N> BigInt;
   static constexpr RetType value() { return static_cast<RetType>(N); }
 };
@@ -22,190 +22,167 @@
 #include "metaroot.h"
 
 #include <vector>
+#include <cmath>
+#include <utility>
 
 namespace GFFT {
 
 using namespace MF;
 
-static const int uninitialized_flag = 1000; 
-
-template<long_t N, typename NList, typename VType, typename W1, int S, long_t LastK=1, bool C = (N>=4)>
-class _RootsCompute;
-
-template<long_t N, typename Head, typename Tail, typename VType, typename W1, int S, long_t LastK>
-class _RootsCompute<N,Loki::Typelist<Head,Tail>,VType,W1,S,LastK, true>
+/// Shared table of the roots of unity
+/*!
+\tparam N length of the table
+\tparam T floating-point type
+\tparam S sign of the transform: 1 - forward, -1 - backward
+
+Holds \f$ w^j \f$, \f$ w = e^{-2\pi iS/N} \f$, j=0,...,N-1 as interleaved
+pairs of the real and imaginary parts. Every root is computed directly in long double,
+so the accuracy does not depend on N. The table is created once for all the instances
+through RootsTable and is reused by the transforms of the length L dividing N
+taking each N/L-th root. The data are aligned to RootsHolder::Alignment bytes.
+\sa RootsTable, DFTk_x_Im_T
+*/
+template<long_t N, typename T, int S>
+class RootsHolder
 {
-   typedef typename VType::ValueType T;
-   static const long_t K = Head::first::value;
-   static const long_t M = N/K;
-   static const long_t NN = N*LastK-2;
-   static const long_t Step = 2*LastK;
-   
-   typedef Compute<typename W1::Re,VType::Accuracy> WR;
-   typedef Compute<typename W1::Im,VType::Accuracy> WI;
-
-   typedef typename IPowBig<W1,K>::Result WK;
-   typedef Loki::Typelist<pair_<typename Head::first, long_<Head::second::value-1> >, Tail> NFactNext;
-   
-   _RootsCompute<M,NFactNext,VType,WK,S,K*LastK> next;
+   std::vector<T> m_buf;
+   T* m_data;
+
 public:
-  void init(std::vector<T>& w)
-  {
-    next.init(w);
-    
-    const T wpr = WR::value();
-    const T wpi = WI::value();
-    w[Step-2] = wpr;
-    w[Step-1] = wpi;
-
-    for (long_t i=Step+Step-2; i<NN; i+=Step) {
-      if (w[i] == uninitialized_flag) {
-        w[i]   = w[i-Step]*wpr - w[i-Step+1]*wpi;
-        w[i+1] = w[i-Step+1]*wpr + w[i-Step]*wpi;
+   static const long_t Alignment = 64;
+
+   RootsHolder() : m_buf(2*N + Alignment/sizeof(T))
+   {
+      const std::size_t off = reinterpret_cast<std::size_t>(&m_buf[0]) % Alignment;
+      m_data = &m_buf[0] + (off ? (Alignment - off)/sizeof(T) : 0);
+      for (long_t j = 0; j < N; ++j) {
+        const long double a = 2*M_PIl*j/N;
+        m_data[2*j]     = static_cast<T>(std::cos(a));
+        m_data[2*j + 1] = static_cast<T>(-S*std::sin(a));
       }
-    }
-  }
-};
+   }
 
-template<long_t N, long_t K, typename Tail, typename VType, class W, int S, long_t LastK>
-class _RootsCompute<N, Loki::Typelist<pair_<long_<K>, long_<0> >,Tail>, VType, W, S, LastK, true>
-: public _RootsCompute<N, Tail, VType, W, S, LastK, true> {};
+   const T* getData() const { return m_data; }
+};
 
-template<long_t N, long_t K, typename Tail, typename VType, class W, int S, long_t LastK>
-class _RootsCompute<N, Loki::Typelist<pair_<long_<K>, long_<0> >,Tail>, VType, W, S, LastK, false>
-: public _RootsCompute<N, Tail, VType, W, S, LastK, false> {};
+/// Table shared by all the instances of a class
+/*!
+\tparam Table class computing the table in its default constructor
 
-// Specialization for a prime N
-template<long_t N, typename Head, typename VType, class W, int S, long_t LastK>
-class _RootsCompute<N,Loki::Typelist<Head, Loki::NullType>, VType, W, S, LastK, false> 
+The table is created by the first call of Instance() and destroyed at exit.
+The creation is thread-safe, so the transforms may be created in parallel.
+Every next instance of a transform takes the existing table,
+so its construction does not depend on the length of the table.
+*/
+template<class Table>
+struct SharedTable
 {
-   typedef typename VType::ValueType T;
-   typedef Compute<typename W::Re,VType::Accuracy> WR;
-   typedef Compute<typename W::Im,VType::Accuracy> WI;
-   static const long_t NN = N*LastK-2;
-   static const long_t Step = 2*LastK;
-public:
-  void init(std::vector<T>& w)
-  {
-    const T wpr = WR::value();
-    const T wpi = WI::value();
-    w[Step-2] = wpr;
-    w[Step-1] = wpi;
-    for (long_t i=Step+Step-2; i<NN; i+=Step) {
-      w[i]   = w[i-Step]*wpr - w[i-Step+1]*wpi;
-      w[i+1] = w[i-Step+1]*wpr + w[i-Step]*wpi;
-    }
-  }  
+   static Table& Instance()
+   {
+      static Table table;
+      return table;
+   }
 };
-  
-// Specialization for N=4
-template<typename Head, typename VType, class W, int S, long_t LastK>
-class _RootsCompute<4,Loki::Typelist<Head, Loki::NullType>, VType, W, S, LastK, false> 
+
+/// Shared table RootsHolder<N,T,S>
+template<long_t N, typename T, int S>
+struct RootsTable : public SharedTable<RootsHolder<N,T,S> > {};
+
+
+/// Work array of the calling thread
+/*!
+\tparam Owner class using the array
+\tparam T type of the elements
+\tparam I index to distinguish several arrays of the same owner
+
+Every thread gets its own array, which only grows and is released at the exit
+of the thread. So a transform object can be applied from several threads
+at once without allocating memory in each call. The array of one Owner
+must not be used by the nested calls of the same Owner.
+*/
+template<class Owner, typename T, int I = 0>
+struct ThreadScratch
 {
-   typedef typename VType::ValueType T;
-   static const long_t Step = 2*LastK;
-public:
-  void init(std::vector<T>& w)
-  {
-    w[Step-2] = 0;
-    w[Step-1] = -1;
-  }  
+   static T* get(const std::size_t n)
+   {
+      static thread_local std::vector<T> buf;
+      if (buf.size() < n) buf.resize(n);
+      return &buf[0];
+   }
 };
 
-template<long_t N, typename NList, typename VType, int Sign, bool C = (N>=4)>
-class RootsHolder;
 
-template<long_t N, typename NList, typename VType, int Sign>
-class RootsHolder<N,NList,VType,Sign,true>
+/// Twiddle factors of a step of the length K*M
+/*!
+\tparam K radix of the step
+\tparam M number of the butterflies
+\tparam T floating-point type
+\tparam S sign of the transform: 1 - forward, -1 - backward
+
+Holds \f$ w^{km} \f$, \f$ w = e^{-2\pi iS/(KM)} \f$, k=1,...,K-1, m=0,...,M-1
+at the position 2*((k-1)*M + m), so that the factors of the consecutive butterflies
+are loaded as vectors. The table is shared through StepRootsTable.
+\sa RootsHolder
+*/
+template<long_t K, long_t M, typename T, int S>
+class StepRootsHolder
 {
-  typedef typename VType::ValueType T;
-  //typedef typename VType::TempType LT;
+   std::vector<T> m_data;
 
-  typedef typename GetFirstRoot<N,Sign,VType::Accuracy>::Result W1;
-  typedef Compute<typename W1::Re,VType::Accuracy> WR;
-  typedef Compute<typename W1::Im,VType::Accuracy> WI;
-  
-  std::vector<T> m_data;
-  
-//  _RootsCompute<N,NList,VType,W1,Sign> comp;
-public:
-  static const long_t Length = (N-1)/2;
-  
-  RootsHolder() { init(); }
-  
-  T* getData() { return &(m_data[0]); }
-  
-  void init()
-  {
-      m_data.resize(2*Length);
-      std::fill(m_data.begin(), m_data.end(), uninitialized_flag);
-//      comp.init(m_data);
-
-      const T wpr = WR::value();
-      const T wpi = WI::value();
-      m_data[0] = wpr;
-      m_data[1] = wpi;
-
-      for (long_t i=2; i<2*Length; i+=2) {
-        m_data[i]   = m_data[i-2]*wpr - m_data[i-1]*wpi;
-        m_data[i+1] = m_data[i-1]*wpr + m_data[i-2]*wpi;
-      }
-  }
-};
-  
-template<long_t N, typename NList, typename VType, int Sign>
-class RootsHolder<N,NList,VType,Sign,false>
-{
-  typedef typename VType::ValueType T;
 public:
-  RootsHolder() {}
-  T* getData() { return NULL; }
-  void init() {}
+   StepRootsHolder() : m_data(2*(K-1)*M)
+   {
+      for (long_t k = 1; k < K; ++k)
+        for (long_t m = 0; m < M; ++m) {
+          const long double a = 2*M_PIl*k*m/(K*M);
+          m_data[2*((k-1)*M + m)]     = static_cast<T>(std::cos(a));
+          m_data[2*((k-1)*M + m) + 1] = static_cast<T>(-S*std::sin(a));
+        }
+   }
+
+   const T* getData() const { return &m_data[0]; }
 };
 
+/// Shared table StepRootsHolder<K,M,T,S>
+template<long_t K, long_t M, typename T, int S>
+struct StepRootsTable : public SharedTable<StepRootsHolder<K,M,T,S> > {};
 
-/// Twiddle factors computation
-/*!
-\tparam T value type
-\tparam N length of the data
-\tparam S sign of the transform (-1 for inverse)
 
-Computes twiddle factors, 
-e.g. cos(2*pi/N),...,cos(2*K*pi/N) and sin(2*pi/N),...,sin(2*K*pi/N).
-It is used for prime factors greater than 3.
+/// Accuracy of the decimal numbers in ConstRoots, sufficient for long double
+static const int ConstRootsAccuracy = 2;
+
+/// Compile-time roots of unity
+/*!
+\tparam N order of the roots
+\tparam S sign of the transform: 1 - forward, -1 - backward
+
+The constexpr arrays re and im hold \f$ \cos(2\pi j/N) \f$ and \f$ S\sin(2\pi j/N) \f$,
+j = 1,...,(N-1)/2, evaluated at compile-time from GenerateRootList.
+The constant factors of the short transforms are derived from them, 
+so these transforms need no initialization.
+\sa ShortDFTOdd
 */
-template<typename T, long_t N, int S, long_t K>
-struct ComputeTwiddles
-{
-  static const long_t K2 = K*2;
-  
-  static void apply(T* c, T* s)
-  {
-    ComputeTwiddles<T,N,S,K-1>::apply(c, s);
-    c[K-1] = Cos<N,K2,T>::value();
-    s[K-1] = S*Sin<N,K2,T>::value();
-  }
-};
+template<long_t N, int S,
+class RList = typename GenerateRootList<N,S,ConstRootsAccuracy>::Result,
+class Seq = std::make_index_sequence<Loki::TL::Length<RList>::value> >
+struct ConstRoots;
 
-template<typename T, long_t N, int S>
-struct ComputeTwiddles<T,N,S,1>
+template<long_t N, int S, class RList, std::size_t... I>
+struct ConstRoots<N,S,RList,std::index_sequence<I...> >
 {
-  static void apply(T* c, T* s)
-  {
-    c[0] = Cos<N,2,T>::value();
-    s[0] = S*Sin<N,2,T>::value();
-  }
+   static constexpr long double re[] = {
+     Compute<typename Loki::TL::TypeAt<RList,I>::Result::first::Value,
+             ConstRootsAccuracy,long double>::value()... };
+   static constexpr long double im[] = {
+     Compute<typename Loki::TL::TypeAt<RList,I>::Result::second::Value,
+             ConstRootsAccuracy,long double>::value()... };
 };
 
-template<typename T, long_t N, int S, long_t K>
-struct ComputeTwiddlesHolder
-{
-  T m_c[K], m_s[K];
-  
-  ComputeTwiddlesHolder() { ComputeTwiddles<T, N, S, K>::apply(m_c, m_s); }
-  T* getCos() { return m_c; }
-  T* getSin() { return m_s; }
-};
+template<long_t N, int S, class RList, std::size_t... I>
+constexpr long double ConstRoots<N,S,RList,std::index_sequence<I...> >::re[];
+
+template<long_t N, int S, class RList, std::size_t... I>
+constexpr long double ConstRoots<N,S,RList,std::index_sequence<I...> >::im[];
 
 ///////////////////////////////////////////////////////////////////
 
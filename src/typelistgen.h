@@ -34,11 +34,22 @@ struct getID<ulong_<N> > {
    static const id_t ID = N-1;
 };
 
+/// Number of the values of a parameter of ListGenerator, which is a type or a Typelist
+template<class TList>
+struct EntryLength {
+   static const ulong_t value = 1;
+};
+
+template<class H, class T>
+struct EntryLength<Loki::Typelist<H,T> > {
+   static const ulong_t value = Loki::TL::Length<Loki::Typelist<H,T> >::value;
+};
+
 /** \class {GFFT::ListGenerator}
     \brief Generates all different combinations of given parameters.
 \tparam TList is one- or two-dimensional (an entry can be a Typelist too) TypeList.
-\tparam TLenList is Typelist of \a ulong_<N>, where N is maximum possible
-        lengths of every Typelist in TList. This array of numbers is used 
+\tparam TLenList is Typelist of \a ulong_<N>, where N is the length of every 
+        entry of TList (see EntryLength). This array of numbers is used 
         to compute unique ID for each generated unique set of parameters.
 \tparam DefTrans is transform definition class. 
         DefineTransform class is substituted here, but also definitions of 
@@ -53,6 +64,8 @@ The parameters are given in the two-dimensional compile-time array.
 This metaprogram takes one parameter from every TList's entry
 and generates Typelist of unique sets of parameters to define Transform.
 The entry may be either a type or a Typelist.
+The ID is the mixed-radix number, whose digits are the positions of the parameters
+in their entries, so the IDs are dense and unique whatever the IDs of the parameters are.
 */
 template<class TList, class TLenList, 
          template<class,id_t> class DefTrans,
@@ -64,7 +77,7 @@ template<class H, class Tail, ulong_t N, class NTail,
          template<class,id_t> class DefTrans, class WorkingList, id_t ID>
 struct ListGenerator<Loki::Typelist<H,Tail>,Loki::Typelist<ulong_<N>,NTail>,DefTrans,WorkingList,ID>
 {
-   static const id_t nextID = (ID*N) + getID<H>::ID;
+   static const id_t nextID = ID*N;
    typedef Loki::Typelist<H,WorkingList> WList;
    typedef typename ListGenerator<Tail,NTail,DefTrans,WList,nextID>::Result Result;
 };
@@ -74,7 +87,8 @@ template<class H, class T, class Tail, ulong_t N, class NTail,
          template<class,id_t> class DefTrans, class WorkingList, id_t ID>
 struct ListGenerator<Loki::Typelist<Loki::Typelist<H,T>,Tail>,Loki::Typelist<ulong_<N>,NTail>,DefTrans,WorkingList,ID>
 {
-   static const id_t nextID = (ID*N) + getID<H>::ID;
+   // position of H in the entry of the length N
+   static const id_t nextID = (ID*N) + N - Loki::TL::Length<Loki::Typelist<H,T> >::value;
    typedef Loki::Typelist<H,WorkingList> WList;
    typedef typename ListGenerator<Loki::Typelist<T,Tail>,Loki::Typelist<ulong_<N>,NTail>,DefTrans,WorkingList,ID>::Result L1;
    typedef typename ListGenerator<Tail,NTail,DefTrans,WList,nextID>::Result L2;
@@ -85,7 +99,7 @@ template<class H, class Tail, ulong_t N, class NTail,
          template<class,id_t> class DefTrans, class WorkingList, id_t ID>
 struct ListGenerator<Loki::Typelist<Loki::Typelist<H,Loki::NullType>,Tail>,Loki::Typelist<ulong_<N>,NTail>,DefTrans,WorkingList,ID>
 {
-   static const id_t nextID = (ID*N) + getID<H>::ID;
+   static const id_t nextID = (ID*N) + N - 1;
    typedef Loki::Typelist<H,WorkingList> WList;
    typedef typename ListGenerator<Tail,NTail,DefTrans,WList,nextID>::Result Result;
 };
@@ -43,6 +43,33 @@ typedef TYPELIST_3(OpenMP<2>, OpenMP<4>, OpenMP<8>) ParallList;
 typedef GenPowerList<Min, Max, N>::Result NList;
 typedef GenerateTransform<NList, VType, TransformTypeGroup::Default, ulong_<1>, ParallList, Place> Trans;
 
+// the other decimations of the lengths 125, 15 and 64 with parallel batches
+typedef TYPELIST_3(ulong_<125>, ulong_<15>, ulong_<64>) AlgNList;
+typedef GenerateTransform<AlgNList, VType, TransformTypeGroup::Default, ulong_<1>, OpenMP<4>, Place, 
+                          TYPELIST_5(SPLITRADIX, INFREQ, SCRAMBLED, STOCKHAM, PRIMEFACTOR)> TransAlg;
+// SCRAMBLED is not in natural order
+typedef GenerateTransform<AlgNList, VType, TransformTypeGroup::Default, ulong_<1>, OpenMP<4>, Place, 
+                          TYPELIST_4(SPLITRADIX, INFREQ, STOCKHAM, PRIMEFACTOR)> TransAlgNatural;
+
+// Bluestein (131), Rader (17*8) and the codelets of the radices 11 and 13
+typedef GenerateTransform<TYPELIST_4(ulong_<131>, ulong_<136>, ulong_<1331>, ulong_<169>), VType, 
+                          TransformTypeGroup::Default, ulong_<1>, Serial, Place> TransPrime;
+
+// cosine transforms and MDCT of the even and odd half lengths
+typedef TYPELIST_8(DCT1, IDCT1, DCT2, IDCT2, DCT4, IDCT4, MDCT, IMDCT) CosineTypes;
+typedef GenerateTransform<TYPELIST_2(ulong_<8>, ulong_<15>), VType, CosineTypes, ulong_<1>, Serial, Place> TransCos;
+
+// split-complex value types, serial and with the parallel batches
+typedef TYPELIST_3(ulong_<1024>, ulong_<385>, ulong_<131>) SplitNList;
+typedef TYPELIST_2(Serial, OpenMP<4>) SplitParallList;
+typedef GenerateTransform<SplitNList, SPLIT_DOUBLE, TYPELIST_2(DFT, IDFT), ulong_<1>, SplitParallList, Place> TransSplitD;
+typedef GenerateTransform<SplitNList, SPLIT_FLOAT, TYPELIST_2(DFT, IDFT), ulong_<1>, SplitParallList, Place> TransSplitF;
+
+// the policies with the large IDs and several decimations in one object factory
+typedef TYPELIST_5(Serial, ThreadPool<2>, ThreadPool<10>, OpenMPTasks<4>, OpenMPRuntime<8>) FactoryParallList;
+typedef GenerateTransform<TYPELIST_3(ulong_<1024>, ulong_<64>, ulong_<15>), VType, TYPELIST_2(DFT, IDFT), ulong_<1>,
+                          FactoryParallList, Place, TYPELIST_3(INTIME, SPLITRADIX, STOCKHAM)> TransFactory;
+
 ostream& operator<<(ostream& os, const dd_real& v)
 {
   os << v.to_string(16);
@@ -83,6 +110,90 @@ int main(int argc, char *argv[])
   GFFTcheck<Trans::Result, DFT_wrapper<dd_real>, Place> check_dft;
   check_dft.apply();
   cout << Place::name() << ", " << VType::name() << ", " << N << "^[" << Min << "," << Max << "]: " << MaxRelError << endl;
+
+  MaxRelError = 0;
+  GFFTcheck<TransPrime::Result, DFT_wrapper<dd_real>, Place> check_prime;
+  check_prime.apply();
+  cout << Place::name() << ", " << VType::name() << ", prime radices: " << MaxRelError << endl;
+
+  MaxRelError = 0;
+  GFFTcheck<TransAlgNatural::Result, DFT_wrapper<dd_real>, Place> check_alg;
+  check_alg.apply();
+  cout << Place::name() << ", " << VType::name() << ", decimations: " << MaxRelError << endl;
+
+  // strided batches (fft_many) vs. single transforms
+  GFFTBatchCheck<Trans::Result, Place> check_batch;
+  check_batch.apply();
+  GFFTBatchCheck<TransAlg::Result, Place> check_batch_alg;
+  check_batch_alg.apply();
+  cout << Place::name() << ", " << VType::name() << ", fft_many: " << MaxBatchError << endl;
+
+  // digit-reversed spectrum of SCRAMBLED: round trip and convolution
+  ScrambledCheck<1024, VType> check_scr;
+  check_scr.apply();
+  ScrambledCheck<2187, VType, OpenMP<4> > check_scr_par;
+  check_scr_par.apply();
+  ScrambledCheck<1000, VType> check_scr_mixed;
+  check_scr_mixed.apply();
+  cout << VType::name() << ", SCRAMBLED: " << MaxScrambledError << endl;
+
+  // unpacking of the real two- and three-dimensional spectrum
+  MultiDimRealCheck<8, 2, VType, Place> check_2d;
+  check_2d.apply();
+  MultiDimRealCheck<6, 3, VType, Place> check_3d;
+  check_3d.apply();
+  cout << Place::name() << ", " << VType::name() << ", multidimensional RDFT: " << MaxMultiDimError << endl;
+
+  // defining sums of the cosine transforms and the overlap-add of MDCT frames
+  CosineCheck<TransCos::Result, Place> check_cos;
+  check_cos.apply();
+  cout << Place::name() << ", " << VType::name() << ", DCT and MDCT: " << MaxCosineError << endl;
+  TDACCheck<16, VType, Place> check_tdac;
+  check_tdac.apply();
+  TDACCheck<15, VType, Place> check_tdac_odd;
+  check_tdac_odd.apply();
+  cout << Place::name() << ", " << VType::name() << ", MDCT overlap-add: " << MaxTDACError << endl;
+
+  // split format vs. interleaved transforms
+  SplitCheck<TransSplitD::Result, Place> check_split_d;
+  check_split_d.apply();
+  SplitCheck<TransSplitF::Result, Place> check_split_f;
+  check_split_f.apply();
+  MaxBatchError = 0;
+  GFFTBatchCheck<TransSplitD::Result, Place> check_split_batch_d;
+  check_split_batch_d.apply();
+  GFFTBatchCheck<TransSplitF::Result, Place> check_split_batch_f;
+  check_split_batch_f.apply();
+  cout << Place::name() << ", split types: " << MaxSplitError << ", fft_many: " << MaxBatchError << endl;
+
+  // OpenMPRuntime for 1, 3 and 6 threads vs. serial transform
+  RuntimeThreadsCheck<512, VType, Place> check_rt_short;
+  check_rt_short.apply();
+  RuntimeThreadsCheck<2187, VType, Place> check_rt_odd;
+  check_rt_odd.apply();
+  RuntimeThreadsCheck<1000, VType, Place> check_rt_mixed;
+  check_rt_mixed.apply();
+  cout << Place::name() << ", " << VType::name() << ", OpenMPRuntime: " << MaxRuntimeThreadsError << endl;
+
+  // the other parallelization policies vs. serial transform above CobraThreshold
+  typedef TYPELIST_4(OpenMP<4>, ThreadPool<4>, OpenMPTasks<4>, OpenMPTasks<3>) PolicyList;
+  ParallelCheck<(1<<15), VType, Place, PolicyList> check_par2;
+  check_par2.apply();
+  ParallelCheck<59049, VType, Place, PolicyList> check_par3;
+  check_par3.apply();
+  cout << Place::name() << ", " << VType::name() << ", parallel policies: " << MaxParallError << endl;
+
+  // lengths out of NList are planned at run-time by CreateTransformObject
+  RuntimePlanCheck<Trans> check_plan;
+  check_plan.apply(131);
+  check_plan.apply(231, OpenMP<4>::ID);
+  check_plan.apply(1000, OpenMP<4>::ID);
+  cout << Place::name() << ", " << VType::name() << ", run-time plan: " << MaxRuntimePlanError << endl;
+
+  TransFactory factory;
+  FactoryCheck<TransFactory> check_factory;
+  check_factory.apply(factory);
+  cout << Place::name() << ", " << VType::name() << ", object factory mismatches: " << FactoryMismatches << endl;
   
 //   cout << "GFFT vs. FFTW:" << endl;
 //   GFFTcheck<Trans::Result, FFTW_wrapper<fftw_complex>, Place> check_fftw;
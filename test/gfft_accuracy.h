@@ -20,6 +20,7 @@
 */
 
 #include <iostream>
+#include <typeinfo>
 
 #include "gfft.h"
 #include "direct.h"
@@ -276,6 +277,913 @@ public:
   void apply() { }
 };
 
+//============================================================
+
+static double MaxBatchError = 0;
+
+/// Compares the batch of strided transforms (fft_many) with the single transforms
+/*! The batch of B transforms is interleaved: the element j of the transform b
+    is located at j*B+b. The batch runs in parallel, if the transform is serial.
+    Only the real numbers written by the transform are compared (see TransformLength).
+*/
+template<class TList, class Place>
+class GFFTBatchCheck;
+
+template<class H, class Tail>
+class GFFTBatchCheck<Loki::Typelist<H,Tail>, IN_PLACE>
+{
+  typedef typename H::ValueType::ValueType T1;
+  typedef typename H::ValueType::base_type BT;
+  GFFTBatchCheck<Tail,IN_PLACE> next;
+
+  static const int C = Loki::TypeTraits<T1>::isStdFundamental ? 2 : 1;
+  typedef TransformLength<typename H::TransformType, H::Len> Length;
+  // complex elements of the data array
+  static const long_t NE = ((Length::In > Length::Out ? Length::In : Length::Out) + 1)/2;
+  static const long_t B = 3;
+
+  typename H::Instance gfft;
+
+public:
+  void apply()
+  {
+    next.apply();
+
+    T1 *input = new T1 [NE*B*C];
+    T1 *data = new T1 [NE*B*C];
+    T1 *single = new T1 [NE*C];
+
+    for (long_t i=0; i < NE*B; ++i)
+      GenInput<T1>::rand(input, i);
+    for (long_t i=0; i < NE*B*C; ++i)
+      data[i] = input[i];
+
+    gfft.fft_many(data, B, B, 1);
+
+    BT d = 0, e = 0;
+    for (long_t b=0; b < B; ++b) {
+      for (long_t j=0; j < NE; ++j)
+        for (int c=0; c < C; ++c)
+          single[j*C+c] = input[(j*B+b)*C+c];
+      gfft.fft(single);
+      const BT* s = reinterpret_cast<const BT*>(single);
+      const BT* p = reinterpret_cast<const BT*>(data);
+      for (long_t k=0; k < Length::Out; ++k) {
+        d = std::max(d, BT(fabs(s[k])));
+        e = std::max(e, BT(fabs(s[k] - p[((k/2)*B+b)*2 + k%2])));
+      }
+    }
+    delete [] single;
+    delete [] data;
+    delete [] input;
+
+    if (MaxBatchError < e/d) MaxBatchError = e/d;
+  }
+};
+
+template<class H, class Tail>
+class GFFTBatchCheck<Loki::Typelist<H,Tail>, OUT_OF_PLACE>
+{
+  typedef typename H::ValueType::ValueType T1;
+  typedef typename H::ValueType::base_type BT;
+  GFFTBatchCheck<Tail,OUT_OF_PLACE> next;
+
+  static const int C = Loki::TypeTraits<T1>::isStdFundamental ? 2 : 1;
+  typedef TransformLength<typename H::TransformType, H::Len> Length;
+  // complex elements of the input and output arrays
+  static const long_t NIn = (Length::In + 1)/2;
+  static const long_t NOut = (Length::Out + 1)/2;
+  static const long_t B = 3;
+
+  typename H::Instance gfft;
+
+public:
+  void apply()
+  {
+    next.apply();
+
+    T1 *src = new T1 [NIn*B*C];
+    T1 *dst = new T1 [NOut*B*C];
+    T1 *in = new T1 [NIn*C];
+    T1 *out = new T1 [NOut*C];
+
+    for (long_t i=0; i < NIn*B; ++i)
+      GenInput<T1>::rand(src, i);
+
+    gfft.fft_many(src, dst, B, B, 1);
+
+    BT d = 0, e = 0;
+    for (long_t b=0; b < B; ++b) {
+      for (long_t j=0; j < NIn; ++j)
+        for (int c=0; c < C; ++c)
+          in[j*C+c] = src[(j*B+b)*C+c];
+      gfft.fft(in, out);
+      const BT* s = reinterpret_cast<const BT*>(out);
+      const BT* p = reinterpret_cast<const BT*>(dst);
+      for (long_t k=0; k < Length::Out; ++k) {
+        d = std::max(d, BT(fabs(s[k])));
+        e = std::max(e, BT(fabs(s[k] - p[((k/2)*B+b)*2 + k%2])));
+      }
+    }
+    delete [] out;
+    delete [] in;
+    delete [] dst;
+    delete [] src;
+
+    if (MaxBatchError < e/d) MaxBatchError = e/d;
+  }
+};
+
+template<class Place>
+class GFFTBatchCheck<Loki::NullType, Place> {
+public:
+  void apply() { }
+};
+
+//============================================================
+
+static double MaxMultiDimError = 0;
+
+/// Checks the packed spectrum of the multidimensional RDFT (see MultiDim)
+/*! The column zero is unpacked into \f$ Y_{q,0} \f$ and \f$ Y_{q,N} \f$ 
+    and compared with the direct DFT of the real array \f$ N^{Dim-1} \times 2N \f$.
+*/
+template<long_t N, long_t Dim, class VType, class Place>
+class MultiDimRealCheck
+{
+  typedef typename VType::ValueType T1;
+  typedef typename VType::base_type BT;
+  static const int C = Loki::TypeTraits<T1>::isStdFundamental ? 2 : 1;
+  static const long_t NRows = DimLength<N,Dim-1>::value;
+
+  typename Transform<ulong_<N>,VType,RDFT,ulong_<Dim>,Serial,Place>::Instance gfft;
+
+  void run(T1* data, T1* out, Loki::Int2Type<IN_PLACE::ID>) 
+  { 
+    for (long_t i=0; i < NRows*N*C; ++i)
+      out[i] = data[i];
+    gfft.fft(out); 
+  }
+  void run(T1* data, T1* out, Loki::Int2Type<OUT_OF_PLACE::ID>) { gfft.fft(data, out); }
+
+  // scalar product of the multi-indices of the rows r and q
+  static long_t dot(long_t r, long_t q) 
+  {
+    long_t s = 0;
+    for (long_t d=1; d < Dim; ++d, r /= N, q /= N)
+      s += (r%N)*(q%N);
+    return s%N;
+  }
+
+  // multi-index -q modulo N
+  static long_t neg(long_t q) 
+  {
+    long_t m = 0, p = 1;
+    for (long_t d=1; d < Dim; ++d, q /= N, p *= N)
+      m += ((N - q%N)%N)*p;
+    return m;
+  }
+
+public:
+  void apply()
+  {
+    T1 *data = new T1 [NRows*N*C];
+    T1 *out = new T1 [NRows*N*C];
+
+    for (long_t i=0; i < NRows*N; ++i)
+      GenInput<T1>::rand(data, i);
+
+    run(data, out, Loki::Int2Type<Place::ID>());
+
+    const BT* x = reinterpret_cast<const BT*>(data);
+    const BT* y = reinterpret_cast<const BT*>(out);
+    double d = 0, e = 0;
+    for (long_t q=0; q < NRows; ++q)
+      for (long_t k=0; k <= N; ++k) {
+        double re = 0, im = 0;
+        for (long_t r=0; r < NRows; ++r)
+          for (long_t j=0; j < 2*N; ++j) {
+            const double a = -M_PI*(j*k + 2*dot(r,q))/N;
+            re += x[2*N*r + j]*cos(a);
+            im += x[2*N*r + j]*sin(a);
+          }
+        double gr, gi;
+        if (k > 0 && k < N) {
+          gr = y[2*N*q + 2*k];
+          gi = y[2*N*q + 2*k + 1];
+        }
+        else {
+          // Z_q and conj(Z_-q)
+          const double zr = y[2*N*q], zi = y[2*N*q + 1];
+          const double cr = y[2*N*neg(q)], ci = -y[2*N*neg(q) + 1];
+          gr = (k == 0) ? (zr + cr)/2 : (zi - ci)/2;
+          gi = (k == 0) ? (zi + ci)/2 : (cr - zr)/2;
+        }
+        d = std::max(d, std::max(fabs(re), fabs(im)));
+        e = std::max(e, std::max(fabs(gr - re), fabs(gi - im)));
+      }
+    delete [] out;
+    delete [] data;
+
+    if (MaxMultiDimError < e/d) MaxMultiDimError = e/d;
+  }
+};
+
+//============================================================
+
+static double MaxRuntimeThreadsError = 0;
+
+/// Compares OpenMPRuntime<NTMax> with the serial transform for several run-time thread counts
+/*! The lengths from SwitchToOMP are split into the blocks at compile time,
+    also the odd ones and those not above NTMax*NTMax (see OpenMPRuntime).
+    The in-place transforms of the lengths, which are not the powers of a prime, run serially.
+*/
+template<long_t N, class VType, class Place, unsigned int NTMax = 32>
+class RuntimeThreadsCheck
+{
+  typedef typename VType::ValueType T1;
+  typedef typename VType::base_type BT;
+  static const int C = Loki::TypeTraits<T1>::isStdFundamental ? 2 : 1;
+  typedef OpenMPRuntime<NTMax> Parall;
+
+  static_assert(!Loki::IsSameType<typename Parall::template ActualParall<N>::Result, Serial>::value,
+                "The length is not split by OpenMPRuntime");
+
+  typedef typename Transform<ulong_<N>,VType,DFT,ulong_<1>,Serial,Place>::Instance SerialType;
+  typedef typename Transform<ulong_<N>,VType,DFT,ulong_<1>,Parall,Place>::Instance ParallType;
+
+  template<class Tr>
+  static void run(Tr& gfft, T1* data, T1* out, Loki::Int2Type<IN_PLACE::ID>) 
+  { 
+    for (long_t i=0; i < N*C; ++i)
+      out[i] = data[i];
+    gfft.fft(out); 
+  }
+  template<class Tr>
+  static void run(Tr& gfft, T1* data, T1* out, Loki::Int2Type<OUT_OF_PLACE::ID>) { gfft.fft(data, out); }
+
+public:
+  void apply()
+  {
+    T1 *data = new T1 [N*C];
+    T1 *ref = new T1 [N*C];
+    T1 *out = new T1 [N*C];
+
+    for (long_t i=0; i < N; ++i)
+      GenInput<T1>::rand(data, i);
+
+    SerialType serial;
+    run(serial, data, ref, Loki::Int2Type<Place::ID>());
+
+    const int nthreads[] = {1, 3, 6};
+    const BT* r = reinterpret_cast<const BT*>(ref);
+    const BT* p = reinterpret_cast<const BT*>(out);
+    BT d = norm_inf(r, 2*N), e = 0;
+    for (int t=0; t < 3; ++t) {
+      // the transform object takes the number of threads in its constructor
+      RuntimeThreads::set(nthreads[t]);
+      ParallType gfft;
+      run(gfft, data, out, Loki::Int2Type<Place::ID>());
+      for (long_t k=0; k < 2*N; ++k)
+        e = std::max(e, BT(fabs(p[k] - r[k])));
+    }
+    RuntimeThreads::set(0);
+    delete [] out;
+    delete [] ref;
+    delete [] data;
+
+    if (MaxRuntimeThreadsError < e/d) MaxRuntimeThreadsError = e/d;
+  }
+};
+
+//============================================================
+
+static double MaxRuntimePlanError = 0;
+
+/// Checks the transforms, which are not generated by GenerateTransform, against the direct DFT
+/*! CreateTransformObject plans such a length at run-time (see RuntimeTransform).
+    The single transform is compared with the direct DFT,
+    the batch of B interleaved transforms (fft_many) with the single ones.
+*/
+template<class Gen>
+class RuntimePlanCheck
+{
+  typedef typename Gen::Result::Head::ValueType VType;
+  typedef typename Gen::PlaceType Place;
+  typedef typename Gen::ObjectType ObjectType;
+  typedef typename VType::ValueType T1;
+  typedef typename VType::base_type BT;
+  static const int C = Loki::TypeTraits<T1>::isStdFundamental ? 2 : 1;
+  static const long_t B = 3;
+
+  Gen gen;
+
+  static void run(ObjectType* gfft, T1* data, T1* out, long_t n, Loki::Int2Type<IN_PLACE::ID>) 
+  { 
+    for (long_t i=0; i < n*C; ++i)
+      out[i] = data[i];
+    gfft->fft(out); 
+  }
+  static void run(ObjectType* gfft, T1* data, T1* out, long_t, Loki::Int2Type<OUT_OF_PLACE::ID>) 
+  { 
+    gfft->fft(data, out); 
+  }
+  static void run_many(ObjectType* gfft, T1* data, T1* out, long_t n, Loki::Int2Type<IN_PLACE::ID>) 
+  { 
+    for (long_t i=0; i < n*B*C; ++i)
+      out[i] = data[i];
+    gfft->fft_many(out, B, B, 1); 
+  }
+  static void run_many(ObjectType* gfft, T1* data, T1* out, long_t, Loki::Int2Type<OUT_OF_PLACE::ID>) 
+  { 
+    gfft->fft_many(data, out, B, B, 1); 
+  }
+
+public:
+  void apply(const long_t n, const ulong_t parall_id = Serial::ID)
+  {
+    ObjectType* gfft = gen.CreateTransformObject(n, VType::ID, DFT::ID, 1, parall_id, Place::ID);
+
+    T1 *data = new T1 [n*B*C];
+    T1 *out = new T1 [n*B*C];
+    for (long_t i=0; i < n*B; ++i)
+      GenInput<T1>::rand(data, i);
+
+    run(gfft, data, out, n, Loki::Int2Type<Place::ID>());
+
+    const BT* x = reinterpret_cast<const BT*>(data);
+    const BT* y = reinterpret_cast<const BT*>(out);
+    double d = 0, e = 0;
+    for (long_t k=0; k < n; ++k) {
+      double re = 0, im = 0;
+      for (long_t j=0; j < n; ++j) {
+        const double a = -2*M_PI*((j*k)%n)/n;
+        re += x[2*j]*cos(a) - x[2*j+1]*sin(a);
+        im += x[2*j]*sin(a) + x[2*j+1]*cos(a);
+      }
+      d = std::max(d, std::max(fabs(re), fabs(im)));
+      e = std::max(e, std::max(fabs(y[2*k] - re), fabs(y[2*k+1] - im)));
+    }
+    if (MaxRuntimePlanError < e/d) MaxRuntimePlanError = e/d;
+
+    // the batch, the transform b takes the elements j*B+b
+    T1 *batch = new T1 [n*B*C];
+    T1 *in = new T1 [n*C];
+    run_many(gfft, data, batch, n, Loki::Int2Type<Place::ID>());
+    const BT* p = reinterpret_cast<const BT*>(batch);
+    e = 0;
+    for (long_t b=0; b < B; ++b) {
+      for (long_t j=0; j < n; ++j)
+        for (int c=0; c < C; ++c)
+          in[j*C+c] = data[(j*B+b)*C+c];
+      run(gfft, in, out, n, Loki::Int2Type<Place::ID>());
+      for (long_t k=0; k < 2*n; ++k)
+        e = std::max(e, static_cast<double>(fabs(y[k] - p[((k/2)*B+b)*2 + k%2])));
+    }
+    if (MaxRuntimePlanError < e/d) MaxRuntimePlanError = e/d;
+
+    delete [] in;
+    delete [] batch;
+    delete [] out;
+    delete [] data;
+    delete gfft;
+  }
+};
+
+//============================================================
+
+static double MaxCosineError = 0;
+
+/// Defining sums of the cosine transforms, N is the template parameter of the transform
+/*! The normalization of the inverse transforms is described in gfftdct.h */
+template<class Type>
+struct DirectCosine;
+
+template<>
+struct DirectCosine<DCT1> {
+  static void apply(const double* x, double* y, const long_t N)
+  {
+    const long_t n = 2*N;
+    for (long_t k=0; k <= n; ++k) {
+      double s = x[0] + ((k%2) ? -x[n] : x[n]);
+      for (long_t j=1; j < n; ++j)
+        s += 2*x[j]*cos(M_PI*((j*k)%(2*n))/n);
+      y[k] = s;
+    }
+  }
+};
+
+template<>
+struct DirectCosine<IDCT1> {
+  static void apply(const double* x, double* y, const long_t N)
+  {
+    DirectCosine<DCT1>::apply(x, y, N);
+    for (long_t k=0; k <= 2*N; ++k)
+      y[k] /= 4*N;
+  }
+};
+
+template<>
+struct DirectCosine<DCT2> {
+  static void apply(const double* x, double* y, const long_t N)
+  {
+    const long_t n = 2*N;
+    for (long_t k=0; k < n; ++k) {
+      double s = 0;
+      for (long_t j=0; j < n; ++j)
+        s += x[j]*cos(M_PI*(((2*j+1)*k)%(4*n))/(2*n));
+      y[k] = 2*s;
+    }
+  }
+};
+
+template<>
+struct DirectCosine<IDCT2> {
+  static void apply(const double* x, double* y, const long_t N)
+  {
+    const long_t n = 2*N;
+    for (long_t j=0; j < n; ++j) {
+      double s = x[0]/2;
+      for (long_t k=1; k < n; ++k)
+        s += x[k]*cos(M_PI*(((2*j+1)*k)%(4*n))/(2*n));
+      y[j] = s/n;
+    }
+  }
+};
+
+template<>
+struct DirectCosine<DCT4> {
+  static void apply(const double* x, double* y, const long_t N)
+  {
+    const long_t n = 2*N;
+    for (long_t k=0; k < n; ++k) {
+      double s = 0;
+      for (long_t j=0; j < n; ++j)
+        s += x[j]*cos(M_PI*(((2*j+1)*(2*k+1))%(8*n))/(4*n));
+      y[k] = s;
+    }
+  }
+};
+
+template<>
+struct DirectCosine<IDCT4> {
+  static void apply(const double* x, double* y, const long_t N)
+  {
+    DirectCosine<DCT4>::apply(x, y, N);
+    for (long_t k=0; k < 2*N; ++k)
+      y[k] /= N;
+  }
+};
+
+template<>
+struct DirectCosine<MDCT> {
+  static void apply(const double* x, double* y, const long_t N)
+  {
+    const long_t M = 2*N;
+    for (long_t k=0; k < M; ++k) {
+      double s = 0;
+      for (long_t j=0; j < 2*M; ++j)
+        s += x[j]*cos(M_PI*(((2*j+1+M)*(2*k+1))%(8*M))/(4*M));
+      y[k] = s;
+    }
+  }
+};
+
+template<>
+struct DirectCosine<IMDCT> {
+  static void apply(const double* x, double* y, const long_t N)
+  {
+    const long_t M = 2*N;
+    for (long_t j=0; j < 2*M; ++j) {
+      double s = 0;
+      for (long_t k=0; k < M; ++k)
+        s += x[k]*cos(M_PI*(((2*j+1+M)*(2*k+1))%(8*M))/(4*M));
+      y[j] = s/M;
+    }
+  }
+};
+
+/// Compares the cosine transforms and MDCT with their defining sums (see DirectCosine)
+/*! Only the real numbers read and written by the transform are used (see TransformLength).
+*/
+template<class TList, class Place>
+class CosineCheck;
+
+template<class H, class Tail, class Place>
+class CosineCheck<Loki::Typelist<H,Tail>, Place>
+{
+  typedef typename H::ValueType::ValueType T1;
+  typedef typename H::ValueType::base_type BT;
+  typedef typename H::TransformType Type;
+  CosineCheck<Tail,Place> next;
+
+  static const int C = Loki::TypeTraits<T1>::isStdFundamental ? 2 : 1;
+  static const long_t N = H::Len;
+  typedef TransformLength<Type,N> Length;
+  // complex elements of the data arrays
+  static const long_t NE = ((Length::In > Length::Out ? Length::In : Length::Out) + 1)/2;
+
+  typename H::Instance gfft;
+
+  void run(T1* data, T1* out, Loki::Int2Type<IN_PLACE::ID>) 
+  { 
+    for (long_t i=0; i < NE*C; ++i)
+      out[i] = data[i];
+    gfft.fft(out); 
+  }
+  void run(T1* data, T1* out, Loki::Int2Type<OUT_OF_PLACE::ID>) { gfft.fft(data, out); }
+
+public:
+  void apply()
+  {
+    next.apply();
+
+    T1 *data = new T1 [NE*C];
+    T1 *out = new T1 [NE*C];
+    double *x = new double [2*NE];
+    double *y = new double [2*NE];
+
+    for (long_t i=0; i < NE; ++i)
+      GenInput<T1>::rand(data, i);
+
+    run(data, out, Loki::Int2Type<Place::ID>());
+
+    const BT* b = reinterpret_cast<const BT*>(data);
+    const BT* p = reinterpret_cast<const BT*>(out);
+    for (long_t i=0; i < Length::In; ++i)
+      x[i] = b[i];
+    DirectCosine<Type>::apply(x, y, N);
+
+    double d = 0, e = 0;
+    for (long_t k=0; k < Length::Out; ++k) {
+      d = std::max(d, fabs(y[k]));
+      e = std::max(e, fabs(p[k] - y[k]));
+    }
+    delete [] y;
+    delete [] x;
+    delete [] out;
+    delete [] data;
+
+    if (MaxCosineError < e/d) MaxCosineError = e/d;
+  }
+};
+
+template<class Place>
+class CosineCheck<Loki::NullType, Place> {
+public:
+  void apply() { }
+};
+
+//============================================================
+
+static double MaxTDACError = 0;
+
+/// Checks the time domain aliasing cancellation of MDCT and IMDCT
+/*! The frames of 4N real numbers overlap by 2N. The sum of the second half 
+    of IMDCT of a frame and the first half of IMDCT of the next frame restores 
+    the input between them. The same is checked for the windowed frames 
+    of MDCTOverlapAdd, whose every synthesis returns 2N restored numbers
+    from the second frame on.
+*/
+template<long_t N, class VType, class Place>
+class TDACCheck
+{
+  typedef typename VType::ValueType T1;
+  typedef typename VType::base_type BT;
+  static const int C = Loki::TypeTraits<T1>::isStdFundamental ? 2 : 1;
+  static const long_t F = 4;     // number of frames
+  static const long_t NE = N;    // complex elements of 2N real numbers
+
+  typename Transform<ulong_<N>,VType,MDCT,ulong_<1>,Serial,Place>::Instance mdct;
+  typename Transform<ulong_<N>,VType,IMDCT,ulong_<1>,Serial,Place>::Instance imdct;
+
+  // 4N real numbers of the frame into 2N coefficients
+  void run_mdct(const T1* frame, T1* coef, Loki::Int2Type<IN_PLACE::ID>) 
+  { 
+    T1 *buf = new T1 [2*NE*C];
+    for (long_t i=0; i < 2*NE*C; ++i)
+      buf[i] = frame[i];
+    mdct.fft(buf); 
+    for (long_t i=0; i < NE*C; ++i)
+      coef[i] = buf[i];
+    delete [] buf;
+  }
+  void run_mdct(const T1* frame, T1* coef, Loki::Int2Type<OUT_OF_PLACE::ID>) { mdct.fft(frame, coef); }
+
+  // 2N coefficients into 4N real numbers
+  void run_imdct(const T1* coef, T1* y, Loki::Int2Type<IN_PLACE::ID>) 
+  { 
+    for (long_t i=0; i < NE*C; ++i)
+      y[i] = coef[i];
+    imdct.fft(y); 
+  }
+  void run_imdct(const T1* coef, T1* y, Loki::Int2Type<OUT_OF_PLACE::ID>) { imdct.fft(coef, y); }
+
+public:
+  void apply()
+  {
+    const long_t L = (F+1)*2*N;
+    T1 *signal = new T1 [(F+1)*NE*C];
+    T1 *coef = new T1 [NE*C];
+    T1 *y = new T1 [2*NE*C];
+    double *out = new double [L];
+
+    for (long_t i=0; i < (F+1)*NE; ++i)
+      GenInput<T1>::rand(signal, i);
+    for (long_t i=0; i < L; ++i)
+      out[i] = 0;
+
+    const BT* x = reinterpret_cast<const BT*>(signal);
+    const BT* p = reinterpret_cast<const BT*>(y);
+    for (long_t f=0; f < F; ++f) {
+      run_mdct(signal + f*NE*C, coef, Loki::Int2Type<Place::ID>());
+      run_imdct(coef, y, Loki::Int2Type<Place::ID>());
+      for (long_t i=0; i < 4*N; ++i)
+        out[f*2*N + i] += p[i];
+    }
+
+    double d = 0, e = 0;
+    for (long_t i=2*N; i < F*2*N; ++i) {
+      d = std::max(d, fabs(double(x[i])));
+      e = std::max(e, fabs(out[i] - x[i]));
+    }
+
+    // windowed frames
+    MDCTOverlapAdd<N,VType> tdac;
+    for (long_t f=0; f < F; ++f) {
+      tdac.analysis(signal + f*NE*C, coef);
+      tdac.synthesis(coef, y);
+      for (long_t i=0; i < 2*N && f > 0; ++i)
+        e = std::max(e, fabs(double(p[i] - x[f*2*N + i])));
+    }
+    delete [] out;
+    delete [] y;
+    delete [] coef;
+    delete [] signal;
+
+    if (MaxTDACError < e/d) MaxTDACError = e/d;
+  }
+};
+
+//============================================================
+
+static double MaxSplitError = 0;
+
+/// Compares the split-complex transforms with the interleaved ones of the same precision
+/*! The input is generated interleaved and converted into N real parts 
+    followed by N imaginary parts, the output is converted back. 
+    The interleaved transform of VType::InterleavedType is serial.
+*/
+template<class TList, class Place>
+class SplitCheck;
+
+template<class H, class Tail, class Place>
+class SplitCheck<Loki::Typelist<H,Tail>, Place>
+{
+  typedef typename H::ValueType VType;
+  typedef typename VType::ValueType T1;
+  typedef typename VType::InterleavedType IType;
+  SplitCheck<Tail,Place> next;
+
+  static const long_t N = H::Len;
+
+  typename H::Instance gfft;
+  typename Transform<ulong_<N>,IType,typename H::TransformType,ulong_<1>,Serial,Place>::Instance ref;
+
+  template<class Tr>
+  static void run(Tr& fft, T1* data, T1* out, Loki::Int2Type<IN_PLACE::ID>) 
+  { 
+    for (long_t i=0; i < 2*N; ++i)
+      out[i] = data[i];
+    fft.fft(out); 
+  }
+  template<class Tr>
+  static void run(Tr& fft, T1* data, T1* out, Loki::Int2Type<OUT_OF_PLACE::ID>) { fft.fft(data, out); }
+
+public:
+  void apply()
+  {
+    next.apply();
+
+    T1 *data = new T1 [2*N];
+    T1 *out = new T1 [2*N];
+    T1 *split = new T1 [2*N];
+    T1 *sout = new T1 [2*N];
+
+    for (long_t i=0; i < N; ++i)
+      GenInput<T1>::rand(data, i);
+    for (long_t i=0; i < N; ++i) {
+      split[i] = data[2*i];
+      split[N+i] = data[2*i+1];
+    }
+
+    run(ref, data, out, Loki::Int2Type<Place::ID>());
+    run(gfft, split, sout, Loki::Int2Type<Place::ID>());
+
+    T1 d = norm_inf(out, 2*N), e = 0;
+    for (long_t i=0; i < N; ++i) {
+      e = std::max(e, T1(fabs(sout[i] - out[2*i])));
+      e = std::max(e, T1(fabs(sout[N+i] - out[2*i+1])));
+    }
+    delete [] sout;
+    delete [] split;
+    delete [] out;
+    delete [] data;
+
+    if (MaxSplitError < e/d) MaxSplitError = e/d;
+  }
+};
+
+template<class Place>
+class SplitCheck<Loki::NullType, Place> {
+public:
+  void apply() { }
+};
+
+//============================================================
+
+static double MaxScrambledError = 0;
+
+/// Checks the in-place DFT and IDFT of SCRAMBLED, which skip the digit reversal
+/*! The inverse transform of the forward one restores the input.
+    The pointwise product of two spectra in digit-reversed order transformed back
+    is compared with the direct cyclic convolution.
+*/
+template<long_t N, class VType, class Parall = Serial>
+class ScrambledCheck
+{
+  typedef typename VType::ValueType T1;
+  typedef typename VType::base_type BT;
+  static const int C = Loki::TypeTraits<T1>::isStdFundamental ? 2 : 1;
+
+  typename Transform<ulong_<N>,VType,DFT,ulong_<1>,Parall,IN_PLACE,SCRAMBLED>::Instance fwd;
+  typename Transform<ulong_<N>,VType,IDFT,ulong_<1>,Parall,IN_PLACE,SCRAMBLED>::Instance inv;
+
+public:
+  void apply()
+  {
+    T1 *a = new T1 [N*C];
+    T1 *b = new T1 [N*C];
+    T1 *fa = new T1 [N*C];
+    T1 *fb = new T1 [N*C];
+
+    for (long_t i=0; i < N; ++i) {
+      GenInput<T1>::rand(a, i);
+      GenInput<T1>::rand(b, i);
+    }
+    for (long_t i=0; i < N*C; ++i) {
+      fa[i] = a[i];
+      fb[i] = b[i];
+    }
+
+    BT* x = reinterpret_cast<BT*>(a);
+    BT* y = reinterpret_cast<BT*>(b);
+    BT* p = reinterpret_cast<BT*>(fa);
+    BT* q = reinterpret_cast<BT*>(fb);
+
+    // round trip
+    fwd.fft(fb);
+    inv.fft(fb);
+    double d = norm_inf(y, 2*N), e = 0;
+    for (long_t k=0; k < 2*N; ++k)
+      e = std::max(e, fabs(double(q[k] - y[k])));
+    if (MaxScrambledError < e/d) MaxScrambledError = e/d;
+
+    // convolution
+    for (long_t i=0; i < N*C; ++i)
+      fb[i] = b[i];
+    fwd.fft(fa);
+    fwd.fft(fb);
+    for (long_t k=0; k < N; ++k) {
+      const BT re = p[2*k]*q[2*k] - p[2*k+1]*q[2*k+1];
+      const BT im = p[2*k]*q[2*k+1] + p[2*k+1]*q[2*k];
+      p[2*k] = re;
+      p[2*k+1] = im;
+    }
+    inv.fft(fa);
+    d = e = 0;
+    for (long_t k=0; k < N; ++k) {
+      double re = 0, im = 0;
+      for (long_t j=0; j < N; ++j) {
+        const long_t m = (k - j + N)%N;
+        re += x[2*j]*y[2*m] - x[2*j+1]*y[2*m+1];
+        im += x[2*j]*y[2*m+1] + x[2*j+1]*y[2*m];
+      }
+      d = std::max(d, std::max(fabs(re), fabs(im)));
+      e = std::max(e, std::max(fabs(p[2*k] - re), fabs(p[2*k+1] - im)));
+    }
+    delete [] fb;
+    delete [] fa;
+    delete [] b;
+    delete [] a;
+
+    if (MaxScrambledError < e/d) MaxScrambledError = e/d;
+  }
+};
+
+//============================================================
+
+static double MaxParallError = 0;
+
+/// Compares the transforms of the parallelization policies in PList with the serial transform
+/*! The lengths from CobraThreshold also check the parallel in-place digit reversal (see CobraSwap).
+*/
+template<long_t N, class VType, class Place, class PList>
+class ParallelCheck;
+
+template<long_t N, class VType, class Place, class H, class Tail>
+class ParallelCheck<N, VType, Place, Loki::Typelist<H,Tail> >
+{
+  typedef typename VType::ValueType T1;
+  typedef typename VType::base_type BT;
+  static const int C = Loki::TypeTraits<T1>::isStdFundamental ? 2 : 1;
+  ParallelCheck<N,VType,Place,Tail> next;
+
+  static_assert(!Loki::IsSameType<typename H::template ActualParall<N>::Result, Serial>::value,
+                "The length is not transformed in parallel");
+
+  typename Transform<ulong_<N>,VType,DFT,ulong_<1>,Serial,Place>::Instance serial;
+  typename Transform<ulong_<N>,VType,DFT,ulong_<1>,H,Place>::Instance gfft;
+
+  template<class Tr>
+  static void run(Tr& fft, T1* data, T1* out, Loki::Int2Type<IN_PLACE::ID>) 
+  { 
+    for (long_t i=0; i < N*C; ++i)
+      out[i] = data[i];
+    fft.fft(out); 
+  }
+  template<class Tr>
+  static void run(Tr& fft, T1* data, T1* out, Loki::Int2Type<OUT_OF_PLACE::ID>) { fft.fft(data, out); }
+
+public:
+  void apply()
+  {
+    next.apply();
+
+    T1 *data = new T1 [N*C];
+    T1 *ref = new T1 [N*C];
+    T1 *out = new T1 [N*C];
+
+    for (long_t i=0; i < N; ++i)
+      GenInput<T1>::rand(data, i);
+
+    run(serial, data, ref, Loki::Int2Type<Place::ID>());
+    run(gfft, data, out, Loki::Int2Type<Place::ID>());
+
+    const BT* r = reinterpret_cast<const BT*>(ref);
+    const BT* p = reinterpret_cast<const BT*>(out);
+    BT d = norm_inf(r, 2*N), e = 0;
+    for (long_t k=0; k < 2*N; ++k)
+      e = std::max(e, BT(fabs(p[k] - r[k])));
+    delete [] out;
+    delete [] ref;
+    delete [] data;
+
+    if (MaxParallError < e/d) MaxParallError = e/d;
+  }
+};
+
+template<long_t N, class VType, class Place>
+class ParallelCheck<N, VType, Place, Loki::NullType> {
+public:
+  void apply() { }
+};
+
+//============================================================
+
+static long_t FactoryMismatches = 0;
+
+/// Checks, that the object factory of GenerateTransform returns every generated transform
+/*! The transform is requested by the IDs of its parameters, and the type of 
+    the returned object is compared with the generated one.
+*/
+template<class Gen, class TList = typename Gen::Result>
+class FactoryCheck;
+
+template<class Gen, class H, class Tail>
+class FactoryCheck<Gen, Loki::Typelist<H,Tail> >
+{
+  FactoryCheck<Gen,Tail> next;
+
+public:
+  void apply(Gen& gen)
+  {
+    next.apply(gen);
+
+    typename Gen::ObjectType* obj = gen.CreateTransformObject(H::Len, H::ValueType::ID, 
+        H::TransformType::ID, H::DimType::value, H::ParallType::ID, H::PlaceType::ID, H::DecimationType::ID);
+    if (typeid(*obj) != typeid(typename H::Instance)) 
+      ++FactoryMismatches;
+    delete obj;
+  }
+};
+
+template<class Gen>
+class FactoryCheck<Gen, Loki::NullType> {
+public:
+  void apply(Gen&) { }
+};
+
 } // namespace GFFT
 
 #endif
@@ -35,6 +35,8 @@ void print_header()
 
 static const unsigned int MinP = 6;
 static const unsigned int MaxP = 9;
+static const unsigned int MinP3 = 4;
+static const unsigned int MaxP3 = 7;
 
 int main(int argc, char *argv[])
 {
@@ -44,6 +46,8 @@ int main(int argc, char *argv[])
     
    // Single-threaded out-of-place transforms
    typedef GenerateTransform<NList, GFFT::DOUBLE, TransformTypeGroup::Default> List_ds;
+   // Powers of three run the radix-3 butterflies only
+   typedef GenerateTransform<GenPowerList<MinP3, MaxP3, 3>::Result, GFFT::DOUBLE, TransformTypeGroup::Default> List_ds3;
 //   typedef GenerateTransform<NList, GFFT::FLOAT, TransformTypeGroup::Default>  List_fs;
    typedef GenerateTransform<NList, GFFT::COMPLEX_DOUBLE, TransformTypeGroup::Default> List_cds;
 //   typedef GenerateTransform<NList, GFFT::COMPLEX_FLOAT, TransformTypeGroup::Default>  List_cfs;
@@ -58,12 +62,14 @@ int main(int argc, char *argv[])
    cout.precision(5);
    
    GFFTbench<List_ds::Result,List_ds::PlaceType> bench_ds;
+   GFFTbench<List_ds3::Result,List_ds3::PlaceType> bench_ds3;
 //   GFFTbench<List_fs::Result,List_fs::PlaceType> bench_fs;
    GFFTbench<List_cds::Result,List_cds::PlaceType> bench_cds;
 //   GFFTbench<List_cfs::Result,List_cfs::PlaceType> bench_cfs;
 
     print_header();
     bench_ds.cputime();
+    bench_ds3.cputime();
 //    bench_fs.cputime();
     bench_cds.cputime();
 //    bench_cfs.cputime();
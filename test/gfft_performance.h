@@ -35,8 +35,10 @@ using namespace boost::gregorian;
 
 const char space = '\t';
 
-static const char TransformType_Name[][17] = {" forward", "backward", "    real forward", "   real backward"};
-static const char ValueType_Name[][15] = {"    double    ", "     float    ", "complex double", " complex float"};
+static const char TransformType_Name[][17] = {" forward", "backward", "    real forward", "   real backward",
+                                              "   DCT-I forward", "  DCT-I backward", "  DCT-II forward", " DCT-II backward",
+                                              "  DCT-IV forward", " DCT-IV backward", "    MDCT forward", "   MDCT backward"};
+static const char ValueType_Name[][15] = {"    double    ", "     float    ", "complex double", " complex float", " split double ", "  split float "};
 static const char Place_Name[][17] = {"    in-place    ", "  out-of-place  "};
 
 
@@ -47,7 +49,7 @@ public:
   void init(T* src, const ulong_t len, const long_t it)
   {
       // initial data
-      for (ulong_t i=0; i<2*len*it; ++i)
+      for (ulong_t i=0; i<2*len*(it+1); ++i)
         src[i] = 0;
 
 //       for (unsigned int j=0; j<it; ++j) {
@@ -102,7 +104,7 @@ public:
      clock_t time1, time2;
 
      size_t it = static_cast<size_t>(1000000./static_cast<double>(H::Len))+1;
-     Tp* data    = new Tp [2*H::Len*it];
+     Tp* data    = new Tp [2*H::Len*(it+1)];
      Base::init(data, H::Len, it);
      
      Tp* d=data;
@@ -131,7 +133,7 @@ public:
      next.realtime();
 
      size_t it = static_cast<size_t>(1000000./static_cast<double>(H::Len))+1;
-     Tp* data    = new Tp [2*H::Len*it];
+     Tp* data    = new Tp [2*H::Len*(it+1)];
      Base::init(data, H::Len, it);
  
      ptime t1,t2;
@@ -180,8 +182,8 @@ public:
      clock_t time1, time2;
 
      size_t it = static_cast<size_t>(1000000./static_cast<double>(H::Len))+1;
-     Tp* data    = new Tp [2*H::Len*it];
-     Tp* dataout = new Tp [2*H::Len*it];
+     Tp* data    = new Tp [2*H::Len*(it+1)];
+     Tp* dataout = new Tp [2*H::Len*(it+1)];
      Base::init(data, H::Len, it);
      
      Tp* d=data;
@@ -210,8 +212,8 @@ public:
      next.realtime();
 
      size_t it = static_cast<size_t>(1000000./static_cast<double>(H::Len))+1;
-     Tp* data    = new Tp [2*H::Len*it];
-     Tp* dataout = new Tp [2*H::Len*it];
+     Tp* data    = new Tp [2*H::Len*(it+1)];
+     Tp* dataout = new Tp [2*H::Len*(it+1)];
      Base::init(data, H::Len, it);
  
      ptime t1,t2;